@@ -0,0 +1,42 @@
+#ifndef BENCHMARK_COMMON_HPP
+#define BENCHMARK_COMMON_HPP
+
+// Utilitários dos benchmarks de luzes (light_cluster_benchmark, light_binning_benchmark)
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "src/renderer/light_clusters.hpp"
+
+namespace Benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+// Tempo médio de fn em ms
+template <typename F>
+double measure(int repeat, F fn) {
+    auto start = Clock::now();
+    for (int i = 0; i < repeat; i++) fn();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / repeat;
+}
+
+// Luzes numa área de side x side metros à frente da câmera, como a cena --lights
+inline std::vector<PointLightData> makeLights(size_t count, float side, std::mt19937& rng) {
+    std::uniform_real_distribution<float> xz(-side * 0.5f, side * 0.5f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<PointLightData> lights(count);
+    for (auto& light : lights) {
+        light.position = glm::vec3(xz(rng), 0.2f + 1.5f * unit(rng), xz(rng) - side * 0.5f);
+        light.color = glm::vec3(unit(rng), unit(rng), unit(rng));
+        light.intensity = 5.0f;
+        light.radius = 1.5f + 2.0f * unit(rng);
+    }
+    return lights;
+}
+
+} // namespace Benchmark
+
+#endif // BENCHMARK_COMMON_HPP
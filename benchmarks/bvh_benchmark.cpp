@@ -0,0 +1,153 @@
+// Compara culling por frustum e raycast linear contra a DynamicBVH da Scene.
+// Não precisa de contexto OpenGL: cmake -DBUILD_BENCHMARKS=ON && ./bvh_benchmark
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "src/scene/bvh.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Mede a média de "repeat" execuções de fn em milissegundos
+template <typename F>
+double measure(int repeat, F fn) {
+    auto start = Clock::now();
+    for (int i = 0; i < repeat; i++) fn();
+    return elapsedMs(start) / repeat;
+}
+
+struct Ray {
+    glm::vec3 origin;
+    glm::vec3 direction;
+    glm::vec3 invDir;
+};
+
+void run(int entityCount) {
+    std::mt19937 rng(1234);
+    // Densidade constante: o mundo cresce com o número de entidades
+    float worldSize = 20.0f * std::cbrt(static_cast<float>(entityCount));
+    std::uniform_real_distribution<float> position(-worldSize, worldSize);
+    std::uniform_real_distribution<float> size(0.5f, 2.0f);
+
+    std::vector<AABB> boxes(entityCount);
+    for (auto& box : boxes) {
+        glm::vec3 center(position(rng), position(rng), position(rng));
+        glm::vec3 half(size(rng));
+        box = AABB(center - half, center + half);
+    }
+
+    // Construção incremental
+    DynamicBVH<uint32_t> bvh(0.1f);
+    std::vector<int32_t> proxies(entityCount);
+    auto start = Clock::now();
+    for (int i = 0; i < entityCount; i++) proxies[i] = bvh.CreateProxy(boxes[i], static_cast<uint32_t>(i));
+    double buildMs = elapsedMs(start);
+
+    // Câmera no centro olhando para +x, 60 graus
+    glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, worldSize);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum = Frustum::FromMatrix(proj * view);
+
+    const int repeat = entityCount >= 100000 ? 20 : 200;
+
+    size_t linearVisible = 0;
+    double linearMs = measure(repeat, [&]() {
+        linearVisible = 0;
+        for (const auto& box : boxes) linearVisible += frustum.Intersects(box);
+    });
+
+    FrustumCuller culler;
+    culler.Reserve(entityCount);
+    for (const auto& box : boxes) culler.Add(box);
+    size_t soaVisible = 0;
+    double soaMs = measure(repeat, [&]() { soaVisible = culler.Cull(frustum); });
+
+    size_t bvhVisible = 0;
+    double bvhMs = measure(repeat, [&]() {
+        bvhVisible = 0;
+        bvh.Query(frustum, [&](uint32_t) { bvhVisible++; });
+    });
+
+    // Raios aleatórios a partir de pontos do mundo; procura o acerto mais próximo
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<Ray> rays(1000);
+    for (auto& ray : rays) {
+        ray.origin = glm::vec3(position(rng), position(rng), position(rng));
+        ray.direction = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(1e-4f));
+        ray.invDir = glm::vec3(1.0f) / ray.direction;
+    }
+    const float maxDistance = worldSize * 4.0f;
+
+    std::vector<int> linearHits(rays.size());
+    double linearRayMs = measure(1, [&]() {
+        for (size_t r = 0; r < rays.size(); r++) {
+            float best = maxDistance;
+            int hit = -1;
+            for (int i = 0; i < entityCount; i++) {
+                float t;
+                if (boxes[i].IntersectsRay(rays[r].origin, rays[r].invDir, best, t)) {
+                    best = t;
+                    hit = i;
+                }
+            }
+            linearHits[r] = hit;
+        }
+    });
+
+    std::vector<int> bvhHits(rays.size());
+    double bvhRayMs = measure(1, [&]() {
+        for (size_t r = 0; r < rays.size(); r++) {
+            int hit = -1;
+            const Ray& ray = rays[r];
+            bvh.Raycast(ray.origin, ray.direction, maxDistance, [&](uint32_t index, float currentMax) {
+                float t;
+                if (!boxes[index].IntersectsRay(ray.origin, ray.invDir, currentMax, t)) return currentMax;
+                hit = static_cast<int>(index);
+                return t;
+            });
+            bvhHits[r] = hit;
+        }
+    });
+
+    size_t rayMismatches = 0;
+    for (size_t r = 0; r < rays.size(); r++) rayMismatches += linearHits[r] != bvhHits[r];
+
+    // Refit: 10% das entidades andam um pouco (a maioria fica dentro da margem)
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+    int moved = entityCount / 10;
+    int reinserted = 0;
+    start = Clock::now();
+    for (int i = 0; i < moved; i++) {
+        glm::vec3 offset(jitter(rng), jitter(rng), jitter(rng));
+        boxes[i] = AABB(boxes[i].min + offset, boxes[i].max + offset);
+        reinserted += bvh.MoveProxy(proxies[i], boxes[i]);
+    }
+    double moveMs = elapsedMs(start);
+
+    std::printf("\n== %d entidades (altura da BVH: %d) ==\n", entityCount, bvh.GetHeight());
+    std::printf("  construção incremental: %8.3f ms\n", buildMs);
+    std::printf("  frustum linear (AoS):   %8.3f ms  (%zu visíveis)\n", linearMs, linearVisible);
+    std::printf("  frustum linear (SoA):   %8.3f ms  (%zu visíveis)\n", soaMs, soaVisible);
+    std::printf("  frustum BVH:            %8.3f ms  (%zu visíveis, caixas alargadas)\n", bvhMs, bvhVisible);
+    std::printf("  1000 raios linear:      %8.3f ms\n", linearRayMs);
+    std::printf("  1000 raios BVH:         %8.3f ms  (%zu divergências)\n", bvhRayMs, rayMismatches);
+    std::printf("  mover %d entidades:     %8.3f ms  (%d reinseridas)\n", moved, moveMs, reinserted);
+}
+
+} // namespace
+
+int main() {
+    for (int count : { 1000, 10000, 100000 }) run(count);
+    return 0;
+}
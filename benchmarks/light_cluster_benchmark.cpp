@@ -0,0 +1,90 @@
+// Custo da atribuição de luzes a clusters (LightClusters::Build) com milhares de
+// luzes pontuais, contra o teste ingênuo de toda luz contra todo cluster, e
+// quantas luzes cada fragmento avaliaria (média por cluster) em vez de todas.
+// Só CPU, não precisa de contexto OpenGL: cmake -DBUILD_BENCHMARKS=ON && ./light_cluster_benchmark
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "src/renderer/light_clusters.hpp"
+#include "benchmarks/benchmark_common.hpp"
+
+namespace {
+
+using Benchmark::makeLights;
+using Benchmark::measure;
+
+// Referência: cada luz contra a caixa de cada cluster, sem faixa de tiles/fatias nem SoA.
+// Conta um pouco mais de pares que o Build: as caixas dos froxels são maiores que os
+// froxels, e as faixas do Build (extensão da esfera na tela) descartam parte desses falsos positivos
+size_t bruteForce(const LightClusters& clusters, const glm::mat4& view, const glm::mat4& proj,
+                  int width, int height, const std::vector<PointLightData>& lights) {
+    glm::ivec4 dims = clusters.GetDimensions();
+    glm::vec4 depth = clusters.GetDepthParams();
+    size_t pairs = 0;
+    for (int k = 0; k < dims.z; k++) {
+        float z0 = depth.x * std::pow(depth.y / depth.x, static_cast<float>(k) / dims.z);
+        float z1 = depth.x * std::pow(depth.y / depth.x, static_cast<float>(k + 1) / dims.z);
+        for (int j = 0; j < dims.y; j++) {
+            float y0 = static_cast<float>(j * dims.w) / height * 2.0f - 1.0f;
+            float y1 = std::min(static_cast<float>((j + 1) * dims.w) / height, 1.0f) * 2.0f - 1.0f;
+            for (int i = 0; i < dims.x; i++) {
+                float x0 = static_cast<float>(i * dims.w) / width * 2.0f - 1.0f;
+                float x1 = std::min(static_cast<float>((i + 1) * dims.w) / width, 1.0f) * 2.0f - 1.0f;
+                glm::vec3 lo(std::min(x0 * z0, x0 * z1) / proj[0][0], std::min(y0 * z0, y0 * z1) / proj[1][1], z0);
+                glm::vec3 hi(std::max(x1 * z0, x1 * z1) / proj[0][0], std::max(y1 * z0, y1 * z1) / proj[1][1], z1);
+                for (const auto& light : lights) {
+                    glm::vec4 p = view * glm::vec4(light.position, 1.0f);
+                    glm::vec3 c(p.x, p.y, -p.z);
+                    glm::vec3 d = glm::max(glm::max(lo - c, c - hi), glm::vec3(0.0f));
+                    if (glm::dot(d, d) <= light.radius * light.radius) pairs++;
+                }
+            }
+        }
+    }
+    return pairs;
+}
+
+} // namespace
+
+int main() {
+    const int width = 1920;
+    const int height = 1080;
+    glm::mat4 proj = glm::perspective(glm::radians(45.0f), float(width) / height, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 6.0f), glm::vec3(0.0f, 0.0f, -20.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    std::mt19937 rng(42);
+    LightClusters clusters;
+
+    std::printf("Viewport %dx%d, tiles de %d px, %d fatias\n", width, height, LightClusters::TileSize, LightClusters::DepthSlices);
+    std::printf("%8s %10s %12s %10s %10s %12s %10s\n", "luzes", "build ms", "ingênuo ms", "índices", "ingênuo", "média/clust", "máx/clust");
+
+    for (size_t count : { 64u, 256u, 1024u, 4096u, 16384u }) {
+        std::vector<PointLightData> lights = makeLights(count, 60.0f, rng);
+        int repeat = count <= 1024 ? 50 : 10;
+
+        double buildMs = measure(repeat, [&]() {
+            clusters.Build(view, proj, width, height, lights.data(), lights.size());
+        });
+        const LightClusters::Stats& stats = clusters.GetStats();
+
+        // O ingênuo é caro demais com muitas luzes: mede uma vez e só até 4096
+        double average = static_cast<double>(stats.indices) / clusters.GetClusterCount();
+        if (count <= 4096) {
+            size_t pairs = 0;
+            double bruteMs = measure(1, [&]() { pairs = bruteForce(clusters, view, proj, width, height, lights); });
+            std::printf("%8zu %10.3f %12.2f %10u %10zu %12.2f %10u\n", count, buildMs, bruteMs,
+                        stats.indices, pairs, average, stats.maxPerCluster);
+        } else {
+            std::printf("%8zu %10.3f %12s %10u %10s %12.2f %10u\n", count, buildMs, "-",
+                        stats.indices, "-", average, stats.maxPerCluster);
+        }
+    }
+    return 0;
+}
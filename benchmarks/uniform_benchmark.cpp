@@ -0,0 +1,206 @@
+// Custo do envio de uniforms por draw: nomes em std::string + glGetUniformLocation
+// (caminho antigo) contra a tabela de locations do Shader e o cache do Material.
+// Precisa de contexto OpenGL (abre uma janela GLFW invisível):
+//   cmake -DBUILD_BENCHMARKS=ON && ./uniform_benchmark
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "src/renderer/material.hpp"
+#include "src/renderer/shader.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* vertexSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+void main() { gl_Position = projection * view * model * vec4(aPos, 1.0); }
+)";
+
+// Mesmos nomes do pbr.frag; tudo é somado na saída para o driver não remover nada
+const char* fragmentSource = R"(
+#version 330 core
+out vec4 FragColor;
+struct MaterialData {
+    vec3 albedo; float metallic; float roughness; float ao;
+    vec3 emission; float emissionStrength;
+    vec3 ambient; vec3 diffuse; vec3 specular; float shininess;
+};
+struct PointLight { vec3 position; vec3 color; float intensity; float radius; };
+uniform MaterialData material;
+uniform PointLight pointLights[4];
+uniform int numPointLights;
+uniform vec3 viewPos;
+uniform bool hasTextureDiffuse;
+uniform bool hasTextureNormal;
+uniform bool hasTextureMetallic;
+uniform bool hasTextureRoughness;
+uniform bool hasTextureAO;
+uniform bool hasTextureEmission;
+uniform bool packedVertex;
+void main() {
+    vec3 c = material.albedo + material.emission * material.emissionStrength
+           + material.ambient + material.diffuse + material.specular + viewPos;
+    float f = material.metallic + material.roughness + material.ao + material.shininess;
+    for (int i = 0; i < numPointLights; i++) {
+        c += pointLights[i].position + pointLights[i].color * pointLights[i].intensity;
+        f += pointLights[i].radius;
+    }
+    if (hasTextureDiffuse || hasTextureNormal || hasTextureMetallic) f += 1.0;
+    if (hasTextureRoughness || hasTextureAO || hasTextureEmission || packedVertex) f += 1.0;
+    FragColor = vec4(c, f);
+}
+)";
+
+const char* propertyNames[] = {
+    "material.albedo", "material.metallic", "material.roughness", "material.ao",
+    "material.emission", "material.emissionStrength",
+    "material.ambient", "material.diffuse", "material.specular", "material.shininess"
+};
+
+constexpr UniformID HasTextureIDs[] = {
+    UniformID("hasTextureDiffuse"), UniformID("hasTextureNormal"), UniformID("hasTextureMetallic"),
+    UniformID("hasTextureRoughness"), UniformID("hasTextureAO"), UniformID("hasTextureEmission")
+};
+
+const char* textureFlags[] = {
+    "hasTextureDiffuse", "hasTextureNormal", "hasTextureMetallic",
+    "hasTextureRoughness", "hasTextureAO", "hasTextureEmission"
+};
+
+// Como era antes: cada uniform monta a string e pergunta a location ao driver
+void drawUncached(GLuint program, const Material& material, const glm::mat4& model) {
+    const MaterialProperties& p = material.GetProperties();
+    for (const char* flag : textureFlags) {
+        std::string name(flag);
+        glUniform1i(glGetUniformLocation(program, name.c_str()), 0);
+    }
+    std::string modelName("model");
+    glUniformMatrix4fv(glGetUniformLocation(program, modelName.c_str()), 1, GL_FALSE, glm::value_ptr(model));
+
+    const float* vec3Values[] = { &p.albedo[0], &p.emission[0], &p.ambient[0], &p.diffuse[0], &p.specular[0] };
+    const char* vec3Names[] = { propertyNames[0], propertyNames[4], propertyNames[6], propertyNames[7], propertyNames[8] };
+    for (int i = 0; i < 5; i++) {
+        glUniform3fv(glGetUniformLocation(program, vec3Names[i]), 1, vec3Values[i]);
+    }
+    const float floatValues[] = { p.metallic, p.roughness, p.ao, p.emissionStrength, p.shininess };
+    const char* floatNames[] = { propertyNames[1], propertyNames[2], propertyNames[3], propertyNames[5], propertyNames[9] };
+    for (int i = 0; i < 5; i++) {
+        glUniform1f(glGetUniformLocation(program, floatNames[i]), floatValues[i]);
+    }
+}
+
+// Caminho atual do Renderer::RenderMesh
+void drawCached(const Shader& shader, const Material& material, const glm::mat4& model) {
+    material.Apply(shader.GetProgramID());
+    for (const UniformID& flag : HasTextureIDs) shader.SetBool(flag, false);
+    shader.SetMat4(Uniforms::Model, glm::value_ptr(model));
+}
+
+void lightsUncached(GLuint program) {
+    for (int i = 0; i < 4; i++) {
+        std::string base = "pointLights[" + std::to_string(i) + "]";
+        glUniform3f(glGetUniformLocation(program, (base + ".position").c_str()), 1.0f, 2.0f, 3.0f);
+        glUniform3f(glGetUniformLocation(program, (base + ".color").c_str()), 1.0f, 1.0f, 1.0f);
+        glUniform1f(glGetUniformLocation(program, (base + ".intensity").c_str()), 1.0f);
+        glUniform1f(glGetUniformLocation(program, (base + ".radius").c_str()), 10.0f);
+    }
+}
+
+void lightsCached(const Shader& shader, const UniformID (&ids)[4][4]) {
+    for (int i = 0; i < 4; i++) {
+        shader.SetVec3(ids[i][0], 1.0f, 2.0f, 3.0f);
+        shader.SetVec3(ids[i][1], 1.0f, 1.0f, 1.0f);
+        shader.SetFloat(ids[i][2], 1.0f);
+        shader.SetFloat(ids[i][3], 10.0f);
+    }
+}
+
+// Tempo médio por chamada em nanossegundos; glFinish garante que o driver esvaziou a fila
+template <typename F>
+double measureNs(int iterations, F fn) {
+    glFinish();
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++) fn(i);
+    glFinish();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+}
+
+} // namespace
+
+int main() {
+    if (!glfwInit()) {
+        std::fprintf(stderr, "Falha ao inicializar GLFW\n");
+        return 1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(64, 64, "uniform_benchmark", nullptr, nullptr);
+    if (!window) {
+        std::fprintf(stderr, "Falha ao criar contexto OpenGL\n");
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        std::fprintf(stderr, "Falha ao inicializar GLEW\n");
+        return 1;
+    }
+
+    int result = 0;
+    {
+        Shader shader;
+        if (!shader.CompileFromSource(vertexSource, fragmentSource)) {
+            result = 1;
+        } else {
+            shader.Use();
+            GLuint program = shader.GetProgramID();
+            Material material = MaterialLibrary::CreateGold();
+            glm::mat4 model(1.0f);
+
+            UniformID lightIds[4][4] = {
+                { UniformID("pointLights[0].position"), UniformID("pointLights[0].color"), UniformID("pointLights[0].intensity"), UniformID("pointLights[0].radius") },
+                { UniformID("pointLights[1].position"), UniformID("pointLights[1].color"), UniformID("pointLights[1].intensity"), UniformID("pointLights[1].radius") },
+                { UniformID("pointLights[2].position"), UniformID("pointLights[2].color"), UniformID("pointLights[2].intensity"), UniformID("pointLights[2].radius") },
+                { UniformID("pointLights[3].position"), UniformID("pointLights[3].color"), UniformID("pointLights[3].intensity"), UniformID("pointLights[3].radius") },
+            };
+
+            const int iterations = 200000;
+            // Aquece os dois caminhos (e preenche o cache do Material)
+            measureNs(1000, [&](int i) { model[3][0] = float(i); drawUncached(program, material, model); });
+            measureNs(1000, [&](int i) { model[3][0] = float(i); drawCached(shader, material, model); });
+
+            double drawOld = measureNs(iterations, [&](int i) { model[3][0] = float(i); drawUncached(program, material, model); });
+            double drawNew = measureNs(iterations, [&](int i) { model[3][0] = float(i); drawCached(shader, material, model); });
+            double lightsOld = measureNs(iterations / 10, [&](int) { lightsUncached(program); });
+            double lightsNew = measureNs(iterations / 10, [&](int) { lightsCached(shader, lightIds); });
+
+            std::printf("Uniforms ativos introspectados: %zu\n", shader.GetUniformCount());
+            std::printf("Por draw (17 uniforms):\n");
+            std::printf("  string + glGetUniformLocation: %8.1f ns\n", drawOld);
+            std::printf("  locations em cache:            %8.1f ns  (%.1fx)\n", drawNew, drawOld / drawNew);
+            std::printf("Por frame, 4 point lights (16 uniforms):\n");
+            std::printf("  string + glGetUniformLocation: %8.1f ns\n", lightsOld);
+            std::printf("  locations em cache:            %8.1f ns  (%.1fx)\n", lightsNew, lightsOld / lightsNew);
+        }
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return result;
+}
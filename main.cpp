@@ -1,7 +1,95 @@
 #include "src/core/application.hpp"
+#include "src/core/batch_job.hpp"
 
-int main() {
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
     Application app("OpenGL Render", 1280, 720);
+
+    // Opções do modo headless, aplicadas depois de ler todos os argumentos
+    bool headless = false;
+    int frames = 1;
+    std::string output = "frames";
+
+    // Modo em lote: jobs de um arquivo ou um por modelo de um diretório
+    std::string batchFile;
+    std::string batchDir;
+    std::string batchMaterial;
+    FrameFormat format = FrameFormat::PNG;
+
+    bool profile = false;
+    std::string traceFile;
+
+    for (int i = 1; i < argc; i++) {
+        // --instances N: N capacetes em grade (teste de carga de LOD)
+        if (std::strcmp(argv[i], "--instances") == 0 && i + 1 < argc) {
+            app.SetHelmetInstances(std::atoi(argv[++i]));
+        }
+        // --lights N: N luzes pontuais extras (teste do clustering de luzes)
+        if (std::strcmp(argv[i], "--lights") == 0 && i + 1 < argc) {
+            app.SetExtraLights(std::atoi(argv[++i]));
+        }
+        // --arena: meshes em buffers compartilhados, desenhadas com multi-draw indirect
+        if (std::strcmp(argv[i], "--arena") == 0) {
+            app.SetGeometryArena(true);
+        }
+        // --deferred: começa no caminho deferred (G-buffer + passe de luz), tecla F alterna
+        if (std::strcmp(argv[i], "--deferred") == 0) {
+            app.SetDeferred(true);
+        }
+        // --headless: sem janela (EGL), para servidores sem display; --frames N e --output DIR
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        }
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::atoi(argv[++i]);
+        }
+        if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        }
+        // --batch FILE / --batch-models DIR: render em lote (implica --headless); --frames vale por job
+        if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batchFile = argv[++i];
+        }
+        if (std::strcmp(argv[i], "--batch-models") == 0 && i + 1 < argc) {
+            batchDir = argv[++i];
+        }
+        // --material NAME: override do MaterialLibrary para os jobs de --batch-models
+        if (std::strcmp(argv[i], "--material") == 0 && i + 1 < argc) {
+            batchMaterial = argv[++i];
+        }
+        // --format png|exr|raw: raw escreve RGBA8 sem cabeçalho em --output (arquivo, FIFO ou "-")
+        if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (std::strcmp(name, "exr") == 0) format = FrameFormat::EXR;
+            else if (std::strcmp(name, "raw") == 0) format = FrameFormat::Raw;
+            else format = FrameFormat::PNG;
+        }
+        // --profile: zonas de CPU/GPU no [Stats]; --trace FILE também grava o trace do Chrome ao sair
+        if (std::strcmp(argv[i], "--profile") == 0) {
+            profile = true;
+        }
+        if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            traceFile = argv[++i];
+        }
+    }
+
+    if (profile || !traceFile.empty()) app.SetProfiling(profile, traceFile);
+
+    std::vector<BatchJob> jobs;
+    if (!batchFile.empty() && !BatchJobs::LoadFile(batchFile, frames, jobs)) return 1;
+    if (!batchDir.empty()) BatchJobs::FromDirectory(batchDir, frames, batchMaterial, jobs);
+    if ((!batchFile.empty() || !batchDir.empty()) && jobs.empty()) {
+        std::cerr << "Nenhum job para renderizar" << std::endl;
+        return 1;
+    }
+
+    if (headless || !jobs.empty()) app.SetHeadless(frames, output);
+    if (!jobs.empty()) app.SetBatch(jobs, format);
+
     app.Run();
     return 0;
 }
\ No newline at end of file
@@ -4,13 +4,25 @@
 #include <memory>
 #include <vector>
 #include <iostream>
+#include <cmath>
+#include <string>
+#include <random>
+#include <chrono>
+#include <unordered_map>
+#include <cstdio>
+#include <filesystem>
 
 #include "window.hpp"
 #include "filesystem.hpp"
+#include "batch_job.hpp"
+#include "profiler.hpp"
 #include "../renderer/renderer.hpp"
 #include "../renderer/framebuffer.hpp"
 #include "../renderer/pbr_utils.hpp"
 #include "../renderer/model_factory.hpp"
+#include "../renderer/asset_loader.hpp"
+#include "../renderer/image_writer.hpp"
+#include "../renderer/frame_capture.hpp"
 #include "../scene/scene.hpp"
 #include "../scene/components.hpp"
 
@@ -21,15 +33,26 @@ private:
     // Core Systems
     Renderer renderer;
     std::unique_ptr<FrameBuffer> fb;
+    std::unique_ptr<FrameBuffer> outputFb; // Headless: destino do passe de tela (RGBA8), lido para o disco
     
     // Shaders
     std::unique_ptr<Shader> pbrShader;
+    std::unique_ptr<Shader> pbrTableShader; // pbr com MATERIAL_TABLE (tecla T)
+    std::unique_ptr<Shader> pbrGBufferShader; // pbr com GBUFFER: passe de geometria do deferred (tecla F)
+    std::unique_ptr<Shader> pbrGBufferTableShader; // GBUFFER + MATERIAL_TABLE
+    std::unique_ptr<Shader> deferredLightingShader;
     std::unique_ptr<Shader> screenShader;
     std::unique_ptr<Shader> skyboxShader;
 
     // Environment
     PBRUtils::EnvironmentMap envMap;
 
+    // Carregamento em segundo plano (upload limitado a um orçamento por frame)
+    AssetLoader assetLoader;
+    const double uploadBudgetMs = 4.0;
+    AssetHandle<Model> helmetHandle;
+    bool helmetMaterialSaved = false;
+
     // Scene Data
     std::unique_ptr<Scene> activeScene;
     std::vector<std::shared_ptr<Material>> materials;
@@ -37,8 +60,54 @@ private:
     // Game State
     glm::vec3 cameraPos = glm::vec3(0.0f, 2.0f, 6.0f);
     
+    // Cópias extras do capacete em grade (--instances N), para medir o custo por triângulo
+    int helmetInstances = 1;
+
+    // Luzes pontuais extras espalhadas sobre a grade (--lights N), para medir o clustering
+    int extraLights = 0;
+
+    // Começa no caminho deferred (--deferred); a tecla F alterna em tempo de execução
+    bool startDeferred = false;
+
+    // Headless (--headless): sem janela, N frames com passo fixo, gravados em outputDir
+    bool headless = false;
+    int headlessFrames = 1;
+    std::string outputDir;
+    const float headlessFrameTime = 1.0f / 60.0f;
+    FrameCapture frameCapture; // Leitura assíncrona do outputFb (PNG/Raw)
+    FrameCapture hdrCapture;   // Leitura assíncrona do fb em float (EXR)
+
+    // Profiler (--profile / --trace FILE): resumo junto do [Stats] e trace do Chrome ao sair
+    bool profiling = false;
+    std::string traceFile;
+
+    // Lote (--batch / --batch-models): jobs em sequência no mesmo contexto, IBL e modelos carregados uma vez
+    std::vector<BatchJob> batchJobs;
+    FrameFormat batchFormat = FrameFormat::PNG;
+    std::unordered_map<std::string, AssetHandle<Model>> batchModels;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<Material>>> batchOriginalMaterials;
+    std::unordered_map<std::string, std::shared_ptr<Material>> batchMaterials; // Overrides por nome
+
+    // Câmera do Render; o modo normal olha para a origem, o lote enquadra cada modelo
+    glm::vec3 cameraTarget = glm::vec3(0.0f);
+    float nearPlane = 0.1f;
+    float farPlane = 100.0f;
+
+    // Estatísticas impressas periodicamente
+    double statsTimer = 0.0;
+    int statsFrames = 0;
+    GLState::Stats lastGLStats; // Chamadas GL feitas/evitadas no último frame
+
     // Input Control
     bool mKeyPressed = false;
+    bool lKeyPressed = false;
+    bool pKeyPressed = false;
+    bool kKeyPressed = false;
+    bool iKeyPressed = false;
+    bool gKeyPressed = false;
+    bool tKeyPressed = false;
+    bool fKeyPressed = false;
+    bool bKeyPressed = false;
     int currentMatIndex = 0;
     std::shared_ptr<Entity> playerEntity; // Referência para input
 
@@ -47,24 +116,110 @@ public:
         window = std::make_unique<Window>(width, height, title);
     }
 
+    ~Application() {
+        // A window (e o contexto) é o último membro destruído; o singleton do arena
+        // só morre na destruição estática, então os buffers dele saem aqui
+        GeometryArena::GetInstance().Shutdown();
+    }
+
+    /**
+     * @brief Troca a janela por um contexto EGL offscreen; chamar antes de Run.
+     * Renderiza frames frames (passo fixo de 1/60 s, depois de todos os assets
+     * carregarem) e grava cada um como PNG em dir (vazio = não grava).
+     */
+    void SetHeadless(int frames, const std::string& dir) {
+        window = std::make_unique<Window>(window->GetWidth(), window->GetHeight(), "", WindowBackend::Headless);
+        headless = true;
+        headlessFrames = glm::max(frames, 1);
+        outputDir = dir;
+    }
+
+    /**
+     * @brief Renderiza os jobs em vez da cena interativa (exige SetHeadless antes).
+     * PNG/EXR vão para o diretório de saída; Raw escreve RGBA8 em sequência no
+     * arquivo/FIFO de saída, ou no stdout se ele for "-".
+     */
+    void SetBatch(const std::vector<BatchJob>& jobs, FrameFormat format) {
+        batchJobs = jobs;
+        batchFormat = format;
+
+        // Frames crus no stdout: o log do std::cout passa para o stderr pelo resto do processo
+        if (format == FrameFormat::Raw && outputDir == "-") std::cout.rdbuf(std::cerr.rdbuf());
+    }
+
+    // Liga o Profiler no Init (precisa do contexto); traceFile não vazio grava o trace no fim do Run
+    void SetProfiling(bool enabled, const std::string& tracePath) {
+        profiling = enabled || !tracePath.empty();
+        traceFile = tracePath;
+    }
+
+    // Número total de capacetes na cena; os extras compartilham o mesmo Model
+    void SetHelmetInstances(int count) { helmetInstances = glm::max(count, 1); }
+
+    void SetExtraLights(int count) { extraLights = glm::max(count, 0); }
+
+    void SetDeferred(bool enabled) { startDeferred = enabled; }
+
+    // Meshes nos buffers compartilhados do GeometryArena (--arena); chamar antes de Run
+    void SetGeometryArena(bool enabled) { GeometryArena::GetInstance().SetEnabled(enabled); }
+
     void Run() {
         if (!Init()) return;
+
+        if (!batchJobs.empty()) {
+            RunBatch();
+            return;
+        }
         
         LoadContent();
+
+        // Sem janela não há o que mostrar enquanto carrega: o primeiro frame já sai completo
+        if (headless) assetLoader.WaitAll();
         
         // Loop Principal
-        float lastFrame = 0.0f;
+        float lastFrame = static_cast<float>(window->GetTime());
+        double headlessStart = window->GetTime();
+        int frameIndex = 0;
+        Profiler& profiler = Profiler::GetInstance();
         while (!window->ShouldClose()) {
-            float currentFrame = static_cast<float>(glfwGetTime());
-            float deltaTime = currentFrame - lastFrame;
+            float currentFrame = static_cast<float>(window->GetTime());
+            float deltaTime = headless ? headlessFrameTime : currentFrame - lastFrame;
             lastFrame = currentFrame;
 
+            profiler.BeginFrame();
+            {
+                PROFILE_SCOPE("AssetUploads");
+                assetLoader.ProcessUploads(uploadBudgetMs);
+            }
+
             ProcessInput(deltaTime);
             Update(deltaTime);
             Render();
+            lastGLStats = GLState::GetInstance().ResetStats();
+
+            if (headless) {
+                char name[32];
+                std::snprintf(name, sizeof(name), "frame_%05d.png", frameIndex);
+                SaveFrame(name);
+                if (++frameIndex >= headlessFrames) window->Close();
+            }
+
+            {
+                PROFILE_SCOPE("Swap");
+                window->OnUpdate();
+            }
+            profiler.EndFrame();
+        }
 
-            window->OnUpdate();
+        if (headless) {
+            frameCapture.Flush();
+            double seconds = window->GetTime() - headlessStart;
+            std::cout << "[Headless] " << frameIndex << " frames em " << seconds << " s ("
+                      << seconds * 1000.0 / glm::max(frameIndex, 1) << " ms/frame)" << std::endl;
+            if (!outputDir.empty()) frameCapture.GetStats().Print();
         }
+
+        FinishProfiling();
     }
 
 private:
@@ -72,9 +227,15 @@ private:
         // 1. Iniciar Janela
         if (!window->Init()) return false;
 
+        if (profiling) {
+            Profiler::GetInstance().SetEnabled(true);
+            Profiler::GetInstance().SetTracing(!traceFile.empty());
+        }
+
         // Configurar Callback de Resize
         window->SetResizeCallback([this](int w, int h) {
             if (this->fb) this->fb->Resize(w, h);
+            renderer.SetViewport(w, h);
         });
 
         // 2. Compilar Shaders
@@ -85,6 +246,36 @@ private:
             FS::GetPath("shaders/pbr.frag")
         )) return false;
 
+        // Variante opcional: se falhar, a tecla T só avisa
+        pbrTableShader = std::make_unique<Shader>();
+        pbrTableShader->AddDefine("MATERIAL_TABLE");
+        if (!pbrTableShader->CompileFromFile(
+            FS::GetPath("shaders/pbr.vert"),
+            FS::GetPath("shaders/pbr.frag")
+        )) pbrTableShader.reset();
+
+        // Caminho deferred, também opcional: sem ele a tecla F só avisa
+        pbrGBufferShader = std::make_unique<Shader>();
+        pbrGBufferShader->AddDefine("GBUFFER");
+        if (!pbrGBufferShader->CompileFromFile(
+            FS::GetPath("shaders/pbr.vert"),
+            FS::GetPath("shaders/pbr.frag")
+        )) pbrGBufferShader.reset();
+
+        pbrGBufferTableShader = std::make_unique<Shader>();
+        pbrGBufferTableShader->AddDefine("GBUFFER");
+        pbrGBufferTableShader->AddDefine("MATERIAL_TABLE");
+        if (!pbrGBufferTableShader->CompileFromFile(
+            FS::GetPath("shaders/pbr.vert"),
+            FS::GetPath("shaders/pbr.frag")
+        )) pbrGBufferTableShader.reset();
+
+        deferredLightingShader = std::make_unique<Shader>();
+        if (!deferredLightingShader->CompileFromFile(
+            FS::GetPath("shaders/screen.vert"),
+            FS::GetPath("shaders/deferred_lighting.frag")
+        )) deferredLightingShader.reset();
+
         screenShader = std::make_unique<Shader>();
         if (!screenShader->CompileFromFile(
             FS::GetPath("shaders/screen.vert"), 
@@ -99,14 +290,233 @@ private:
 
         // 3. Setup Renderer
         renderer.Init(pbrShader.get(), skyboxShader.get());
+        renderer.SetMaterialTableShader(pbrTableShader.get());
+        renderer.SetDeferredShaders(pbrGBufferShader.get(), pbrGBufferTableShader.get(), deferredLightingShader.get());
+        renderer.SetDeferred(startDeferred);
+        renderer.SetViewport(window->GetWidth(), window->GetHeight());
         
         // 4. Setup Framebuffer
         fb = std::make_unique<FrameBuffer>(window->GetWidth(), window->GetHeight());
         fb->Init();
 
+        // Sem framebuffer padrão: o passe de tela vai para um FBO de 8 bits
+        if (headless) {
+            outputFb = std::make_unique<FrameBuffer>(window->GetWidth(), window->GetHeight(), GL_RGBA8);
+            if (!outputFb->Init()) return false;
+
+            frameCapture.Init(CaptureFormat::RGBA8);
+            if (batchFormat == FrameFormat::EXR) hdrCapture.Init(CaptureFormat::RGB32F);
+
+            // No Raw a saída é um arquivo/FIFO (ou o stdout), não um diretório
+            if (!outputDir.empty() && !(batchFormat == FrameFormat::Raw && !batchJobs.empty())) {
+                std::error_code ec;
+                std::filesystem::create_directories(outputDir, ec);
+                if (ec) {
+                    std::cerr << "[Headless] Não foi possível criar " << outputDir << ": " << ec.message() << std::endl;
+                    return false;
+                }
+            }
+        }
+
         return true;
     }
 
+    // Tente carregar o HDR, se falhar não quebra o app
+    void LoadEnvironment() {
+        const std::string hdrPath = "models/golden_gate_hills_4k.hdr";
+        assetLoader.Submit(
+            [hdrPath]() {
+                ImageData image;
+                if (!Texture::DecodeHDR(hdrPath, image)) {
+                    std::cerr << "[IBL] Failed to load HDR: " << hdrPath << std::endl;
+                }
+                return image;
+            },
+            [this](const ImageData& image) {
+                if (!image.IsValid()) return;
+                envMap.LoadFromHDRImage(image);
+                if (envMap.envCubemap) {
+                    renderer.SetIBLMaps(envMap.GetIrradianceMapID(), envMap.GetPrefilterMapID(), envMap.brdfLUTTexture);
+                }
+            });
+    }
+
+    // Mesmas opções do capacete; cada caminho é importado uma única vez por lote
+    AssetHandle<Model> LoadBatchModel(const std::string& path) {
+        auto it = batchModels.find(path);
+        if (it != batchModels.end()) return it->second;
+
+        ModelLoadOptions options;
+        options.vertexFormat = VertexFormat::Packed;
+        options.residency = MeshResidency::ReleaseAfterUpload;
+        options.optimizeMeshes = true;
+        options.lodLevels = 3;
+        AssetHandle<Model> handle = assetLoader.LoadModelAsync(path, options);
+        batchModels[path] = handle;
+        return handle;
+    }
+
+    std::shared_ptr<Material> GetBatchMaterial(const std::string& name) {
+        auto it = batchMaterials.find(name);
+        if (it != batchMaterials.end()) return it->second;
+
+        std::shared_ptr<Material> material;
+        Material created;
+        if (MaterialLibrary::Create(name, created)) {
+            material = std::make_shared<Material>(created);
+        } else {
+            std::cerr << "[Batch] Material desconhecido: " << name << " (usando os do modelo)" << std::endl;
+        }
+        batchMaterials[name] = material;
+        return material;
+    }
+
+    // Cena de um job: o modelo com seus materiais originais (ou o override) e o sol.
+    // Retorna a caixa do modelo em mundo, para o enquadramento
+    AABB SetupBatchScene(const BatchJob& job, const std::shared_ptr<Model>& model) {
+        activeScene = std::make_unique<Scene>();
+
+        // O override do MeshRenderer altera o Model compartilhado: restaura antes de cada job
+        const auto& originals = batchOriginalMaterials[job.modelPath];
+        for (size_t i = 0; i < originals.size(); i++) model->SetMeshMaterial(i, originals[i]);
+
+        auto entity = activeScene->CreateEntity("BatchModel");
+        auto rend = entity->AddComponent<MeshRenderer>(model);
+        if (!job.material.empty()) rend->SetMaterial(GetBatchMaterial(job.material));
+        entity->transform.Rotation = job.rotation;
+
+        auto sun = activeScene->CreateEntity("Sun");
+        sun->AddComponent<DirectionalLightComponent>(glm::vec3(1.0f, 0.9f, 0.8f), 2.0f);
+
+        activeScene->OnStart();
+        return model->GetBounds().Transformed(entity->transform.GetMatrix());
+    }
+
+    void WriteBatchFrame(size_t jobIndex, int frame, FILE* pipe) {
+        PROFILE_SCOPE("Capture");
+        if (batchFormat == FrameFormat::Raw) {
+            if (!pipe) return;
+            // O encoder entrega na ordem das capturas, então o stream sai em ordem
+            frameCapture.Capture(outputFb->GetFramebufferId(), outputFb->GetWidth(), outputFb->GetHeight(),
+                                 [pipe](const CapturedFrame& captured) {
+                                     ImageWriter::WriteRaw(pipe, captured.pixels.data(), captured.width, captured.height);
+                                 });
+            return;
+        }
+
+        char name[48];
+        if (batchFormat == FrameFormat::EXR) {
+            // Cor linear da cena, antes do passe de tela
+            if (outputDir.empty()) return;
+            std::snprintf(name, sizeof(name), "job%03zu_frame%05d.exr", jobIndex, frame);
+            std::string path = (std::filesystem::path(outputDir) / name).string();
+            hdrCapture.Capture(fb->GetFramebufferId(), fb->GetWidth(), fb->GetHeight(),
+                               [path](const CapturedFrame& captured) {
+                                   ImageWriter::WriteEXR(path, reinterpret_cast<const float*>(captured.pixels.data()),
+                                                         captured.width, captured.height);
+                               });
+            return;
+        }
+
+        std::snprintf(name, sizeof(name), "job%03zu_frame%05d.png", jobIndex, frame);
+        SaveFrame(name);
+    }
+
+    void RunBatch() {
+        using Clock = std::chrono::steady_clock;
+
+        if (!outputFb) {
+            std::cerr << "[Batch] O modo em lote precisa do headless (SetHeadless antes de Run)" << std::endl;
+            return;
+        }
+
+        FILE* pipe = nullptr;
+        if (batchFormat == FrameFormat::Raw) {
+            pipe = outputDir == "-" ? stdout : std::fopen(outputDir.c_str(), "wb");
+            if (!pipe) {
+                std::cerr << "[Batch] Não foi possível abrir a saída " << outputDir << std::endl;
+                return;
+            }
+        }
+
+        // IBL e todos os modelos distintos carregam em paralelo, uma vez para o lote inteiro
+        auto loadStart = Clock::now();
+        LoadEnvironment();
+        for (const auto& job : batchJobs) LoadBatchModel(job.modelPath);
+        assetLoader.WaitAll();
+        for (auto& entry : batchModels) {
+            auto model = entry.second.Get();
+            if (!model) continue;
+            auto& originals = batchOriginalMaterials[entry.first];
+            for (size_t i = 0; i < model->GetMeshCount(); i++) originals.push_back(model->GetMesh(i).GetMaterial());
+        }
+        std::cout << "[Batch] " << batchModels.size() << " modelos e IBL carregados em "
+                  << std::chrono::duration<double>(Clock::now() - loadStart).count() << " s" << std::endl;
+
+        auto start = Clock::now();
+        int jobsDone = 0;
+        int framesDone = 0;
+        for (size_t j = 0; j < batchJobs.size(); j++) {
+            const BatchJob& job = batchJobs[j];
+            auto model = batchModels[job.modelPath].Get();
+            if (!model) {
+                std::cerr << "[Batch] Job " << j << ": falha carregando " << job.modelPath << std::endl;
+                continue;
+            }
+
+            auto jobStart = Clock::now();
+            // Enquadramento pela esfera que envolve a caixa já rotacionada
+            AABB bounds = SetupBatchScene(job, model);
+            glm::vec3 center = bounds.IsValid() ? bounds.GetCenter() : glm::vec3(0.0f);
+            float radius = bounds.IsValid() ? glm::max(glm::length(bounds.GetExtents()), 1e-3f) : 1.0f;
+            cameraTarget = center;
+            nearPlane = radius * 0.01f;
+            farPlane = radius * (job.camera.distance + 2.0f) * 4.0f;
+
+            for (int f = 0; f < job.frames; f++) {
+                Profiler::GetInstance().BeginFrame();
+                cameraPos = job.camera.Evaluate(static_cast<float>(f) / job.frames, center, radius);
+                activeScene->OnUpdate(headlessFrameTime);
+                Render();
+                GLState::GetInstance().ResetStats();
+                WriteBatchFrame(j, f, pipe);
+                Profiler::GetInstance().EndFrame();
+            }
+            framesDone += job.frames;
+            jobsDone++;
+
+            double jobSeconds = std::chrono::duration<double>(Clock::now() - jobStart).count();
+            std::cout << "[Batch] Job " << j + 1 << "/" << batchJobs.size() << ": " << job.modelPath
+                      << (job.material.empty() ? "" : " (" + job.material + ")") << ", " << job.frames
+                      << " frames em " << jobSeconds << " s" << std::endl;
+        }
+
+        // Frames ainda na GPU ou no encoder contam no tempo total
+        frameCapture.Flush();
+        hdrCapture.Flush();
+
+        if (pipe) {
+            std::fflush(pipe);
+            if (pipe != stdout) std::fclose(pipe);
+        }
+
+        double seconds = glm::max(std::chrono::duration<double>(Clock::now() - start).count(), 1e-9);
+        std::cout << "[Batch] " << jobsDone << " jobs, " << framesDone << " frames em " << seconds << " s: "
+                  << jobsDone / seconds << " jobs/s, " << framesDone / seconds << " frames/s" << std::endl;
+        (batchFormat == FrameFormat::EXR ? hdrCapture : frameCapture).GetStats().Print();
+
+        FinishProfiling();
+    }
+
+    // Fim do Run: lê os últimos frames, imprime o resumo e grava o trace
+    void FinishProfiling() {
+        Profiler& profiler = Profiler::GetInstance();
+        if (!profiler.IsEnabled()) return;
+        profiler.ResolveAll();
+        profiler.PrintSummary();
+        if (!traceFile.empty()) profiler.ExportChromeTrace(traceFile);
+    }
+
     void LoadContent() {
         activeScene = std::make_unique<Scene>();
 
@@ -121,21 +531,29 @@ private:
 
         // --- CARREGAR MODELO ---
         playerEntity = activeScene->CreateEntity("Helmet");
-        try {
-            auto model = std::make_shared<Model>("models/DamagedHelmet/DamagedHelmet.glb");
-            
-            // Salvar material original
-            if(model->GetMeshCount() > 0) 
-                materials.push_back(model->GetMesh(0).GetMaterial());
-
-            auto renderComp = playerEntity->AddComponent<MeshRenderer>(model);
-            renderComp->SetMaterial(materials[0]); // Começa com Ouro
-        } catch(...) { std::cerr << "Erro carregando modelo" << std::endl; }
+        // Assimp e decodificação das texturas rodam no JobSystem; o upload acontece no loop
+        ModelLoadOptions helmetOptions;
+        helmetOptions.vertexFormat = VertexFormat::Packed; // 20 bytes por vértice em vez de 56
+        helmetOptions.residency = MeshResidency::ReleaseAfterUpload; // nada na cena lê os vértices na CPU
+        helmetOptions.optimizeMeshes = true; // só custa na primeira carga; o cache guarda o resultado
+        helmetOptions.lodLevels = 3; // LODs escolhidos pelo Renderer conforme o tamanho na tela
+        helmetHandle = assetLoader.LoadModelAsync("models/DamagedHelmet/DamagedHelmet.glb", helmetOptions);
+        auto renderComp = playerEntity->AddComponent<MeshRenderer>(helmetHandle);
+        renderComp->SetMaterial(materials[0]); // Começa com Ouro
 
         playerEntity->AddComponent<RotatorScript>(glm::vec3(0, 30, 0));
         playerEntity->transform.Position = glm::vec3(0, 0.5f, 0);
         playerEntity->transform.Rotation = glm::vec3(90, 0, 0);
 
+        // Instâncias extras em grade atrás do capacete principal
+        int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(helmetInstances))));
+        for (int i = 1; i < helmetInstances; i++) {
+            auto copy = activeScene->CreateEntity("Helmet " + std::to_string(i));
+            copy->AddComponent<MeshRenderer>(helmetHandle);
+            copy->transform.Position = glm::vec3((i % columns - columns / 2) * 2.5f, 0.5f, -(i / columns) * 2.5f);
+            copy->transform.Rotation = glm::vec3(90, 0, 0);
+        }
+
         // --- CARREGAR CHÃO ---
         auto floor = activeScene->CreateEntity("Floor");
         auto floorMesh = std::make_shared<Mesh>(ModelFactory::CreatePlaneMesh(1.0f));
@@ -145,11 +563,8 @@ private:
         floor->transform.Position = glm::vec3(0, -1.0f, 0);
 
         // --- ILUMINAÇÃO & IBL ---
-        // Tente carregar o HDR, se falhar não quebra o app
-        envMap.LoadFromHDR("models/golden_gate_hills_4k.hdr");
-        if (envMap.envCubemap) {
-            renderer.SetIBLMaps(envMap.GetIrradianceMapID(), envMap.GetPrefilterMapID(), envMap.brdfLUTTexture);
-        }
+        // A decodificação do HDR roda em paralelo com a do modelo
+        LoadEnvironment();
 
         // Luzes
         auto sun = activeScene->CreateEntity("Sun");
@@ -164,6 +579,24 @@ private:
         blueLight->transform.Position = glm::vec3(2, 1, 0);
         blueLight->AddComponent<FloaterScript>(1.0f, 2.0f);
 
+        // Cena de teste de luzes: pequenas e coloridas, na área ocupada pelos capacetes
+        if (extraLights > 0) {
+            std::mt19937 rng(1234);
+            float halfWidth = glm::max(columns * 1.25f, 5.0f);
+            float depth = glm::max((helmetInstances / columns + 1) * 2.5f, 5.0f);
+            std::uniform_real_distribution<float> xDist(-halfWidth, halfWidth);
+            std::uniform_real_distribution<float> zDist(-depth, 2.0f);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            for (int i = 0; i < extraLights; i++) {
+                auto light = activeScene->CreateEntity("PointLight " + std::to_string(i));
+                glm::vec3 color(unit(rng), unit(rng), unit(rng));
+                light->AddComponent<PointLightComponent>(color, 5.0f, 1.5f + 2.0f * unit(rng));
+                light->transform.Position = glm::vec3(xDist(rng), 0.2f + 1.5f * unit(rng), zDist(rng));
+                light->AddComponent<FloaterScript>(0.3f, 0.5f + unit(rng));
+            }
+            std::cout << extraLights << " luzes pontuais extras" << std::endl;
+        }
+
         activeScene->OnStart();
         std::cout << "Cena carregada!" << std::endl;
     }
@@ -192,10 +625,149 @@ private:
             }
         }
         mKeyPressed = mPressed;
+
+        // Liga/desliga a seleção de LOD para comparar triângulos e tempo de frame
+        bool lPressed = window->IsKeyPressed(GLFW_KEY_L);
+        if (lPressed && !lKeyPressed) {
+            renderer.SetLODEnabled(!renderer.IsLODEnabled());
+            std::cout << "LOD: " << (renderer.IsLODEnabled() ? "ligado" : "desligado") << std::endl;
+        }
+        lKeyPressed = lPressed;
+
+        // Picking: raio da câmera para o centro da tela contra a BVH da cena
+        bool pPressed = window->IsKeyPressed(GLFW_KEY_P);
+        if (pPressed && !pKeyPressed && activeScene) {
+            RaycastHit hit;
+            if (activeScene->Raycast(cameraPos, glm::vec3(0.0f) - cameraPos, 1000.0f, hit)) {
+                std::cout << "Pick: " << hit.entity->GetName() << " a " << hit.distance << "m" << std::endl;
+            } else {
+                std::cout << "Pick: nada" << std::endl;
+            }
+        }
+        pKeyPressed = pPressed;
+
+        // Alterna a ordenação da fila opaca para comparar trocas de estado
+        bool kPressed = window->IsKeyPressed(GLFW_KEY_K);
+        if (kPressed && !kKeyPressed) {
+            bool byState = renderer.GetSortMode() == SortMode::Distance;
+            renderer.SetSortMode(byState ? SortMode::StateKey : SortMode::Distance);
+            std::cout << "Ordenação: " << (byState ? "chave de estado" : "distância") << std::endl;
+        }
+        kKeyPressed = kPressed;
+
+        bool iPressed = window->IsKeyPressed(GLFW_KEY_I);
+        if (iPressed && !iKeyPressed) {
+            renderer.SetInstancing(!renderer.IsInstancingEnabled());
+            std::cout << "Instancing: " << (renderer.IsInstancingEnabled() ? "ligado" : "desligado") << std::endl;
+        }
+        iKeyPressed = iPressed;
+
+        // Multi-draw indirect sobre o GeometryArena contra um draw por batch
+        bool gPressed = window->IsKeyPressed(GLFW_KEY_G);
+        if (gPressed && !gKeyPressed) {
+            if (!renderer.IsMultiDrawIndirectSupported()) {
+                std::cout << "Multi-draw indirect: sem suporte no driver" << std::endl;
+            } else {
+                renderer.SetMultiDrawIndirect(!renderer.IsMultiDrawIndirectEnabled());
+                std::cout << "Multi-draw indirect: " << (renderer.IsMultiDrawIndirectEnabled() ? "ligado" : "desligado") << std::endl;
+            }
+        }
+        gKeyPressed = gPressed;
+
+        // Materiais por índice na MaterialTable contra Material::Apply por troca
+        bool tPressed = window->IsKeyPressed(GLFW_KEY_T);
+        if (tPressed && !tKeyPressed) {
+            if (!pbrTableShader) {
+                std::cout << "Tabela de materiais: shader MATERIAL_TABLE não compilou" << std::endl;
+            } else {
+                renderer.SetMaterialTable(!renderer.IsMaterialTableEnabled());
+                std::cout << "Tabela de materiais: " << (renderer.IsMaterialTableEnabled() ? "ligada" : "desligada") << std::endl;
+            }
+        }
+        tKeyPressed = tPressed;
+
+        // Forward contra deferred (G-buffer + passe de luz em tela cheia)
+        bool fPressed = window->IsKeyPressed(GLFW_KEY_F);
+        if (fPressed && !fKeyPressed) {
+            if (!pbrGBufferShader || !deferredLightingShader) {
+                std::cout << "Deferred: shaders GBUFFER/deferred_lighting não compilaram" << std::endl;
+            } else {
+                renderer.SetDeferred(!renderer.IsDeferredEnabled());
+                std::cout << "Caminho: " << (renderer.IsDeferredEnabled() ? "deferred" : "forward") << std::endl;
+            }
+        }
+        fKeyPressed = fPressed;
+
+        // Binning de luzes na CPU: só as que tocam algum draw vão para os clusters
+        bool bPressed = window->IsKeyPressed(GLFW_KEY_B);
+        if (bPressed && !bKeyPressed) {
+            renderer.SetLightBinning(!renderer.IsLightBinningEnabled());
+            std::cout << "Binning de luzes: " << (renderer.IsLightBinningEnabled() ? "ligado" : "desligado") << std::endl;
+        }
+        bKeyPressed = bPressed;
+    }
+
+    void PrintStats(float dt) {
+        statsTimer += dt;
+        statsFrames++;
+        if (statsTimer < 2.0) return;
+
+        const RenderStats& stats = renderer.GetStats();
+        double frameMs = statsTimer * 1000.0 / statsFrames;
+        std::cout << "[Stats] " << static_cast<int>(1000.0 / frameMs) << " FPS, " << frameMs << " ms/frame, "
+                  << stats.drawCalls << " draws (" << stats.instances << " instâncias, "
+                  << stats.indirectCommands << " comandos indiretos), " << stats.triangles << " triângulos (LOD0: "
+                  << stats.trianglesLOD0 << "), draws por LOD: " << stats.lodDraws[0] << "/"
+                  << stats.lodDraws[1] << "/" << stats.lodDraws[2] << "/" << stats.lodDraws[3]
+                  << ", visíveis " << stats.visible << ", descartados " << stats.culled
+                  << " (culling " << stats.cullMs << " ms), binds shader/material/VAO "
+                  << stats.shaderBinds << "/" << stats.materialBinds << "/" << stats.vaoBinds
+                  << " (sort " << stats.sortMs << " ms), GL " << lastGLStats.issued << " chamadas / "
+                  << lastGLStats.skipped << " evitadas, stream " << stats.streamBytes / 1024 << " KB ("
+                  << stats.streamWaits << " esperas, " << stats.streamWaitMs << " ms), luzes "
+                  << stats.pointLights << " (" << stats.lightIndices << " índices, máx. " << stats.maxLightsPerCluster
+                  << " por cluster, " << stats.lightClusterMs << " ms)";
+        if (renderer.IsLightBinningEnabled()) {
+            std::cout << ", binning " << stats.lightsInFrustum << " no frustum / " << stats.lightsUsed
+                      << " tocam draws (" << stats.drawLightIndices << " pares, " << stats.lightBinMs << " ms, "
+                      << LightKernels::GetName() << ")";
+        }
+        if (activeScene) {
+            const SceneStats& sceneStats = activeScene->GetStats();
+            std::cout << ", entidades " << sceneStats.visibleEntities << "/" << sceneStats.boundedEntities
+                      << " na BVH";
+        }
+        std::cout << (renderer.IsLODEnabled() ? "" : " [LOD desligado]")
+                  << (renderer.IsInstancingEnabled() ? "" : " [instancing desligado]")
+                  << (renderer.IsMaterialTableEnabled() ? " [tabela de materiais]" : "")
+                  << (renderer.IsDeferredEnabled() ? " [deferred]" : "") << std::endl;
+
+        if (Profiler::GetInstance().IsEnabled()) Profiler::GetInstance().PrintSummary();
+
+        statsTimer = 0.0;
+        statsFrames = 0;
     }
 
     void Update(float dt) {
+        // Salvar material original assim que o modelo terminar de carregar
+        if (!helmetMaterialSaved && helmetHandle.IsReady()) {
+            auto model = helmetHandle.Get();
+            if (model->GetMeshCount() > 0)
+                materials.push_back(model->GetMesh(0).GetMaterial());
+            helmetMaterialSaved = true;
+
+            // Cena completa na GPU: relatório de memória das meshes
+            Mesh::GetMemoryStats().Print();
+            if (GeometryArena::GetInstance().IsEnabled()) GeometryArena::GetInstance().GetStats().Print();
+        }
+        if (!helmetMaterialSaved && helmetHandle.HasFailed()) {
+            std::cerr << "Erro carregando modelo" << std::endl;
+            helmetMaterialSaved = true;
+        }
+
         if (activeScene) activeScene->OnUpdate(dt);
+
+        PrintStats(dt);
     }
 
     void Render() {
@@ -204,19 +776,36 @@ private:
         glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        glm::mat4 view = glm::lookAt(cameraPos, glm::vec3(0,0,0), glm::vec3(0,1,0));
-        glm::mat4 proj = glm::perspective(glm::radians(45.0f), window->GetAspect(), 0.1f, 100.0f);
+        glm::mat4 view = glm::lookAt(cameraPos, cameraTarget, glm::vec3(0,1,0));
+        glm::mat4 proj = glm::perspective(glm::radians(45.0f), window->GetAspect(), nearPlane, farPlane);
 
         renderer.BeginScene(view, proj, cameraPos);
-        if (activeScene) activeScene->OnRender(renderer);
+        if (activeScene) {
+            PROFILE_SCOPE("Scene::OnRender");
+            activeScene->OnRender(renderer);
+        }
         renderer.EndScene();
 
         renderer.DrawSkybox(envMap.envCubemap, view, proj);
 
         // 2. Post-Process (Screen)
-        fb->Unbind();
+        PROFILE_SCOPE("PostProcess");
+        if (outputFb) outputFb->Bind();
+        else fb->Unbind();
         renderer.DrawScreenQuad(*screenShader, fb->GetTexture());
     }
+
+    // Captura assíncrona do outputFb; o PNG é codificado e gravado na thread do FrameCapture
+    void SaveFrame(const std::string& name) {
+        if (!outputFb || outputDir.empty()) return;
+        PROFILE_SCOPE("Capture");
+
+        std::string path = (std::filesystem::path(outputDir) / name).string();
+        frameCapture.Capture(outputFb->GetFramebufferId(), outputFb->GetWidth(), outputFb->GetHeight(),
+                             [path](const CapturedFrame& captured) {
+                                 ImageWriter::WritePNG(path, captured.pixels.data(), captured.width, captured.height);
+                             });
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,163 @@
+#ifndef BATCH_JOB_HPP
+#define BATCH_JOB_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Formato dos frames de um lote: PNG (tela, 8 bits), EXR (cena HDR, float) ou RGBA8 cru num pipe
+enum class FrameFormat {
+    PNG,
+    EXR,
+    Raw
+};
+
+/**
+ * @brief Órbita em torno do centro da caixa do modelo.
+ *
+ * Distância em raios da esfera envolvente, para que modelos de escalas
+ * diferentes saiam enquadrados iguais. sweepDegrees = 0 dá uma câmera parada.
+ */
+struct CameraPath {
+    float startDegrees = 0.0f;
+    float sweepDegrees = 360.0f;  // Giro total ao longo do job
+    float distance = 2.5f;        // Em raios do modelo
+    float elevationDegrees = 20.0f;
+
+    // t em [0, 1): posição do frame dentro do job
+    glm::vec3 Evaluate(float t, const glm::vec3& center, float radius) const {
+        float azimuth = glm::radians(startDegrees + sweepDegrees * t);
+        float elevation = glm::radians(elevationDegrees);
+        float d = distance * glm::max(radius, 1e-3f);
+        return center + d * glm::vec3(std::cos(elevation) * std::sin(azimuth), std::sin(elevation),
+                                      std::cos(elevation) * std::cos(azimuth));
+    }
+};
+
+struct BatchJob {
+    std::string modelPath;
+    std::string material;           // Nome no MaterialLibrary; vazio = materiais do modelo
+    int frames = 1;
+    CameraPath camera;
+    glm::vec3 rotation = glm::vec3(0.0f); // Euler em graus aplicado ao modelo
+};
+
+namespace BatchJobs {
+
+inline bool ParseVec3(const std::string& text, glm::vec3& out) {
+    float v[3];
+    std::stringstream stream(text);
+    std::string item;
+    for (int i = 0; i < 3; i++) {
+        if (!std::getline(stream, item, ',')) return false;
+        v[i] = static_cast<float>(std::atof(item.c_str()));
+    }
+    out = glm::vec3(v[0], v[1], v[2]);
+    return true;
+}
+
+// "sweep,distância,elevação[,início]"; campos omitidos mantêm o padrão
+inline bool ParseCamera(const std::string& text, CameraPath& camera) {
+    float* fields[4] = { &camera.sweepDegrees, &camera.distance, &camera.elevationDegrees, &camera.startDegrees };
+    std::stringstream stream(text);
+    std::string item;
+    int count = 0;
+    while (std::getline(stream, item, ',')) {
+        if (count >= 4) return false;
+        if (!item.empty()) *fields[count] = static_cast<float>(std::atof(item.c_str()));
+        count++;
+    }
+    return count > 0;
+}
+
+/**
+ * @brief Lê um arquivo de jobs: um por linha, "#" comenta.
+ *
+ *   <modelo> [material=gold] [frames=60] [camera=360,2.5,20] [rotate=90,0,0]
+ *
+ * defaultFrames vale para as linhas sem frames=.
+ */
+inline bool LoadFile(const std::string& path, int defaultFrames, std::vector<BatchJob>& jobs) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "[Batch] Não foi possível abrir " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::stringstream tokens(line);
+        std::string token;
+        if (!(tokens >> token)) continue;
+
+        BatchJob job;
+        job.modelPath = token;
+        job.frames = defaultFrames;
+        bool ok = true;
+        while (tokens >> token) {
+            size_t eq = token.find('=');
+            std::string key = token.substr(0, eq);
+            std::string value = eq == std::string::npos ? "" : token.substr(eq + 1);
+            if (key == "material") job.material = value;
+            else if (key == "frames") job.frames = std::max(std::atoi(value.c_str()), 1);
+            else if (key == "camera") ok = ParseCamera(value, job.camera);
+            else if (key == "rotate") ok = ParseVec3(value, job.rotation);
+            else ok = false;
+
+            if (!ok) {
+                std::cerr << "[Batch] " << path << ":" << lineNumber << ": opção inválida '" << token << "'" << std::endl;
+                return false;
+            }
+        }
+        jobs.push_back(job);
+    }
+    return true;
+}
+
+// Um job por modelo encontrado em dir (recursivo), em ordem alfabética
+inline void FromDirectory(const std::string& dir, int frames, const std::string& material, std::vector<BatchJob>& jobs) {
+    static const char* extensions[] = { ".glb", ".gltf", ".obj", ".fbx", ".dae", ".3ds" };
+
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (auto it = std::filesystem::recursive_directory_iterator(dir, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (!it->is_regular_file()) continue;
+        std::string ext = it->path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+        for (const char* candidate : extensions) {
+            if (ext == candidate) {
+                paths.push_back(it->path().string());
+                break;
+            }
+        }
+    }
+    if (ec) std::cerr << "[Batch] Erro listando " << dir << ": " << ec.message() << std::endl;
+
+    std::sort(paths.begin(), paths.end());
+    for (const auto& path : paths) {
+        BatchJob job;
+        job.modelPath = path;
+        job.material = material;
+        job.frames = std::max(frames, 1);
+        jobs.push_back(job);
+    }
+}
+
+} // namespace BatchJobs
+
+#endif // BATCH_JOB_HPP
@@ -0,0 +1,52 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace Hash {
+
+// FNV-1a 64 bits. Rápido, sem alocação e utilizável em tempo de compilação.
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+constexpr uint64_t FNV1a(const char* data, size_t length, uint64_t seed = FNV_OFFSET) {
+    uint64_t hash = seed;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint64_t>(static_cast<unsigned char>(data[i]));
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+constexpr uint64_t FNV1a(const char* str) {
+    uint64_t hash = FNV_OFFSET;
+    while (*str) {
+        hash ^= static_cast<uint64_t>(static_cast<unsigned char>(*str++));
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+inline uint64_t FNV1a(const std::string& str) {
+    return FNV1a(str.data(), str.size());
+}
+
+inline uint64_t FNV1a(const void* data, size_t length, uint64_t seed = FNV_OFFSET) {
+    return FNV1a(static_cast<const char*>(data), length, seed);
+}
+
+inline std::string ToHex(uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out(16, '0');
+    for (int i = 15; i >= 0; i--) {
+        out[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+    return out;
+}
+
+} // namespace Hash
+
+#endif // HASH_HPP
@@ -0,0 +1,185 @@
+#ifndef HEADLESS_CONTEXT_HPP
+#define HEADLESS_CONTEXT_HPP
+
+#include <cstring>
+#include <iostream>
+
+#ifdef HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+/**
+ * @brief Contexto OpenGL 3.3 core sem janela nem servidor X, via EGL.
+ *
+ * Tenta, em ordem, a primeira GPU do EGL_EXT_platform_device (NVIDIA, Mesa com
+ * DRM), o EGL_MESA_platform_surfaceless (Mesa, inclusive llvmpipe com
+ * LIBGL_ALWAYS_SOFTWARE=1) e o display padrão. O contexto fica corrente sem
+ * superfície quando o driver tem EGL_KHR_surfaceless_context; senão, com um
+ * pbuffer do tamanho pedido. Em ambos os casos não há framebuffer padrão
+ * utilizável: tudo é desenhado em FBOs.
+ *
+ * Só existe com HAS_EGL (o CMake define quando acha libEGL).
+ */
+class HeadlessContext {
+public:
+    HeadlessContext() = default;
+
+    static bool IsAvailable() {
+#ifdef HAS_EGL
+        return true;
+#else
+        return false;
+#endif
+    }
+
+#ifdef HAS_EGL
+private:
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+    EGLSurface surface = EGL_NO_SURFACE;
+    const char* platformName = "nenhuma";
+
+    static bool hasExtension(const char* list, const char* name) {
+        if (!list) return false;
+        size_t length = std::strlen(name);
+        for (const char* p = list; (p = std::strstr(p, name)) != nullptr; p += length) {
+            bool startOk = p == list || p[-1] == ' ';
+            bool endOk = p[length] == ' ' || p[length] == '\0';
+            if (startOk && endOk) return true;
+        }
+        return false;
+    }
+
+    // Inicializa o display e cria o contexto; false deixa tudo limpo para a próxima tentativa
+    bool tryDisplay(EGLDisplay candidate, int width, int height) {
+        if (candidate == EGL_NO_DISPLAY) return false;
+
+        EGLint major = 0, minor = 0;
+        if (!eglInitialize(candidate, &major, &minor)) return false;
+
+        if (!eglBindAPI(EGL_OPENGL_API)) {
+            eglTerminate(candidate);
+            return false;
+        }
+
+        bool surfaceless = hasExtension(eglQueryString(candidate, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_ALPHA_SIZE, 8,
+            EGL_DEPTH_SIZE, 24,
+            EGL_NONE
+        };
+        EGLConfig config = nullptr;
+        EGLint configCount = 0;
+        if (!eglChooseConfig(candidate, configAttribs, &config, 1, &configCount) || configCount == 0) {
+            eglTerminate(candidate);
+            return false;
+        }
+
+        // Mesmos valores de EGL_KHR_create_context, para drivers EGL 1.4
+        const EGLint contextAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION_KHR, 3,
+            EGL_CONTEXT_MINOR_VERSION_KHR, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+            EGL_NONE
+        };
+        EGLContext created = eglCreateContext(candidate, config, EGL_NO_CONTEXT, contextAttribs);
+        if (created == EGL_NO_CONTEXT) {
+            eglTerminate(candidate);
+            return false;
+        }
+
+        EGLSurface pbuffer = EGL_NO_SURFACE;
+        if (!surfaceless) {
+            const EGLint pbufferAttribs[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+            pbuffer = eglCreatePbufferSurface(candidate, config, pbufferAttribs);
+            if (pbuffer == EGL_NO_SURFACE) {
+                eglDestroyContext(candidate, created);
+                eglTerminate(candidate);
+                return false;
+            }
+        }
+
+        if (!eglMakeCurrent(candidate, pbuffer, pbuffer, created)) {
+            if (pbuffer != EGL_NO_SURFACE) eglDestroySurface(candidate, pbuffer);
+            eglDestroyContext(candidate, created);
+            eglTerminate(candidate);
+            return false;
+        }
+
+        display = candidate;
+        context = created;
+        surface = pbuffer;
+        std::cout << "[Headless] EGL " << major << "." << minor << " (" << platformName << ", "
+                  << (surfaceless ? "sem superfície" : "pbuffer") << ")" << std::endl;
+        return true;
+    }
+
+public:
+    ~HeadlessContext() { Destroy(); }
+
+    bool Init(int width, int height) {
+        const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+        // 1. Primeira GPU enumerada (não precisa de X nem de /dev/dri/card aberto por outro processo)
+        if (getPlatformDisplay && hasExtension(clientExtensions, "EGL_EXT_platform_device")) {
+            auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+            EGLDeviceEXT devices[8];
+            EGLint deviceCount = 0;
+            if (queryDevices && queryDevices(8, devices, &deviceCount)) {
+                platformName = "device";
+                for (EGLint i = 0; i < deviceCount; i++) {
+                    if (tryDisplay(getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[i], nullptr), width, height))
+                        return true;
+                }
+            }
+        }
+
+        // 2. Mesa sem nenhum sistema de janelas
+        if (getPlatformDisplay && hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+            platformName = "surfaceless";
+            if (tryDisplay(getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr), width, height))
+                return true;
+        }
+
+        // 3. O que o driver escolher (pode depender de EGL_PLATFORM)
+        platformName = "default";
+        if (tryDisplay(eglGetDisplay(EGL_DEFAULT_DISPLAY), width, height)) return true;
+
+        std::cerr << "[Headless] Nenhum display EGL com OpenGL 3.3 core disponível" << std::endl;
+        return false;
+    }
+
+    void Destroy() {
+        if (display == EGL_NO_DISPLAY) return;
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (surface != EGL_NO_SURFACE) eglDestroySurface(display, surface);
+        if (context != EGL_NO_CONTEXT) eglDestroyContext(display, context);
+        eglTerminate(display);
+        display = EGL_NO_DISPLAY;
+        context = EGL_NO_CONTEXT;
+        surface = EGL_NO_SURFACE;
+    }
+#else
+public:
+    bool Init(int, int) {
+        std::cerr << "[Headless] Compilado sem EGL (instale libegl-dev e reconfigure o CMake)" << std::endl;
+        return false;
+    }
+
+    void Destroy() {}
+#endif
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+};
+
+#endif // HEADLESS_CONTEXT_HPP
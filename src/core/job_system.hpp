@@ -0,0 +1,119 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <type_traits>
+
+/**
+ * @brief Pool de threads para trabalho de CPU (I/O, Assimp, decodificação).
+ *
+ * Nenhum job pode chamar OpenGL: o contexto só existe na thread principal.
+ * Para esperar um resultado de dentro de outro job use Wait(), que executa
+ * jobs pendentes enquanto espera e evita deadlock quando o pool está cheio.
+ */
+class JobSystem {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> queue;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+
+    void workerLoop() {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]() { return stopping || !queue.empty(); });
+                if (stopping && queue.empty()) return;
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+            job();
+        }
+    }
+
+public:
+    explicit JobSystem(unsigned int threadCount = 0) {
+        if (threadCount == 0) {
+            unsigned int hw = std::thread::hardware_concurrency();
+            // Deixa um núcleo para a thread de render
+            threadCount = hw > 1 ? hw - 1 : 1;
+        }
+
+        workers.reserve(threadCount);
+        for (unsigned int i = 0; i < threadCount; i++) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        for (auto& worker : workers) {
+            if (worker.joinable()) worker.join();
+        }
+    }
+
+    static JobSystem& GetInstance() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    template <typename F>
+    auto Submit(F&& fn) -> std::future<typename std::invoke_result<F>::type> {
+        using Result = typename std::invoke_result<F>::type;
+
+        // std::function exige cópia; packaged_task é move-only
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+        std::future<Result> future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.emplace_back([task]() { (*task)(); });
+        }
+        condition.notify_one();
+        return future;
+    }
+
+    // Executa um job pendente na thread atual. Retorna false se a fila estava vazia.
+    bool RunPendingJob() {
+        std::function<void()> job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.empty()) return false;
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        job();
+        return true;
+    }
+
+    template <typename T>
+    T Wait(std::future<T>& future) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            if (!RunPendingJob()) {
+                future.wait_for(std::chrono::microseconds(200));
+            }
+        }
+        return future.get();
+    }
+
+    size_t GetWorkerCount() const { return workers.size(); }
+
+    // Prevenir cópia
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+};
+
+#endif // JOB_SYSTEM_HPP
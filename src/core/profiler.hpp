@@ -0,0 +1,335 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hash.hpp"
+
+/**
+ * @brief Profiler de frame com zonas nomeadas e aninháveis, em CPU e GPU.
+ *
+ * Cada zona guarda o tempo de CPU (steady_clock) e, na GPU, dois
+ * glQueryCounter(GL_TIMESTAMP): um na entrada e outro na saída. Timestamps,
+ * ao contrário de GL_TIME_ELAPSED, podem ser aninhados (só uma query
+ * TIME_ELAPSED fica ativa por vez). As queries ficam em FrameLatency pools: as
+ * do frame N são lidas no BeginFrame do N+2, quando a GPU já terminou, então
+ * ler não trava o pipeline.
+ *
+ * Saídas: média/máximo das últimas HistoryFrames amostras por zona
+ * (PrintSummary) e, com SetTracing(true), eventos no formato Trace Event do
+ * Chrome (ExportChromeTrace; abrir em chrome://tracing ou ui.perfetto.dev).
+ *
+ * Só a thread do contexto OpenGL pode abrir zonas. Desligado, cada zona custa
+ * um teste de flag.
+ */
+class Profiler {
+public:
+    static constexpr int FrameLatency = 2;
+    static constexpr size_t HistoryFrames = 120;
+    static constexpr size_t MaxTraceEvents = 1u << 20;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Zone {
+        const char* name;
+        int depth;
+        double cpuBeginUs;
+        double cpuEndUs;
+        int queryBegin; // Índices no pool do frame; -1 sem GPU
+        int queryEnd;
+    };
+
+    struct FrameRecord {
+        uint64_t index = 0;
+        std::vector<Zone> zones;
+        std::vector<GLuint> queries;
+        size_t usedQueries = 0;
+        bool pending = false; // Fechado, esperando a leitura das queries
+    };
+
+    struct History {
+        const char* name;
+        int depth;
+        float cpuMs[HistoryFrames];
+        float gpuMs[HistoryFrames];
+        size_t count = 0;
+        size_t head = 0;
+    };
+
+    struct TraceEvent {
+        const char* name;
+        bool gpu;
+        double beginUs;
+        double durationUs;
+        uint64_t frame;
+    };
+
+    bool enabled = false;
+    bool gpuTiming = false;
+    bool tracing = false;
+
+    FrameRecord frames[FrameLatency];
+    int current = 0;
+    bool frameOpen = false;
+    uint64_t frameIndex = 0;
+    std::vector<int> stack;
+
+    Clock::time_point start = Clock::now();
+    double gpuOffsetUs = 0.0; // Soma ao timestamp da GPU (us) para cair na linha de tempo da CPU
+
+    std::vector<History> history;
+    std::unordered_map<uint64_t, size_t> historyIndex;
+    std::vector<TraceEvent> trace;
+    uint32_t gpuStalls = 0; // Leituras em que a GPU ainda não tinha terminado (não deveria acontecer)
+
+    Profiler() = default;
+
+    double nowUs() const {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+
+    int nextQuery(FrameRecord& frame) {
+        if (frame.usedQueries == frame.queries.size()) {
+            size_t grow = std::max<size_t>(frame.queries.size(), 32);
+            frame.queries.resize(frame.queries.size() + grow);
+            glGenQueries(static_cast<GLsizei>(grow), frame.queries.data() + frame.usedQueries);
+        }
+        int index = static_cast<int>(frame.usedQueries++);
+        glQueryCounter(frame.queries[index], GL_TIMESTAMP);
+        return index;
+    }
+
+    History& historyFor(const Zone& zone) {
+        uint64_t key = Hash::FNV1a(zone.name) ^ static_cast<uint64_t>(zone.depth);
+        auto it = historyIndex.find(key);
+        if (it != historyIndex.end()) return history[it->second];
+
+        historyIndex[key] = history.size();
+        history.emplace_back();
+        history.back().name = zone.name;
+        history.back().depth = zone.depth;
+        return history.back();
+    }
+
+    // Lê as queries de um frame fechado e alimenta o histórico e o trace
+    void resolve(FrameRecord& frame) {
+        if (!frame.pending) return;
+
+        std::vector<GLuint64> timestamps(frame.usedQueries, 0);
+        if (frame.usedQueries > 0) {
+            GLint available = 0;
+            glGetQueryObjectiv(frame.queries[frame.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) gpuStalls++;
+            for (size_t i = 0; i < frame.usedQueries; i++) {
+                glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &timestamps[i]);
+            }
+        }
+
+        for (const Zone& zone : frame.zones) {
+            bool hasGpu = zone.queryBegin >= 0 && zone.queryEnd >= 0;
+            double cpuUs = zone.cpuEndUs - zone.cpuBeginUs;
+            double gpuUs = hasGpu ? (timestamps[zone.queryEnd] - timestamps[zone.queryBegin]) / 1000.0 : 0.0;
+
+            History& h = historyFor(zone);
+            h.cpuMs[h.head] = static_cast<float>(cpuUs / 1000.0);
+            h.gpuMs[h.head] = static_cast<float>(gpuUs / 1000.0);
+            h.head = (h.head + 1) % HistoryFrames;
+            h.count = std::min(h.count + 1, HistoryFrames);
+
+            if (tracing && trace.size() + 2 <= MaxTraceEvents) {
+                trace.push_back({ zone.name, false, zone.cpuBeginUs, cpuUs, frame.index });
+                if (hasGpu) {
+                    double gpuBeginUs = timestamps[zone.queryBegin] / 1000.0 + gpuOffsetUs;
+                    trace.push_back({ zone.name, true, gpuBeginUs, gpuUs, frame.index });
+                }
+            }
+        }
+
+        frame.zones.clear();
+        frame.usedQueries = 0;
+        frame.pending = false;
+    }
+
+    static void writeEscaped(std::ostream& out, const char* text) {
+        for (const char* c = text; *c; c++) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+    }
+
+public:
+    static Profiler& GetInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    /**
+     * @brief Liga/desliga a coleta. Ligar com um contexto corrente habilita a
+     * parte de GPU (timer queries são core no GL 3.3) e alinha os relógios.
+     */
+    void SetEnabled(bool value) {
+        if (value && !enabled) {
+            gpuTiming = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+            if (gpuTiming) {
+                GLint64 gpuNow = 0;
+                glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+                gpuOffsetUs = nowUs() - gpuNow / 1000.0;
+            }
+        }
+        enabled = value;
+    }
+
+    bool IsEnabled() const { return enabled; }
+
+    // Guarda os eventos para ExportChromeTrace (até MaxTraceEvents)
+    void SetTracing(bool value) { tracing = value; }
+
+    // Abre o frame e a zona raiz "Frame"; lê as queries do frame que usou este pool
+    void BeginFrame() {
+        if (!enabled || frameOpen) return;
+
+        current = static_cast<int>(frameIndex % FrameLatency);
+        resolve(frames[current]);
+        frames[current].index = frameIndex;
+        frameOpen = true;
+        BeginZone("Frame");
+    }
+
+    void EndFrame() {
+        if (!frameOpen) return;
+        while (!stack.empty()) EndZone(stack.back());
+        frames[current].pending = true;
+        frameOpen = false;
+        frameIndex++;
+    }
+
+    // Lê os frames ainda pendentes, do mais antigo ao mais novo (bloqueia até a GPU terminar).
+    // Para o fim da execução, antes do último PrintSummary/ExportChromeTrace
+    void ResolveAll() {
+        if (frameOpen) return;
+        for (int i = 0; i < FrameLatency; i++) resolve(frames[(frameIndex + i) % FrameLatency]);
+    }
+
+    // Retorna o id da zona para o EndZone; -1 fora de um frame
+    int BeginZone(const char* name) {
+        if (!frameOpen) return -1;
+        FrameRecord& frame = frames[current];
+        int id = static_cast<int>(frame.zones.size());
+        frame.zones.push_back({ name, static_cast<int>(stack.size()), nowUs(), 0.0, -1, -1 });
+        if (gpuTiming) frame.zones.back().queryBegin = nextQuery(frame);
+        stack.push_back(id);
+        return id;
+    }
+
+    void EndZone(int id) {
+        if (!frameOpen || id < 0) return;
+        if (std::find(stack.begin(), stack.end(), id) == stack.end()) return; // Já fechada
+        FrameRecord& frame = frames[current];
+        // Fecha também zonas internas esquecidas abertas
+        while (!stack.empty()) {
+            int top = stack.back();
+            stack.pop_back();
+            Zone& zone = frame.zones[top];
+            zone.cpuEndUs = nowUs();
+            if (gpuTiming) zone.queryEnd = nextQuery(frame);
+            if (top == id) break;
+        }
+    }
+
+    // Média e máximo das últimas amostras, uma linha por zona, recuada pela profundidade
+    void PrintSummary() const {
+        if (history.empty()) return;
+        std::ios_base::fmtflags flags = std::cout.flags();
+        std::cout << "[Profiler] zona                          CPU média/máx (ms)   GPU média/máx (ms)" << std::endl;
+        for (const History& h : history) {
+            if (h.count == 0) continue;
+            double cpuSum = 0.0, gpuSum = 0.0;
+            float cpuMax = 0.0f, gpuMax = 0.0f;
+            for (size_t i = 0; i < h.count; i++) {
+                cpuSum += h.cpuMs[i];
+                gpuSum += h.gpuMs[i];
+                cpuMax = std::max(cpuMax, h.cpuMs[i]);
+                gpuMax = std::max(gpuMax, h.gpuMs[i]);
+            }
+            std::string label = std::string(h.depth * 2, ' ') + h.name;
+            std::cout << "[Profiler] " << std::left << std::setw(30) << label << std::right << std::fixed
+                      << std::setprecision(3) << std::setw(9) << cpuSum / h.count << " / " << std::setw(7) << cpuMax;
+            if (gpuTiming) std::cout << std::setw(11) << gpuSum / h.count << " / " << std::setw(7) << gpuMax;
+            std::cout << std::endl;
+        }
+        if (gpuStalls > 0) std::cout << "[Profiler] " << gpuStalls << " leituras esperaram a GPU" << std::endl;
+        std::cout.flags(flags);
+    }
+
+    /**
+     * @brief Grava os eventos no formato JSON do Chrome: CPU na tid 1, GPU na
+     * tid 2, ambas na linha de tempo da CPU. Frames ainda não lidos ficam
+     * de fora (ver ResolveAll).
+     */
+    bool ExportChromeTrace(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            std::cerr << "[Profiler] Não foi possível criar " << path << std::endl;
+            return false;
+        }
+
+        // ostream sobre o FILE não existe no padrão: monta em string e grava de uma vez
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+        for (const TraceEvent& e : trace) {
+            out << ",\n{\"name\":\"";
+            writeEscaped(out, e.name);
+            out << "\",\"cat\":\"" << (e.gpu ? "gpu" : "cpu") << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << (e.gpu ? 2 : 1) << ",\"ts\":" << e.beginUs << ",\"dur\":" << e.durationUs
+                << ",\"args\":{\"frame\":" << e.frame << "}}";
+        }
+        out << "\n]}\n";
+
+        std::string json = out.str();
+        bool ok = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+        ok = std::fclose(file) == 0 && ok;
+        if (ok) std::cout << "[Profiler] " << trace.size() << " eventos gravados em " << path << std::endl;
+        return ok;
+    }
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+};
+
+/**
+ * @brief Zona RAII: abre no construtor e fecha no destrutor.
+ * name precisa viver até o fim do programa (literal).
+ */
+class ProfileScope {
+private:
+    int id;
+
+public:
+    explicit ProfileScope(const char* name) : id(Profiler::GetInstance().IsEnabled() ? Profiler::GetInstance().BeginZone(name) : -1) {}
+    ~ProfileScope() {
+        if (id >= 0) Profiler::GetInstance().EndZone(id);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+#endif // PROFILER_HPP
@@ -6,6 +6,16 @@
 #include <string>
 #include <iostream>
 #include <functional>
+#include <chrono>
+
+#include "headless_context.hpp"
+#include "../renderer/gl_state.hpp"
+
+// Glfw: janela visível com swap. Headless: contexto EGL sem janela (servidores sem display)
+enum class WindowBackend {
+    Glfw,
+    Headless
+};
 
 class Window {
 private:
@@ -13,13 +23,19 @@ private:
     int width;
     int height;
     std::string title;
+    WindowBackend backend;
+
+    // Só no modo headless: não há janela para fechar nem glfwGetTime
+    HeadlessContext headless;
+    bool closeRequested = false;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
 
     // Callback para notificar a Application sobre resize
     std::function<void(int, int)> resizeCallback;
 
     // Função estática para o GLFW chamar
     static void FramebufferSizeCallback(GLFWwindow* window, int w, int h) {
-        glViewport(0, 0, w, h);
+        GLState::GetInstance().SetViewport(0, 0, w, h);
         
         // Recupera o ponteiro da nossa classe Window
         Window* win = static_cast<Window*>(glfwGetWindowUserPointer(window));
@@ -31,11 +47,37 @@ private:
         }
     }
 
+    bool initHeadless() {
+        if (!headless.Init(width, height)) return false;
+        startTime = std::chrono::steady_clock::now();
+
+        // O GLEW do sistema costuma ser compilado para GLX: sem display X ele reclama
+        // depois de já ter carregado as funções do contexto corrente
+        glewExperimental = GL_TRUE;
+        GLenum status = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+        if (status == GLEW_ERROR_NO_GLX_DISPLAY) status = GLEW_OK;
+#endif
+        if (status != GLEW_OK) {
+            std::cerr << "Falha ao iniciar GLEW" << std::endl;
+            return false;
+        }
+        // O glewInit pode deixar um GL_INVALID_ENUM pendente no perfil core
+        while (glGetError() != GL_NO_ERROR) {}
+
+        GLState::GetInstance().SetViewport(0, 0, width, height);
+        return true;
+    }
+
 public:
-    Window(int w, int h, const std::string& t) 
-        : handle(nullptr), width(w), height(h), title(t) {}
+    Window(int w, int h, const std::string& t, WindowBackend b = WindowBackend::Glfw) 
+        : handle(nullptr), width(w), height(h), title(t), backend(b) {}
 
     ~Window() {
+        if (backend == WindowBackend::Headless) {
+            headless.Destroy();
+            return;
+        }
         if (handle) {
             glfwDestroyWindow(handle);
         }
@@ -43,6 +85,8 @@ public:
     }
 
     bool Init() {
+        if (backend == WindowBackend::Headless) return initHeadless();
+
         if (!glfwInit()) {
             std::cerr << "Falha ao iniciar GLFW" << std::endl;
             return false;
@@ -76,33 +120,48 @@ public:
     }
 
     void OnUpdate() {
+        if (backend == WindowBackend::Headless) return;
         glfwSwapBuffers(handle);
         glfwPollEvents();
     }
 
     bool ShouldClose() const {
+        if (backend == WindowBackend::Headless) return closeRequested;
         return glfwWindowShouldClose(handle);
     }
 
+    // Segundos desde o Init (glfwGetTime precisa do glfwInit, que o headless não chama)
+    double GetTime() const {
+        if (backend == WindowBackend::Headless)
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        return glfwGetTime();
+    }
+
     void SetResizeCallback(const std::function<void(int, int)>& callback) {
         resizeCallback = callback;
     }
 
     // Input Helpers
+    // Sem janela nenhuma tecla está pressionada
     bool IsKeyPressed(int key) const {
-        return glfwGetKey(handle, key) == GLFW_PRESS;
+        return handle && glfwGetKey(handle, key) == GLFW_PRESS;
     }
     
     bool IsKeyReleased(int key) const {
-        return glfwGetKey(handle, key) == GLFW_RELEASE;
+        return !handle || glfwGetKey(handle, key) == GLFW_RELEASE;
     }
 
     void Close() {
+        if (backend == WindowBackend::Headless) {
+            closeRequested = true;
+            return;
+        }
         glfwSetWindowShouldClose(handle, true);
     }
 
     // Getters
     GLFWwindow* GetNativeWindow() const { return handle; }
+    bool IsHeadless() const { return backend == WindowBackend::Headless; }
     int GetWidth() const { return width; }
     int GetHeight() const { return height; }
     float GetAspect() const { return (float)width / (float)height; }
@@ -0,0 +1,240 @@
+#ifndef ASSET_LOADER_HPP
+#define ASSET_LOADER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "model.hpp"
+#include "texture.hpp"
+#include "../core/job_system.hpp"
+
+enum class AssetStatus {
+    Pending,
+    Ready,
+    Failed
+};
+
+/**
+ * @brief Referência a um asset carregado em segundo plano.
+ *
+ * Get() retorna nullptr até o upload na GPU terminar. Pode ser copiada
+ * livremente; todas as cópias enxergam o mesmo estado.
+ */
+template <typename T>
+class AssetHandle {
+public:
+    struct State {
+        std::atomic<AssetStatus> status{ AssetStatus::Pending };
+        std::shared_ptr<T> asset;
+    };
+
+private:
+    std::shared_ptr<State> state;
+
+public:
+    AssetHandle() = default;
+    explicit AssetHandle(std::shared_ptr<State> s) : state(std::move(s)) {}
+
+    bool IsValid() const { return state != nullptr; }
+    bool IsReady() const { return state && state->status.load() == AssetStatus::Ready; }
+    bool HasFailed() const { return state && state->status.load() == AssetStatus::Failed; }
+    AssetStatus GetStatus() const { return state ? state->status.load() : AssetStatus::Failed; }
+
+    std::shared_ptr<T> Get() const { return IsReady() ? state->asset : nullptr; }
+};
+
+/**
+ * @brief Carregamento assíncrono de assets.
+ *
+ * A parte de CPU (leitura de arquivo, Assimp, decodificação de imagens) roda
+ * no JobSystem. A parte de GPU fica numa fila que a thread principal drena
+ * com ProcessUploads(), respeitando um orçamento de tempo por frame.
+ */
+class AssetLoader {
+public:
+    // Um passo de upload. Retorna true quando terminou; false para ser chamado de novo.
+    using UploadStep = std::function<bool()>;
+
+private:
+    JobSystem& jobs;
+    std::deque<UploadStep> pendingUploads;
+    std::mutex uploadMutex;
+    std::atomic<int> inFlight{ 0 };
+
+    // Decrementa inFlight ao sair do job, inclusive por exceção (senão WaitAll nunca termina)
+    struct InFlightGuard {
+        std::atomic<int>& counter;
+        ~InFlightGuard() { counter--; }
+    };
+
+    void enqueueUpload(UploadStep step) {
+        std::lock_guard<std::mutex> lock(uploadMutex);
+        pendingUploads.push_back(std::move(step));
+    }
+
+    // Texto da exceção em tratamento; só pode ser chamada dentro de um catch
+    static std::string exceptionMessage() {
+        try {
+            throw;
+        } catch (const std::exception& e) {
+            return e.what();
+        } catch (...) {
+            return "exceção desconhecida";
+        }
+    }
+
+public:
+    explicit AssetLoader(JobSystem& jobSystem = JobSystem::GetInstance()) : jobs(jobSystem) {}
+
+    ~AssetLoader() {
+        // Os jobs capturam this: espera a parte de CPU terminar antes de destruir a fila
+        while (inFlight.load() > 0) {
+            if (!jobs.RunPendingJob()) std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Executa cpuWork num worker e, depois, gpuWork na thread principal.
+     * O resultado de cpuWork é passado para gpuWork. Se cpuWork lançar, gpuWork
+     * não roda e onFailure (opcional) é chamado no worker.
+     */
+    template <typename CpuFn, typename GpuFn>
+    void Submit(CpuFn cpuWork, GpuFn gpuWork, std::function<void()> onFailure = nullptr) {
+        using Result = typename std::invoke_result<CpuFn>::type;
+
+        inFlight++;
+        jobs.Submit([this, cpuWork = std::move(cpuWork), gpuWork = std::move(gpuWork),
+                     onFailure = std::move(onFailure)]() mutable {
+            InFlightGuard guard{ inFlight };
+            try {
+                auto result = std::make_shared<Result>(cpuWork());
+                enqueueUpload([result, gpuWork = std::move(gpuWork)]() mutable {
+                    gpuWork(*result);
+                    return true;
+                });
+            } catch (...) {
+                std::cerr << "[AssetLoader] Job falhou: " << exceptionMessage() << std::endl;
+                if (onFailure) onFailure();
+            }
+        });
+    }
+
+    AssetHandle<Model> LoadModelAsync(const std::string& path,
+                                      const ModelLoadOptions& options = ModelLoadOptions()) {
+        auto state = std::make_shared<AssetHandle<Model>::State>();
+
+        inFlight++;
+        jobs.Submit([this, state, path, options]() {
+            InFlightGuard guard{ inFlight };
+            try {
+                auto data = Model::Import(path, options);
+                if (!data->valid) {
+                    state->status = AssetStatus::Failed;
+                    return;
+                }
+
+                // O Uploader não toca em OpenGL até o primeiro Step()
+                auto model = std::make_shared<Model>();
+                auto uploader = std::make_shared<Model::Uploader>(data, *model, options);
+                enqueueUpload([state, model, uploader]() {
+                    if (!uploader->Step()) return false;
+                    state->asset = model;
+                    state->status = AssetStatus::Ready;
+                    return true;
+                });
+            } catch (...) {
+                std::cerr << "[AssetLoader] Falha ao importar " << path << ": " << exceptionMessage() << std::endl;
+                state->status = AssetStatus::Failed;
+            }
+        });
+
+        return AssetHandle<Model>(state);
+    }
+
+    AssetHandle<Texture> LoadTextureAsync(const std::string& path, TextureType type,
+                                          const TextureParams& params = TextureParams()) {
+        auto state = std::make_shared<AssetHandle<Texture>::State>();
+
+        if (auto cached = TextureManager::GetInstance().Find(path)) {
+            state->asset = cached;
+            state->status = AssetStatus::Ready;
+            return AssetHandle<Texture>(state);
+        }
+
+        Submit(
+            [path, params]() {
+                ImageData image;
+                Texture::DecodeFile(path, params.flipVertically, image);
+                return image;
+            },
+            [state, path, type, params](const ImageData& image) {
+                if (!image.IsValid()) {
+                    std::cerr << "Falha ao carregar textura: " << path << std::endl;
+                    state->status = AssetStatus::Failed;
+                    return;
+                }
+                state->asset = TextureManager::GetInstance().LoadTexture(path, image, type, params);
+                state->status = state->asset ? AssetStatus::Ready : AssetStatus::Failed;
+            },
+            [state]() { state->status = AssetStatus::Failed; });
+
+        return AssetHandle<Texture>(state);
+    }
+
+    /**
+     * @brief Executa passos de upload pendentes até esgotar o orçamento.
+     * Deve ser chamado uma vez por frame na thread do contexto OpenGL.
+     * Pelo menos um passo é executado por chamada para garantir progresso.
+     */
+    void ProcessUploads(double budgetMs = 2.0) {
+        auto start = std::chrono::steady_clock::now();
+
+        while (true) {
+            UploadStep step;
+            {
+                std::lock_guard<std::mutex> lock(uploadMutex);
+                if (pendingUploads.empty()) return;
+                step = std::move(pendingUploads.front());
+                pendingUploads.pop_front();
+            }
+
+            if (!step()) {
+                // Ainda não terminou: volta para a frente da fila para manter a ordem
+                std::lock_guard<std::mutex> lock(uploadMutex);
+                pendingUploads.push_front(std::move(step));
+            }
+
+            double elapsed = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+            if (elapsed >= budgetMs) return;
+        }
+    }
+
+    bool IsIdle() {
+        std::lock_guard<std::mutex> lock(uploadMutex);
+        return inFlight.load() == 0 && pendingUploads.empty();
+    }
+
+    // Bloqueia até todos os assets pendentes estarem na GPU
+    void WaitAll() {
+        while (!IsIdle()) {
+            ProcessUploads(1000.0);
+            if (inFlight.load() > 0 && !jobs.RunPendingJob()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+};
+
+#endif // ASSET_LOADER_HPP
@@ -0,0 +1,102 @@
+#ifndef BOUNDS_HPP
+#define BOUNDS_HPP
+
+#include <glm/glm.hpp>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief Caixa alinhada aos eixos. Começa vazia (min > max).
+ */
+struct AABB {
+    glm::vec3 min = glm::vec3(FLT_MAX);
+    glm::vec3 max = glm::vec3(-FLT_MAX);
+
+    AABB() = default;
+    AABB(const glm::vec3& minPoint, const glm::vec3& maxPoint) : min(minPoint), max(maxPoint) {}
+
+    bool IsValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+    void Expand(const glm::vec3& point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void Expand(const AABB& other) {
+        if (!other.IsValid()) return;
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    glm::vec3 GetCenter() const { return (min + max) * 0.5f; }
+    glm::vec3 GetExtents() const { return (max - min) * 0.5f; }
+
+    float GetSurfaceArea() const {
+        glm::vec3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    bool Contains(const AABB& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+               max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+    }
+
+    bool Overlaps(const AABB& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    /**
+     * @brief Teste de raio contra a caixa (slabs).
+     * @param invDir 1 / direção do raio, calculado uma vez por raio
+     * @param tHit distância de entrada (0 se a origem está dentro)
+     */
+    bool IntersectsRay(const glm::vec3& origin, const glm::vec3& invDir, float maxDistance, float& tHit) const {
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+        for (int axis = 0; axis < 3; axis++) {
+            float t1 = (min[axis] - origin[axis]) * invDir[axis];
+            float t2 = (max[axis] - origin[axis]) * invDir[axis];
+            if (t1 > t2) std::swap(t1, t2);
+            // NaN (origem no plano com direção 0 no eixo) cai fora das comparações e não restringe
+            if (t1 > tMin) tMin = t1;
+            if (t2 < tMax) tMax = t2;
+            if (tMin > tMax) return false;
+        }
+        tHit = tMin;
+        return true;
+    }
+
+    static AABB Merge(const AABB& a, const AABB& b) {
+        return AABB(glm::min(a.min, b.min), glm::max(a.max, b.max));
+    }
+
+    // Caixa que envolve esta caixa depois de transformada (Arvo)
+    AABB Transformed(const glm::mat4& m) const {
+        if (!IsValid()) return AABB();
+
+        glm::vec3 center = glm::vec3(m * glm::vec4(GetCenter(), 1.0f));
+        glm::vec3 extents = GetExtents();
+        glm::vec3 newExtents(0.0f);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                newExtents[i] += std::fabs(m[j][i]) * extents[j];
+            }
+        }
+        return AABB(center - newExtents, center + newExtents);
+    }
+
+    template <typename VertexT>
+    static AABB FromVertices(const VertexT* vertices, size_t count) {
+        AABB box;
+        for (size_t i = 0; i < count; i++) {
+            box.Expand(vertices[i].Position);
+        }
+        return box;
+    }
+};
+
+#endif // BOUNDS_HPP
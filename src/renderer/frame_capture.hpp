@@ -0,0 +1,264 @@
+#ifndef FRAME_CAPTURE_HPP
+#define FRAME_CAPTURE_HPP
+
+#include <GL/glew.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gl_state.hpp"
+
+// Layout dos bytes lidos: RGBA8 (imagem final) ou RGB float (cor HDR da cena)
+enum class CaptureFormat {
+    RGBA8,
+    RGB32F
+};
+
+struct CapturedFrame {
+    std::vector<uint8_t> pixels; // Linhas de baixo para cima, como o glReadPixels
+    int width = 0;
+    int height = 0;
+    CaptureFormat format = CaptureFormat::RGBA8;
+};
+
+/**
+ * @brief Leitura assíncrona de framebuffers com um anel de pixel pack buffers.
+ *
+ * Capture() só enfileira o glReadPixels para um PBO e coloca uma fence; a
+ * cópia acontece na GPU enquanto os próximos frames são desenhados. Com
+ * SlotCount = 3, o frame N é mapeado quando o N+2 é capturado (ou antes, se a
+ * fence já passou). Os bytes mapeados são copiados e entregues a uma thread de
+ * codificação própria, na mesma ordem das capturas: o callback pode gravar num
+ * pipe sem reordenar. A fila da thread é limitada (MaxPendingFrames) para que
+ * um encoder lento segure o render em vez de acumular memória.
+ *
+ * Capture/Poll/Flush na thread do contexto; o callback roda na thread de codificação.
+ */
+class FrameCapture {
+public:
+    static constexpr int SlotCount = 3;
+    static constexpr size_t MaxPendingFrames = 8;
+
+    using EncodeFn = std::function<void(const CapturedFrame&)>;
+
+    struct Stats {
+        uint32_t captures = 0;      // Frames enfileirados
+        uint32_t fenceWaits = 0;    // Vezes em que o anel estava cheio e o CPU esperou a GPU
+        double fenceWaitMs = 0.0;
+        uint32_t encoderWaits = 0;  // Vezes em que a fila de codificação estava cheia
+        double encoderWaitMs = 0.0;
+
+        void Print() const {
+            std::cout << "[FrameCapture] " << captures << " capturas, " << fenceWaits << " esperas da GPU ("
+                      << fenceWaitMs << " ms), " << encoderWaits << " esperas do encoder (" << encoderWaitMs
+                      << " ms)" << std::endl;
+        }
+    };
+
+private:
+    struct Slot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        int width = 0;
+        int height = 0;
+        EncodeFn encode;
+    };
+
+    struct EncodeTask {
+        CapturedFrame frame;
+        EncodeFn encode;
+    };
+
+    Slot slots[SlotCount];
+    int next = 0;    // Próximo slot a receber uma captura
+    int oldest = 0;  // Captura mais antiga ainda na GPU
+    int inFlight = 0;
+    size_t slotBytes = 0;
+    CaptureFormat format = CaptureFormat::RGBA8;
+
+    std::thread encoder;
+    std::deque<EncodeTask> tasks;
+    std::mutex mutex;
+    std::condition_variable taskReady;
+    std::condition_variable taskDone;
+    bool encoding = false; // A thread está no meio de um callback
+    bool stopping = false;
+
+    Stats stats;
+
+    size_t bytesPerPixel() const { return format == CaptureFormat::RGBA8 ? 4 : 3 * sizeof(float); }
+
+    void encoderLoop() {
+        while (true) {
+            EncodeTask task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                taskReady.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+                encoding = true;
+            }
+            taskDone.notify_all();
+
+            if (task.encode) task.encode(task.frame);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                encoding = false;
+            }
+            taskDone.notify_all();
+        }
+    }
+
+    // Copia o PBO do slot mais antigo e passa para o encoder. wait = false só coleta se a fence já passou
+    bool collectOldest(bool wait) {
+        if (inFlight == 0) return false;
+        Slot& slot = slots[oldest];
+
+        GLenum result = glClientWaitSync(slot.fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            if (!wait) return false;
+            auto start = std::chrono::steady_clock::now();
+            stats.fenceWaits++;
+            do {
+                result = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+            } while (result == GL_TIMEOUT_EXPIRED);
+            stats.fenceWaitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+
+        EncodeTask task;
+        task.frame.width = slot.width;
+        task.frame.height = slot.height;
+        task.frame.format = format;
+        task.encode = std::move(slot.encode);
+        size_t bytes = static_cast<size_t>(slot.width) * slot.height * bytesPerPixel();
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        if (const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_READ_BIT)) {
+            task.frame.pixels.resize(bytes);
+            std::memcpy(task.frame.pixels.data(), mapped, bytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        } else {
+            std::cerr << "[FrameCapture] glMapBufferRange falhou; frame descartado" << std::endl;
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        oldest = (oldest + 1) % SlotCount;
+        inFlight--;
+
+        if (!task.frame.pixels.empty()) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (tasks.size() >= MaxPendingFrames) {
+                auto start = std::chrono::steady_clock::now();
+                stats.encoderWaits++;
+                taskDone.wait(lock, [this]() { return tasks.size() < MaxPendingFrames; });
+                stats.encoderWaitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+            tasks.push_back(std::move(task));
+            lock.unlock();
+            taskReady.notify_one();
+        }
+        return true;
+    }
+
+    void release() {
+        for (auto& slot : slots) {
+            if (slot.fence) glDeleteSync(slot.fence);
+            if (slot.pbo) glDeleteBuffers(1, &slot.pbo);
+            slot = Slot();
+        }
+        inFlight = 0;
+        next = oldest = 0;
+        slotBytes = 0;
+    }
+
+public:
+    FrameCapture() = default;
+
+    ~FrameCapture() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        taskReady.notify_all();
+        if (encoder.joinable()) encoder.join();
+        // Os PBOs pertencem ao contexto; quem destrói depois dele só perde os frames em voo
+        release();
+    }
+
+    bool Init(CaptureFormat captureFormat) {
+        if (encoder.joinable()) return true;
+        format = captureFormat;
+        encoder = std::thread([this]() { encoderLoop(); });
+        return true;
+    }
+
+    /**
+     * @brief Enfileira a leitura do color attachment 0 de framebuffer.
+     * encode recebe os bytes na thread de codificação, na ordem das capturas.
+     */
+    void Capture(GLuint framebuffer, int width, int height, EncodeFn encode) {
+        if (!encoder.joinable()) return;
+
+        // Coleta o que já terminou e, com o anel cheio, espera o mais antigo
+        while (collectOldest(false)) {}
+        if (inFlight == SlotCount) collectOldest(true);
+
+        size_t bytes = static_cast<size_t>(width) * height * bytesPerPixel();
+        if (bytes > slotBytes) {
+            Flush();
+            for (auto& slot : slots) {
+                if (!slot.pbo) glGenBuffers(1, &slot.pbo);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+                glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+            }
+            slotBytes = bytes;
+        }
+
+        Slot& slot = slots[next];
+        slot.width = width;
+        slot.height = height;
+        slot.encode = std::move(encode);
+
+        GLState::GetInstance().BindFramebuffer(framebuffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        if (format == CaptureFormat::RGBA8) glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        else glReadPixels(0, 0, width, height, GL_RGB, GL_FLOAT, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        next = (next + 1) % SlotCount;
+        inFlight++;
+        stats.captures++;
+    }
+
+    // Entrega ao encoder as capturas cujas fences já passaram, sem bloquear
+    void Poll() {
+        while (collectOldest(false)) {}
+    }
+
+    // Espera todas as capturas chegarem à CPU e o encoder esvaziar a fila
+    void Flush() {
+        while (collectOldest(true)) {}
+        std::unique_lock<std::mutex> lock(mutex);
+        taskDone.wait(lock, [this]() { return tasks.empty() && !encoding; });
+    }
+
+    const Stats& GetStats() const { return stats; }
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+};
+
+#endif // FRAME_CAPTURE_HPP
@@ -3,6 +3,7 @@
 
 #include <GL/glew.h>
 #include <iostream>
+#include "gl_state.hpp"
 
 class FrameBuffer
 {
@@ -12,12 +13,13 @@ private:
     unsigned int rbo;
     int width;
     int height;
+    GLenum colorFormat; // GL_RGB16F para a cena (HDR); GL_RGBA8 para a saída que vai para disco
     bool initialized;
 
 public:
-    FrameBuffer(int w = 800, int h = 600) 
+    FrameBuffer(int w = 800, int h = 600, GLenum format = GL_RGB16F) 
         : framebuffer(0), textureColorbuffer(0), rbo(0), 
-          width(w), height(h), initialized(false) {
+          width(w), height(h), colorFormat(format), initialized(false) {
     }
 
     ~FrameBuffer() {
@@ -32,12 +34,12 @@ public:
 
         // Create Framebuffer
         glGenFramebuffers(1, &framebuffer);
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        GLState::GetInstance().BindFramebuffer(framebuffer);
 
         // Create texturo to the framebuffer
         glGenTextures(1, &textureColorbuffer);
-        glBindTexture(GL_TEXTURE_2D, textureColorbuffer);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        GLState::GetInstance().BindTexture(GL_TEXTURE_2D, textureColorbuffer);
+        glTexImage2D(GL_TEXTURE_2D, 0, colorFormat, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureColorbuffer, 0);
@@ -51,11 +53,11 @@ public:
         // Check if framebuffer is complete
         if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
             std::cerr << "Erro: Framebuffer não está completo!" << std::endl;
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            GLState::GetInstance().BindFramebuffer(0);
             return false;
         }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::GetInstance().BindFramebuffer(0);
         initialized = true;
         
         std::cout << "Framebuffer initialized successfully (" << width << "x" << height << ")" << std::endl;
@@ -67,13 +69,14 @@ public:
             std::cerr << "Error: Trying to use uninitialized framebuffer!" << std::endl;
             return;
         }
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-        glEnable(GL_DEPTH_TEST);
-        glViewport(0, 0, width, height);
+        GLState& gl = GLState::GetInstance();
+        gl.BindFramebuffer(framebuffer);
+        gl.SetEnabled(GL_DEPTH_TEST, true);
+        gl.SetViewport(0, 0, width, height);
     }
 
     void Unbind() {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::GetInstance().BindFramebuffer(0);
     }
 
     void Resize(int w, int h) {
@@ -83,8 +86,8 @@ public:
         height = h;
         
         // Resize texture
-        glBindTexture(GL_TEXTURE_2D, textureColorbuffer);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        GLState::GetInstance().BindTexture(GL_TEXTURE_2D, textureColorbuffer);
+        glTexImage2D(GL_TEXTURE_2D, 0, colorFormat, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
         
         // Resize renderbuffer
         glBindRenderbuffer(GL_RENDERBUFFER, rbo);
@@ -93,6 +96,9 @@ public:
         std::cout << "Framebuffer resized to " << width << "x" << height << std::endl;
     }
 
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
     unsigned int GetTexture() const {
         return textureColorbuffer;
     }
@@ -103,6 +109,8 @@ public:
 
     void Cleanup() {
         if (initialized) {
+            GLState::GetInstance().ForgetFramebuffer(framebuffer);
+            GLState::GetInstance().ForgetTexture(textureColorbuffer);
             glDeleteFramebuffers(1, &framebuffer);
             glDeleteTextures(1, &textureColorbuffer);
             glDeleteRenderbuffers(1, &rbo);
@@ -122,6 +130,7 @@ public:
           rbo(other.rbo),
           width(other.width),
           height(other.height),
+          colorFormat(other.colorFormat),
           initialized(other.initialized) {
         other.initialized = false;
     }
@@ -134,6 +143,7 @@ public:
             rbo = other.rbo;
             width = other.width;
             height = other.height;
+            colorFormat = other.colorFormat;
             initialized = other.initialized;
             other.initialized = false;
         }
@@ -0,0 +1,209 @@
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+
+#include <glm/glm.hpp>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FRUSTUM_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_SSE 1
+#endif
+
+#include "bounds.hpp"
+
+/**
+ * @brief Os 6 planos do frustum extraídos de uma matriz view-projection
+ * (Gribb/Hartmann). Um ponto p está dentro quando dot(plane.xyz, p) + plane.w >= 0.
+ */
+struct Frustum {
+    enum Plane { Left = 0, Right, Bottom, Top, Near, Far, Count };
+
+    glm::vec4 planes[Count];
+
+    static Frustum FromMatrix(const glm::mat4& viewProj) {
+        // Linhas da matriz (glm é column-major: m[coluna][linha])
+        glm::vec4 row0(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+        glm::vec4 row1(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+        glm::vec4 row2(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+        glm::vec4 row3(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+
+        Frustum f;
+        f.planes[Left]   = row3 + row0;
+        f.planes[Right]  = row3 - row0;
+        f.planes[Bottom] = row3 + row1;
+        f.planes[Top]    = row3 - row1;
+        f.planes[Near]   = row3 + row2; // Clip space do OpenGL: -w <= z <= w
+        f.planes[Far]    = row3 - row2;
+
+        for (auto& plane : f.planes) {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f) plane = plane * (1.0f / length);
+        }
+        return f;
+    }
+
+    enum class Result { Outside, Intersects, Inside };
+
+    // Como Intersects, mas diz se a caixa está inteira dentro (para aceitar subárvores sem testar)
+    Result Classify(const AABB& box) const {
+        if (!box.IsValid()) return Result::Intersects;
+        glm::vec3 center = box.GetCenter();
+        glm::vec3 extents = box.GetExtents();
+        Result result = Result::Inside;
+        for (const auto& plane : planes) {
+            float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+            float radius = std::fabs(plane.x) * extents.x + std::fabs(plane.y) * extents.y + std::fabs(plane.z) * extents.z;
+            if (distance + radius < 0.0f) return Result::Outside;
+            if (distance - radius < 0.0f) result = Result::Intersects;
+        }
+        return result;
+    }
+
+    bool Intersects(const AABB& box) const {
+        if (!box.IsValid()) return true;
+        glm::vec3 center = box.GetCenter();
+        glm::vec3 extents = box.GetExtents();
+        for (const auto& plane : planes) {
+            float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+            float radius = std::fabs(plane.x) * extents.x + std::fabs(plane.y) * extents.y + std::fabs(plane.z) * extents.z;
+            if (distance + radius < 0.0f) return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Teste de visibilidade em lote contra um Frustum.
+ *
+ * As caixas ficam em SoA (centro e extensão por eixo em arrays separados).
+ * Cull testa 8 caixas por vez com AVX2 (-mavx2 ou ENABLE_AVX2 no CMake) ou 4
+ * com SSE, acumulando a máscara dos 6 planos em registrador; o resto (e
+ * plataformas sem SSE) passa pelo laço escalar. O GCC não vetoriza a versão
+ * escalar sozinho em -O2, por isso os intrínsecos explícitos.
+ */
+class FrustumCuller {
+private:
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+    std::vector<uint8_t> visible;
+
+public:
+    void Clear() {
+        centerX.clear(); centerY.clear(); centerZ.clear();
+        extentX.clear(); extentY.clear(); extentZ.clear();
+        visible.clear();
+    }
+
+    void Reserve(size_t count) {
+        centerX.reserve(count); centerY.reserve(count); centerZ.reserve(count);
+        extentX.reserve(count); extentY.reserve(count); extentZ.reserve(count);
+        visible.reserve(count);
+    }
+
+    // Retorna o índice da caixa. Caixas inválidas (mesh sem bounds) são sempre visíveis.
+    size_t Add(const AABB& box) {
+        glm::vec3 center(0.0f);
+        glm::vec3 extents(FLT_MAX);
+        if (box.IsValid()) {
+            center = box.GetCenter();
+            extents = box.GetExtents();
+        }
+        centerX.push_back(center.x); centerY.push_back(center.y); centerZ.push_back(center.z);
+        extentX.push_back(extents.x); extentY.push_back(extents.y); extentZ.push_back(extents.z);
+        visible.push_back(1);
+        return visible.size() - 1;
+    }
+
+    size_t GetCount() const { return visible.size(); }
+
+    // Marca cada caixa como visível ou não e retorna quantas são visíveis
+    size_t Cull(const Frustum& frustum) {
+        const size_t count = visible.size();
+        const float* cx = centerX.data();
+        const float* cy = centerY.data();
+        const float* cz = centerZ.data();
+        const float* ex = extentX.data();
+        const float* ey = extentY.data();
+        const float* ez = extentZ.data();
+        uint8_t* out = visible.data();
+
+        float px[Frustum::Count], py[Frustum::Count], pz[Frustum::Count], pw[Frustum::Count];
+        float ax[Frustum::Count], ay[Frustum::Count], az[Frustum::Count];
+        for (int p = 0; p < Frustum::Count; p++) {
+            const glm::vec4& plane = frustum.planes[p];
+            px[p] = plane.x; py[p] = plane.y; pz[p] = plane.z; pw[p] = plane.w;
+            ax[p] = std::fabs(plane.x); ay[p] = std::fabs(plane.y); az[p] = std::fabs(plane.z);
+        }
+
+        size_t i = 0;
+        size_t visibleCount = 0;
+#if defined(FRUSTUM_AVX2)
+        const __m256 zero = _mm256_setzero_ps();
+        for (; i + 8 <= count; i += 8) {
+            __m256 vcx = _mm256_loadu_ps(cx + i), vcy = _mm256_loadu_ps(cy + i), vcz = _mm256_loadu_ps(cz + i);
+            __m256 vex = _mm256_loadu_ps(ex + i), vey = _mm256_loadu_ps(ey + i), vez = _mm256_loadu_ps(ez + i);
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (int p = 0; p < Frustum::Count; p++) {
+                __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(vcx, _mm256_set1_ps(px[p])), _mm256_mul_ps(vcy, _mm256_set1_ps(py[p]))),
+                    _mm256_add_ps(_mm256_mul_ps(vcz, _mm256_set1_ps(pz[p])), _mm256_set1_ps(pw[p])));
+                __m256 radius = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(vex, _mm256_set1_ps(ax[p])), _mm256_mul_ps(vey, _mm256_set1_ps(ay[p]))),
+                    _mm256_mul_ps(vez, _mm256_set1_ps(az[p])));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+            }
+            unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(inside));
+            for (int lane = 0; lane < 8; lane++) {
+                uint8_t bit = static_cast<uint8_t>((mask >> lane) & 1u);
+                out[i + lane] = bit;
+                visibleCount += bit;
+            }
+        }
+#elif defined(FRUSTUM_SSE)
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) {
+            __m128 vcx = _mm_loadu_ps(cx + i), vcy = _mm_loadu_ps(cy + i), vcz = _mm_loadu_ps(cz + i);
+            __m128 vex = _mm_loadu_ps(ex + i), vey = _mm_loadu_ps(ey + i), vez = _mm_loadu_ps(ez + i);
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int p = 0; p < Frustum::Count; p++) {
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(vcx, _mm_set1_ps(px[p])), _mm_mul_ps(vcy, _mm_set1_ps(py[p]))),
+                    _mm_add_ps(_mm_mul_ps(vcz, _mm_set1_ps(pz[p])), _mm_set1_ps(pw[p])));
+                __m128 radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(vex, _mm_set1_ps(ax[p])), _mm_mul_ps(vey, _mm_set1_ps(ay[p]))),
+                    _mm_mul_ps(vez, _mm_set1_ps(az[p])));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+            }
+            unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(inside));
+            for (int lane = 0; lane < 4; lane++) {
+                uint8_t bit = static_cast<uint8_t>((mask >> lane) & 1u);
+                out[i + lane] = bit;
+                visibleCount += bit;
+            }
+        }
+#endif
+        // Resto que não fecha um bloco (ou tudo, sem SSE)
+        for (; i < count; i++) {
+            bool inside = true;
+            for (int p = 0; p < Frustum::Count; p++) {
+                float distance = px[p] * cx[i] + py[p] * cy[i] + pz[p] * cz[i] + pw[p];
+                float radius = ax[p] * ex[i] + ay[p] * ey[i] + az[p] * ez[i];
+                inside &= distance + radius >= 0.0f;
+            }
+            out[i] = static_cast<uint8_t>(inside);
+            visibleCount += inside;
+        }
+        return visibleCount;
+    }
+
+    bool IsVisible(size_t index) const { return visible[index] != 0; }
+};
+
+#endif // FRUSTUM_HPP
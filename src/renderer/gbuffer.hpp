@@ -0,0 +1,159 @@
+#ifndef GBUFFER_HPP
+#define GBUFFER_HPP
+
+#include <GL/glew.h>
+#include <iostream>
+#include "gl_state.hpp"
+
+/**
+ * @brief Framebuffer com vários alvos para o caminho deferred.
+ *
+ * O passe de geometria (pbr.frag com GBUFFER) grava o material de cada pixel
+ * visível e o passe de luz (deferred_lighting.frag) lê tudo em tela cheia:
+ *   0: RGBA8   sqrt(albedo), metallic
+ *   1: RGBA16F normal em mundo, roughness
+ *   2: RGBA16F emissão, ao
+ *   profundidade: DEPTH24_STENCIL8 em textura (a posição é reconstruída dela)
+ * O formato da profundidade é o mesmo do FrameBuffer, então BlitDepth copia
+ * para ele e o skybox continua testando contra a cena.
+ */
+class GBuffer
+{
+public:
+    enum Target { AlbedoMetallic = 0, NormalRoughness, EmissionAO, TargetCount };
+
+private:
+    unsigned int framebuffer = 0;
+    unsigned int colorTextures[TargetCount] = {};
+    unsigned int depthTexture = 0;
+    int width = 0;
+    int height = 0;
+    bool initialized = false;
+
+    static void allocateColor(unsigned int texture, GLint internalFormat, int w, int h) {
+        GLState::GetInstance().BindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    }
+
+    void allocate() {
+        allocateColor(colorTextures[AlbedoMetallic], GL_RGBA8, width, height);
+        allocateColor(colorTextures[NormalRoughness], GL_RGBA16F, width, height);
+        allocateColor(colorTextures[EmissionAO], GL_RGBA16F, width, height);
+
+        GLState::GetInstance().BindTexture(GL_TEXTURE_2D, depthTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0,
+                     GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+    }
+
+public:
+    GBuffer() = default;
+
+    ~GBuffer() {
+        Cleanup();
+    }
+
+    bool Init(int w, int h) {
+        if (initialized) {
+            std::cerr << "G-buffer já foi inicializado!" << std::endl;
+            return false;
+        }
+        width = w;
+        height = h;
+
+        glGenFramebuffers(1, &framebuffer);
+        GLState& gl = GLState::GetInstance();
+        gl.BindFramebuffer(framebuffer);
+
+        glGenTextures(TargetCount, colorTextures);
+        glGenTextures(1, &depthTexture);
+        allocate();
+
+        // Leitura 1:1 no passe de luz: sem filtro nem mipmaps
+        for (int i = 0; i < TargetCount; i++) {
+            gl.BindTexture(GL_TEXTURE_2D, colorTextures[i]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, colorTextures[i], 0);
+        }
+        gl.BindTexture(GL_TEXTURE_2D, depthTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+
+        const GLenum drawBuffers[TargetCount] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
+        glDrawBuffers(TargetCount, drawBuffers);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Erro: G-buffer não está completo!" << std::endl;
+            gl.BindFramebuffer(0);
+            initialized = true; // Cleanup libera o que foi criado
+            Cleanup();
+            return false;
+        }
+
+        gl.BindFramebuffer(0);
+        initialized = true;
+
+        std::cout << "G-buffer initialized successfully (" << width << "x" << height << ")" << std::endl;
+        return true;
+    }
+
+    // Liga para o passe de geometria e limpa cor e profundidade
+    void Bind() {
+        if (!initialized) {
+            std::cerr << "Error: Trying to use uninitialized G-buffer!" << std::endl;
+            return;
+        }
+        GLState& gl = GLState::GetInstance();
+        gl.BindFramebuffer(framebuffer);
+        gl.SetEnabled(GL_DEPTH_TEST, true);
+        gl.SetViewport(0, 0, width, height);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+
+    // Texturas nas unidades first..first+3 (albedo, normal, emissão, profundidade)
+    void BindTextures(unsigned int first) const {
+        GLState& gl = GLState::GetInstance();
+        for (int i = 0; i < TargetCount; i++) {
+            gl.BindTexture(first + i, GL_TEXTURE_2D, colorTextures[i]);
+        }
+        gl.BindTexture(first + TargetCount, GL_TEXTURE_2D, depthTexture);
+    }
+
+    // Copia a profundidade para o framebuffer de destino (que precisa ter o mesmo tamanho)
+    void BlitDepth(unsigned int target) const {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, target);
+    }
+
+    void Resize(int w, int h) {
+        if (!initialized || (w == width && h == height)) return;
+        width = w;
+        height = h;
+        allocate();
+    }
+
+    bool IsInitialized() const { return initialized; }
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+    void Cleanup() {
+        if (!initialized) return;
+        GLState& gl = GLState::GetInstance();
+        gl.ForgetFramebuffer(framebuffer);
+        for (unsigned int texture : colorTextures) gl.ForgetTexture(texture);
+        gl.ForgetTexture(depthTexture);
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteTextures(TargetCount, colorTextures);
+        glDeleteTextures(1, &depthTexture);
+        initialized = false;
+    }
+
+    GBuffer(const GBuffer&) = delete;
+    GBuffer& operator=(const GBuffer&) = delete;
+};
+
+#endif // GBUFFER_HPP
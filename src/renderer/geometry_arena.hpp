@@ -0,0 +1,333 @@
+#ifndef GEOMETRY_ARENA_HPP
+#define GEOMETRY_ARENA_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "vertex_format.hpp"
+#include "gl_state.hpp"
+
+/**
+ * @brief Faixas livres de um buffer em unidades de elemento (vértices ou índices).
+ * First-fit com fusão de vizinhos na liberação.
+ */
+class RangeAllocator {
+private:
+    struct Range {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    std::vector<Range> freeRanges; // Ordenadas por offset
+    uint32_t capacity = 0;
+    uint32_t used = 0;
+
+public:
+    static constexpr uint32_t Invalid = 0xFFFFFFFFu;
+
+    explicit RangeAllocator(uint32_t initialCapacity = 0) { Grow(initialCapacity); }
+
+    uint32_t Allocate(uint32_t count) {
+        if (count == 0) return Invalid;
+        for (size_t i = 0; i < freeRanges.size(); i++) {
+            Range& range = freeRanges[i];
+            if (range.count < count) continue;
+            uint32_t offset = range.offset;
+            range.offset += count;
+            range.count -= count;
+            if (range.count == 0) freeRanges.erase(freeRanges.begin() + i);
+            used += count;
+            return offset;
+        }
+        return Invalid;
+    }
+
+    void Free(uint32_t offset, uint32_t count) {
+        if (count == 0) return;
+        used -= count;
+
+        size_t i = 0;
+        while (i < freeRanges.size() && freeRanges[i].offset < offset) i++;
+        freeRanges.insert(freeRanges.begin() + i, Range{ offset, count });
+
+        // Funde com o seguinte e com o anterior
+        if (i + 1 < freeRanges.size() && freeRanges[i].offset + freeRanges[i].count == freeRanges[i + 1].offset) {
+            freeRanges[i].count += freeRanges[i + 1].count;
+            freeRanges.erase(freeRanges.begin() + i + 1);
+        }
+        if (i > 0 && freeRanges[i - 1].offset + freeRanges[i - 1].count == freeRanges[i].offset) {
+            freeRanges[i - 1].count += freeRanges[i].count;
+            freeRanges.erase(freeRanges.begin() + i);
+        }
+    }
+
+    // Acrescenta [capacity, newCapacity) como espaço livre
+    void Grow(uint32_t newCapacity) {
+        if (newCapacity <= capacity) return;
+        uint32_t added = newCapacity - capacity;
+        if (!freeRanges.empty() && freeRanges.back().offset + freeRanges.back().count == capacity) {
+            freeRanges.back().count += added;
+        } else {
+            freeRanges.push_back(Range{ capacity, added });
+        }
+        capacity = newCapacity;
+    }
+
+    uint32_t GetCapacity() const { return capacity; }
+    uint32_t GetUsed() const { return used; }
+    size_t GetFreeRangeCount() const { return freeRanges.size(); }
+};
+
+/**
+ * @brief Buffers de geometria compartilhados: as meshes subalocam faixas de
+ * poucos VBO/EBO grandes em vez de ter cada uma o seu trio VAO/VBO/EBO.
+ *
+ * Há um pool por formato de vértice e largura de índice, cada um com um único
+ * VAO, de modo que meshes diferentes são desenhadas sem trocar de VAO (base
+ * vertex + first index) e podem ir juntas num glMultiDrawElementsIndirect.
+ * Os buffers crescem em potências de 2 copiando o conteúdo na GPU
+ * (glCopyBufferSubData); offsets já entregues continuam válidos.
+ *
+ * Desligado por padrão: só meshes criadas com o arena ligado (SetEnabled) usam.
+ * Como todo upload de mesh, só pode ser chamado na thread do contexto OpenGL.
+ */
+class GeometryArena {
+public:
+    // Faixa de uma mesh dentro de um pool
+    struct Allocation {
+        int pool = -1;
+        uint32_t baseVertex = 0;
+        uint32_t firstIndex = 0;
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+
+        bool IsValid() const { return pool >= 0; }
+    };
+
+    struct Pool {
+        VertexFormat format;
+        GLenum indexType;
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        GLuint ebo = 0;
+        RangeAllocator vertices;
+        RangeAllocator indices;
+
+        size_t VertexStride() const { return GetVertexStride(format); }
+        size_t IndexSize() const { return indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t); }
+    };
+
+    struct Stats {
+        size_t pools = 0;
+        size_t allocations = 0;
+        size_t vertexBytesUsed = 0;
+        size_t vertexBytesCapacity = 0;
+        size_t indexBytesUsed = 0;
+        size_t indexBytesCapacity = 0;
+        size_t grows = 0;
+
+        void Print() const {
+            std::cout << "=== Geometry Arena ===" << std::endl;
+            std::cout << "  Pools: " << pools << ", meshes: " << allocations << ", realocações: " << grows << std::endl;
+            std::cout << "  Vértices: " << vertexBytesUsed / 1024.0 << " / " << vertexBytesCapacity / 1024.0 << " KB" << std::endl;
+            std::cout << "  Índices: " << indexBytesUsed / 1024.0 << " / " << indexBytesCapacity / 1024.0 << " KB" << std::endl;
+        }
+    };
+
+private:
+    static constexpr uint32_t InitialVertices = 64 * 1024;
+    static constexpr uint32_t InitialIndices = 256 * 1024;
+
+    bool enabled = false;
+    std::vector<std::unique_ptr<Pool>> pools;
+    size_t allocationCount = 0;
+    size_t growCount = 0;
+
+    GeometryArena() = default;
+
+    // Roda na destruição estática, quando o contexto já não existe: sem chamadas GL (ver Shutdown)
+    ~GeometryArena() = default;
+
+    int findPool(VertexFormat format, GLenum indexType) {
+        for (size_t i = 0; i < pools.size(); i++) {
+            if (pools[i]->format == format && pools[i]->indexType == indexType) return static_cast<int>(i);
+        }
+
+        auto pool = std::make_unique<Pool>();
+        pool->format = format;
+        pool->indexType = indexType;
+        pool->vertices.Grow(InitialVertices);
+        pool->indices.Grow(InitialIndices);
+
+        glGenVertexArrays(1, &pool->vao);
+        glGenBuffers(1, &pool->vbo);
+        glGenBuffers(1, &pool->ebo);
+
+        GLState& gl = GLState::GetInstance();
+        gl.BindVertexArray(pool->vao);
+        glBindBuffer(GL_ARRAY_BUFFER, pool->vbo);
+        glBufferData(GL_ARRAY_BUFFER, InitialVertices * pool->VertexStride(), nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool->ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, InitialIndices * pool->IndexSize(), nullptr, GL_STATIC_DRAW);
+        SetupVertexAttributes(format);
+        gl.BindVertexArray(0);
+
+        pools.push_back(std::move(pool));
+        return static_cast<int>(pools.size() - 1);
+    }
+
+    // Novo buffer com o dobro (ou mais) do tamanho; copia o conteúdo na GPU
+    static GLuint growBuffer(GLuint oldBuffer, size_t oldBytes, size_t newBytes) {
+        GLuint newBuffer = 0;
+        glGenBuffers(1, &newBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newBytes), nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_READ_BUFFER, oldBuffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(oldBytes));
+        glDeleteBuffers(1, &oldBuffer);
+        return newBuffer;
+    }
+
+    static uint32_t grownCapacity(uint32_t capacity, uint32_t needed) {
+        uint64_t size = capacity;
+        while (size < static_cast<uint64_t>(capacity) + needed) size *= 2;
+        return static_cast<uint32_t>(size);
+    }
+
+    void growVertices(Pool& pool, uint32_t needed) {
+        uint32_t oldCapacity = pool.vertices.GetCapacity();
+        uint32_t newCapacity = grownCapacity(oldCapacity, needed);
+        pool.vbo = growBuffer(pool.vbo, oldCapacity * pool.VertexStride(), newCapacity * pool.VertexStride());
+        pool.vertices.Grow(newCapacity);
+
+        // Os atributos do VAO guardam o VBO antigo: reaponta
+        GLState& gl = GLState::GetInstance();
+        gl.BindVertexArray(pool.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, pool.vbo);
+        SetupVertexAttributes(pool.format);
+        gl.BindVertexArray(0);
+        growCount++;
+    }
+
+    void growIndices(Pool& pool, uint32_t needed) {
+        uint32_t oldCapacity = pool.indices.GetCapacity();
+        uint32_t newCapacity = grownCapacity(oldCapacity, needed);
+        pool.ebo = growBuffer(pool.ebo, oldCapacity * pool.IndexSize(), newCapacity * pool.IndexSize());
+        pool.indices.Grow(newCapacity);
+
+        GLState& gl = GLState::GetInstance();
+        gl.BindVertexArray(pool.vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.ebo);
+        gl.BindVertexArray(0);
+        growCount++;
+    }
+
+public:
+    static GeometryArena& GetInstance() {
+        static GeometryArena instance;
+        return instance;
+    }
+
+    // Vale para meshes criadas depois da chamada
+    void SetEnabled(bool value) { enabled = value; }
+    bool IsEnabled() const { return enabled; }
+
+    /**
+     * @brief Reserva e envia os vértices (já no formato do pool) e os índices.
+     * @return Allocation inválida se a mesh não couber nos limites de 32 bits
+     */
+    Allocation Allocate(VertexFormat format, GLenum indexType,
+                        const void* vertexData, uint32_t vertexCount,
+                        const void* indexData, uint32_t indexCount) {
+        Allocation allocation;
+        int poolIndex = findPool(format, indexType);
+        Pool& pool = *pools[poolIndex];
+
+        uint32_t baseVertex = pool.vertices.Allocate(vertexCount);
+        if (baseVertex == RangeAllocator::Invalid) {
+            growVertices(pool, vertexCount);
+            baseVertex = pool.vertices.Allocate(vertexCount);
+        }
+        uint32_t firstIndex = pool.indices.Allocate(indexCount);
+        if (firstIndex == RangeAllocator::Invalid) {
+            growIndices(pool, indexCount);
+            firstIndex = pool.indices.Allocate(indexCount);
+        }
+        if (baseVertex == RangeAllocator::Invalid || firstIndex == RangeAllocator::Invalid) {
+            if (baseVertex != RangeAllocator::Invalid) pool.vertices.Free(baseVertex, vertexCount);
+            if (firstIndex != RangeAllocator::Invalid) pool.indices.Free(firstIndex, indexCount);
+            std::cerr << "GeometryArena: sem espaço para " << vertexCount << " vértices" << std::endl;
+            return allocation;
+        }
+
+        // Sem VAO ligado, o bind do EBO não altera nenhum VAO
+        GLState::GetInstance().BindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, pool.vbo);
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(baseVertex * pool.VertexStride()),
+                        static_cast<GLsizeiptr>(vertexCount * pool.VertexStride()), vertexData);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.ebo);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLintptr>(firstIndex * pool.IndexSize()),
+                        static_cast<GLsizeiptr>(indexCount * pool.IndexSize()), indexData);
+
+        allocation.pool = poolIndex;
+        allocation.baseVertex = baseVertex;
+        allocation.firstIndex = firstIndex;
+        allocation.vertexCount = vertexCount;
+        allocation.indexCount = indexCount;
+        allocationCount++;
+        return allocation;
+    }
+
+    void Free(Allocation& allocation) {
+        if (!allocation.IsValid()) return;
+        Pool& pool = *pools[allocation.pool];
+        pool.vertices.Free(allocation.baseVertex, allocation.vertexCount);
+        pool.indices.Free(allocation.firstIndex, allocation.indexCount);
+        allocation = Allocation();
+        allocationCount--;
+    }
+
+    /**
+     * @brief Apaga os VAOs e buffers dos pools. Chamar com o contexto ainda
+     * corrente (o Application chama antes de destruir a janela). Os pools
+     * continuam existindo para que meshes destruídas depois possam devolver
+     * suas faixas; o arena fica desligado para novas meshes.
+     */
+    void Shutdown() {
+        for (auto& pool : pools) {
+            if (!pool->vao) continue;
+            GLState::GetInstance().ForgetVertexArray(pool->vao);
+            glDeleteVertexArrays(1, &pool->vao);
+            glDeleteBuffers(1, &pool->vbo);
+            glDeleteBuffers(1, &pool->ebo);
+            pool->vao = pool->vbo = pool->ebo = 0;
+        }
+        enabled = false;
+    }
+
+    const Pool& GetPool(int index) const { return *pools[index]; }
+    size_t GetPoolCount() const { return pools.size(); }
+
+    Stats GetStats() const {
+        Stats stats;
+        stats.pools = pools.size();
+        stats.allocations = allocationCount;
+        stats.grows = growCount;
+        for (const auto& pool : pools) {
+            stats.vertexBytesUsed += pool->vertices.GetUsed() * pool->VertexStride();
+            stats.vertexBytesCapacity += pool->vertices.GetCapacity() * pool->VertexStride();
+            stats.indexBytesUsed += pool->indices.GetUsed() * pool->IndexSize();
+            stats.indexBytesCapacity += pool->indices.GetCapacity() * pool->IndexSize();
+        }
+        return stats;
+    }
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+};
+
+#endif // GEOMETRY_ARENA_HPP
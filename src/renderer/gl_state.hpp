@@ -0,0 +1,265 @@
+#ifndef GL_STATE_HPP
+#define GL_STATE_HPP
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <iostream>
+
+/**
+ * @brief Cópia em CPU do estado OpenGL que o renderer mais troca.
+ *
+ * Cada Set/Bind compara com o valor conhecido e só chama o GL se mudou.
+ * Todo bind de programa, VAO, textura, uniform buffer, framebuffer, viewport e das flags de
+ * depth/cull/blend deve passar por aqui; código que mexe no GL diretamente
+ * (ex.: geração do IBL) chama Invalidate() ao terminar. Objetos deletados
+ * precisam de Forget*() para que um id reaproveitado não seja pulado.
+ *
+ * Estado é por contexto: este tracker assume um único contexto na thread principal.
+ */
+class GLState {
+public:
+    static constexpr unsigned int MaxTextureUnits = 32;
+    static constexpr unsigned int MaxUniformBuffers = 8;
+
+    struct Stats {
+        uint32_t issued = 0;  // Chamadas GL feitas
+        uint32_t skipped = 0; // Chamadas evitadas por já estar no estado pedido
+
+        void Print() const {
+            std::cout << "[GLState] chamadas: " << issued << " feitas, " << skipped << " evitadas" << std::endl;
+        }
+    };
+
+private:
+    static constexpr GLuint Unknown = 0xFFFFFFFFu;
+
+    // Alvos de textura com cache; os demais sempre chamam o GL
+    enum TargetSlot { Texture2D = 0, TextureCube, Texture2DArray, TargetCount };
+
+    GLuint program = Unknown;
+    GLuint vertexArray = Unknown;
+    GLuint framebuffer = Unknown;
+    GLenum activeUnit = Unknown;
+    GLuint textures[MaxTextureUnits][TargetCount];
+    // Faixa ligada em cada binding point de bloco (size 0 = buffer inteiro)
+    struct BufferRange {
+        GLuint id;
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+    BufferRange uniformBuffers[MaxUniformBuffers];
+
+    int viewport[4] = { -1, -1, -1, -1 };
+    GLenum depthFunc = Unknown;
+
+    // Flags: -1 = desconhecido, 0 = desligado, 1 = ligado
+    int depthTest = -1;
+    int cullFace = -1;
+    int blend = -1;
+
+    Stats stats;
+
+    GLState() { Invalidate(); }
+
+    static int targetSlot(GLenum target) {
+        if (target == GL_TEXTURE_2D) return Texture2D;
+        if (target == GL_TEXTURE_CUBE_MAP) return TextureCube;
+        if (target == GL_TEXTURE_2D_ARRAY) return Texture2DArray;
+        return -1;
+    }
+
+    int* capFlag(GLenum cap) {
+        switch (cap) {
+            case GL_DEPTH_TEST: return &depthTest;
+            case GL_CULL_FACE: return &cullFace;
+            case GL_BLEND: return &blend;
+            default: return nullptr;
+        }
+    }
+
+    bool changed(bool differs) {
+        if (differs) stats.issued++;
+        else stats.skipped++;
+        return differs;
+    }
+
+public:
+    static GLState& GetInstance() {
+        static GLState instance;
+        return instance;
+    }
+
+    // Esquece tudo: a próxima chamada de cada tipo sempre vai para o GL
+    void Invalidate() {
+        program = Unknown;
+        vertexArray = Unknown;
+        framebuffer = Unknown;
+        activeUnit = Unknown;
+        for (auto& unit : textures) {
+            for (auto& texture : unit) texture = Unknown;
+        }
+        for (auto& buffer : uniformBuffers) buffer = BufferRange{ Unknown, 0, 0 };
+        viewport[0] = viewport[1] = viewport[2] = viewport[3] = -1;
+        depthFunc = Unknown;
+        depthTest = cullFace = blend = -1;
+    }
+
+    void UseProgram(GLuint id) {
+        if (!changed(program != id)) return;
+        glUseProgram(id);
+        program = id;
+    }
+
+    void BindVertexArray(GLuint id) {
+        if (!changed(vertexArray != id)) return;
+        glBindVertexArray(id);
+        vertexArray = id;
+    }
+
+    void BindFramebuffer(GLuint id) {
+        if (!changed(framebuffer != id)) return;
+        glBindFramebuffer(GL_FRAMEBUFFER, id);
+        framebuffer = id;
+    }
+
+    void ActiveTexture(unsigned int unit) {
+        GLenum value = GL_TEXTURE0 + unit;
+        if (!changed(activeUnit != value)) return;
+        glActiveTexture(value);
+        activeUnit = value;
+    }
+
+    // Liga a textura na unidade indicada (troca a unidade ativa só se precisar)
+    void BindTexture(unsigned int unit, GLenum target, GLuint id) {
+        int slot = targetSlot(target);
+        if (slot >= 0 && unit < MaxTextureUnits && textures[unit][slot] == id) {
+            stats.skipped++;
+            return;
+        }
+        ActiveTexture(unit);
+        stats.issued++;
+        glBindTexture(target, id);
+        if (slot >= 0 && unit < MaxTextureUnits) textures[unit][slot] = id;
+    }
+
+    // Liga na unidade ativa atual (uploads, que não ligam para qual unidade é)
+    void BindTexture(GLenum target, GLuint id) {
+        if (activeUnit == Unknown) ActiveTexture(0);
+        BindTexture(activeUnit - GL_TEXTURE0, target, id);
+    }
+
+    // glBindBufferBase(GL_UNIFORM_BUFFER, ...): liga o buffer a um binding point de bloco
+    void BindUniformBuffer(unsigned int index, GLuint id) {
+        if (index < MaxUniformBuffers) {
+            const BufferRange& bound = uniformBuffers[index];
+            if (!changed(bound.id != id || bound.size != 0)) return;
+        } else {
+            stats.issued++;
+        }
+        glBindBufferBase(GL_UNIFORM_BUFFER, index, id);
+        if (index < MaxUniformBuffers) uniformBuffers[index] = BufferRange{ id, 0, 0 };
+    }
+
+    // glBindBufferRange(GL_UNIFORM_BUFFER, ...): faixa de um buffer (ex.: StreamBuffer)
+    void BindUniformBufferRange(unsigned int index, GLuint id, GLintptr offset, GLsizeiptr size) {
+        if (index < MaxUniformBuffers) {
+            const BufferRange& bound = uniformBuffers[index];
+            if (!changed(bound.id != id || bound.offset != offset || bound.size != size)) return;
+        } else {
+            stats.issued++;
+        }
+        glBindBufferRange(GL_UNIFORM_BUFFER, index, id, offset, size);
+        if (index < MaxUniformBuffers) uniformBuffers[index] = BufferRange{ id, offset, size };
+    }
+
+    void SetEnabled(GLenum cap, bool enabled) {
+        int* flag = capFlag(cap);
+        int value = enabled ? 1 : 0;
+        if (flag && *flag == value) {
+            stats.skipped++;
+            return;
+        }
+        stats.issued++;
+        if (enabled) glEnable(cap);
+        else glDisable(cap);
+        if (flag) *flag = value;
+    }
+
+    bool IsEnabled(GLenum cap) {
+        int* flag = capFlag(cap);
+        if (flag && *flag >= 0) return *flag == 1;
+        bool enabled = glIsEnabled(cap) == GL_TRUE;
+        if (flag) *flag = enabled ? 1 : 0;
+        return enabled;
+    }
+
+    void SetDepthFunc(GLenum func) {
+        if (!changed(depthFunc != func)) return;
+        glDepthFunc(func);
+        depthFunc = func;
+    }
+
+    void SetViewport(int x, int y, int width, int height) {
+        if (!changed(viewport[0] != x || viewport[1] != y || viewport[2] != width || viewport[3] != height)) return;
+        glViewport(x, y, width, height);
+        viewport[0] = x;
+        viewport[1] = y;
+        viewport[2] = width;
+        viewport[3] = height;
+    }
+
+    // O GL desfaz os binds de objetos deletados; o cache precisa acompanhar
+    void ForgetProgram(GLuint id) {
+        if (program == id) program = Unknown;
+    }
+
+    void ForgetVertexArray(GLuint id) {
+        if (vertexArray == id) vertexArray = Unknown;
+    }
+
+    void ForgetFramebuffer(GLuint id) {
+        if (framebuffer == id) framebuffer = Unknown;
+    }
+
+    void ForgetTexture(GLuint id) {
+        for (auto& unit : textures) {
+            for (auto& texture : unit) {
+                if (texture == id) texture = Unknown;
+            }
+        }
+    }
+
+    void ForgetUniformBuffer(GLuint id) {
+        for (auto& buffer : uniformBuffers) {
+            if (buffer.id == id) buffer = BufferRange{ Unknown, 0, 0 };
+        }
+    }
+
+    GLuint GetProgram() const { return program; }
+
+    // Framebuffer ligado; consulta o GL se o cache não sabe (ex.: depois de Invalidate)
+    GLuint GetFramebuffer() {
+        if (framebuffer == Unknown) {
+            GLint bound = 0;
+            glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound);
+            framebuffer = static_cast<GLuint>(bound);
+        }
+        return framebuffer;
+    }
+
+    GLuint GetVertexArray() const { return vertexArray; }
+
+    const Stats& GetStats() const { return stats; }
+
+    // Chamado uma vez por frame; retorna os contadores do frame que terminou
+    Stats ResetStats() {
+        Stats last = stats;
+        stats = Stats();
+        return last;
+    }
+
+    GLState(const GLState&) = delete;
+    GLState& operator=(const GLState&) = delete;
+};
+
+#endif // GL_STATE_HPP
@@ -0,0 +1,233 @@
+#ifndef IMAGE_WRITER_HPP
+#define IMAGE_WRITER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Gravação de frames RGBA8 em disco, sem dependências externas.
+ *
+ * As linhas chegam na ordem do glReadPixels (de baixo para cima) e são
+ * invertidas na gravação. O PNG usa blocos deflate "stored" (sem compressão):
+ * arquivos maiores, mas sem zlib e com custo de CPU só de cópia + CRC, o que
+ * importa mais num render em lote que o tamanho do arquivo. O EXR guarda a
+ * cena HDR em float, também sem compressão.
+ */
+namespace ImageWriter {
+
+namespace detail {
+
+inline uint32_t CRC32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+    // Inicialização de static local é thread-safe: workers podem codificar em paralelo
+    static const std::array<uint32_t, 256> table = []() {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+inline void PutU32BE(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Tipo + dados + CRC dos dois
+inline void PutU32LE(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+inline void PutU64LE(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; i++) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+inline void PutF32LE(std::vector<uint8_t>& out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    PutU32LE(out, bits);
+}
+
+// Atributo do cabeçalho EXR: nome, tipo, tamanho e valor (já serializado)
+inline void PutAttribute(std::vector<uint8_t>& out, const char* name, const char* type, const std::vector<uint8_t>& value) {
+    out.insert(out.end(), name, name + std::strlen(name) + 1);
+    out.insert(out.end(), type, type + std::strlen(type) + 1);
+    PutU32LE(out, static_cast<uint32_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+inline void PutChunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& data) {
+    PutU32BE(out, static_cast<uint32_t>(data.size()));
+    size_t crcStart = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    PutU32BE(out, CRC32(out.data() + crcStart, out.size() - crcStart));
+}
+
+inline bool WriteFile(const std::string& path, const uint8_t* data, size_t size) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "[ImageWriter] Não foi possível criar " << path << std::endl;
+        return false;
+    }
+    bool ok = std::fwrite(data, 1, size, file) == size;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) std::cerr << "[ImageWriter] Erro gravando " << path << std::endl;
+    return ok;
+}
+
+} // namespace detail
+
+/**
+ * @brief Monta um PNG RGBA8 em memória.
+ * @param rgba width * height * 4 bytes, primeira linha = base da imagem (GL)
+ */
+inline std::vector<uint8_t> EncodePNG(const uint8_t* rgba, int width, int height) {
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+
+    // Scanlines com filtro 0, de cima para baixo
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (int y = height - 1; y >= 0; y--) {
+        raw.push_back(0);
+        const uint8_t* row = rgba + static_cast<size_t>(y) * rowBytes;
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+
+    // zlib: cabeçalho, blocos stored de até 65535 bytes, Adler-32
+    std::vector<uint8_t> zlib;
+    zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    size_t pos = 0;
+    do {
+        size_t blockSize = std::min<size_t>(raw.size() - pos, 65535);
+        bool last = pos + blockSize == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(blockSize));
+        zlib.push_back(static_cast<uint8_t>(blockSize >> 8));
+        zlib.push_back(static_cast<uint8_t>(~blockSize));
+        zlib.push_back(static_cast<uint8_t>(~blockSize >> 8));
+        zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + blockSize);
+        pos += blockSize;
+    } while (pos < raw.size());
+
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    detail::PutU32BE(zlib, (b << 16) | a);
+
+    std::vector<uint8_t> header;
+    detail::PutU32BE(header, static_cast<uint32_t>(width));
+    detail::PutU32BE(header, static_cast<uint32_t>(height));
+    header.push_back(8); // bits por canal
+    header.push_back(6); // RGBA
+    header.push_back(0); // deflate
+    header.push_back(0); // filtro adaptativo
+    header.push_back(0); // sem interlace
+
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    std::vector<uint8_t> png(signature, signature + 8);
+    png.reserve(zlib.size() + 64);
+    detail::PutChunk(png, "IHDR", header);
+    detail::PutChunk(png, "IDAT", zlib);
+    detail::PutChunk(png, "IEND", {});
+    return png;
+}
+
+inline bool WritePNG(const std::string& path, const uint8_t* rgba, int width, int height) {
+    std::vector<uint8_t> png = EncodePNG(rgba, width, height);
+    return detail::WriteFile(path, png.data(), png.size());
+}
+
+/**
+ * @brief Monta um OpenEXR scanline, sem compressão, canais R/G/B em float.
+ * @param rgb width * height * 3 floats, primeira linha = base da imagem (GL)
+ */
+inline std::vector<uint8_t> EncodeEXR(const float* rgb, int width, int height) {
+    std::vector<uint8_t> exr = { 0x76, 0x2F, 0x31, 0x01, 2, 0, 0, 0 };
+
+    // Canais em ordem alfabética, como o formato exige
+    std::vector<uint8_t> channels;
+    for (const char* name : { "B", "G", "R" }) {
+        channels.push_back(static_cast<uint8_t>(name[0]));
+        channels.push_back(0);
+        detail::PutU32LE(channels, 2);      // FLOAT
+        channels.insert(channels.end(), 4, 0); // pLinear + reservado
+        detail::PutU32LE(channels, 1);      // xSampling
+        detail::PutU32LE(channels, 1);      // ySampling
+    }
+    channels.push_back(0);
+
+    std::vector<uint8_t> window;
+    detail::PutU32LE(window, 0);
+    detail::PutU32LE(window, 0);
+    detail::PutU32LE(window, static_cast<uint32_t>(width - 1));
+    detail::PutU32LE(window, static_cast<uint32_t>(height - 1));
+
+    std::vector<uint8_t> one, center;
+    detail::PutF32LE(one, 1.0f);
+    detail::PutF32LE(center, 0.0f);
+    detail::PutF32LE(center, 0.0f);
+
+    detail::PutAttribute(exr, "channels", "chlist", channels);
+    detail::PutAttribute(exr, "compression", "compression", { 0 });
+    detail::PutAttribute(exr, "dataWindow", "box2i", window);
+    detail::PutAttribute(exr, "displayWindow", "box2i", window);
+    detail::PutAttribute(exr, "lineOrder", "lineOrder", { 0 });
+    detail::PutAttribute(exr, "pixelAspectRatio", "float", one);
+    detail::PutAttribute(exr, "screenWindowCenter", "v2f", center);
+    detail::PutAttribute(exr, "screenWindowWidth", "float", one);
+    exr.push_back(0);
+
+    // Tabela de offsets (um bloco por linha), depois as linhas: y, tamanho, B[], G[], R[]
+    const size_t lineBytes = static_cast<size_t>(width) * 3 * sizeof(float);
+    const size_t tableStart = exr.size();
+    const size_t dataStart = tableStart + static_cast<size_t>(height) * 8;
+    exr.reserve(dataStart + (lineBytes + 8) * height);
+    for (int y = 0; y < height; y++) detail::PutU64LE(exr, dataStart + static_cast<size_t>(y) * (lineBytes + 8));
+
+    for (int y = 0; y < height; y++) {
+        const float* row = rgb + static_cast<size_t>(height - 1 - y) * width * 3;
+        detail::PutU32LE(exr, static_cast<uint32_t>(y));
+        detail::PutU32LE(exr, static_cast<uint32_t>(lineBytes));
+        for (int channel = 2; channel >= 0; channel--) {
+            for (int x = 0; x < width; x++) detail::PutF32LE(exr, row[x * 3 + channel]);
+        }
+    }
+    return exr;
+}
+
+inline bool WriteEXR(const std::string& path, const float* rgb, int width, int height) {
+    std::vector<uint8_t> exr = EncodeEXR(rgb, width, height);
+    return detail::WriteFile(path, exr.data(), exr.size());
+}
+
+// Linhas de cima para baixo, sem cabeçalho (ex.: ffmpeg -f rawvideo -pix_fmt rgba -s WxH -i -)
+inline bool WriteRaw(FILE* stream, const uint8_t* rgba, int width, int height) {
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    for (int y = height - 1; y >= 0; y--) {
+        if (std::fwrite(rgba + static_cast<size_t>(y) * rowBytes, 1, rowBytes, stream) != rowBytes) return false;
+    }
+    return true;
+}
+
+} // namespace ImageWriter
+
+#endif // IMAGE_WRITER_HPP
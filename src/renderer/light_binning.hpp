@@ -0,0 +1,516 @@
+#ifndef LIGHT_BINNING_HPP
+#define LIGHT_BINNING_HPP
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LIGHT_BINNING_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHT_BINNING_SSE 1
+#endif
+
+#include "bounds.hpp"
+#include "frustum.hpp"
+#include "light_clusters.hpp"
+
+/**
+ * @brief Testes de esfera em lote sobre luzes em SoA (x, y, z, raio em arrays
+ * separados). Cada função escreve os índices que passaram e retorna quantos.
+ *
+ * O caminho é escolhido na compilação: AVX2 (8 luzes por instrução, com
+ * -mavx2 ou ENABLE_AVX2 no CMake), SSE (4, padrão em x86-64) ou escalar. O
+ * resto que não completa um vetor sempre vai pelo escalar, então as versões
+ * *Scalar dão o mesmo resultado e servem de referência no benchmark.
+ */
+namespace LightKernels {
+
+inline const char* GetName() {
+#if defined(LIGHT_BINNING_AVX2)
+    return "AVX2";
+#elif defined(LIGHT_BINNING_SSE)
+    return "SSE";
+#else
+    return "escalar";
+#endif
+}
+
+// Índice do bit menos significativo (mask != 0)
+inline int lowestBit(unsigned int mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while (!(mask & 1u)) { mask >>= 1; bit++; }
+    return bit;
+#endif
+}
+
+// Esferas [begin, count) dentro ou cruzando os 6 planos; escreve begin + i
+inline size_t CullSpheresScalar(const Frustum& frustum, const float* x, const float* y, const float* z,
+                                const float* r, size_t begin, size_t count, uint32_t* out) {
+    size_t hits = 0;
+    for (size_t i = begin; i < count; i++) {
+        bool inside = true;
+        for (const auto& plane : frustum.planes) {
+            inside &= plane.x * x[i] + plane.y * y[i] + plane.z * z[i] + plane.w >= -r[i];
+        }
+        if (inside) out[hits++] = static_cast<uint32_t>(i);
+    }
+    return hits;
+}
+
+inline size_t CullSpheres(const Frustum& frustum, const float* x, const float* y, const float* z,
+                          const float* r, size_t count, uint32_t* out) {
+    size_t i = 0;
+    size_t hits = 0;
+#if defined(LIGHT_BINNING_AVX2)
+    const __m256 zero = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256 pz = _mm256_loadu_ps(z + i);
+        __m256 negRadius = _mm256_sub_ps(zero, _mm256_loadu_ps(r + i));
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const auto& plane : frustum.planes) {
+            __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(plane.x)), _mm256_mul_ps(py, _mm256_set1_ps(plane.y))),
+                _mm256_add_ps(_mm256_mul_ps(pz, _mm256_set1_ps(plane.z)), _mm256_set1_ps(plane.w)));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+        }
+        for (unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(inside)); mask; mask &= mask - 1) {
+            out[hits++] = static_cast<uint32_t>(i + lowestBit(mask));
+        }
+    }
+#elif defined(LIGHT_BINNING_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 pz = _mm_loadu_ps(z + i);
+        __m128 negRadius = _mm_sub_ps(zero, _mm_loadu_ps(r + i));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto& plane : frustum.planes) {
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(plane.x)), _mm_mul_ps(py, _mm_set1_ps(plane.y))),
+                _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+        }
+        for (unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(inside)); mask; mask &= mask - 1) {
+            out[hits++] = static_cast<uint32_t>(i + lowestBit(mask));
+        }
+    }
+#endif
+    return hits + CullSpheresScalar(frustum, x, y, z, r, i, count, out + hits);
+}
+
+// Esferas [begin, count) que tocam a caixa; escreve ids[i] (índice original da luz)
+inline size_t SpheresTouchingBoxScalar(const AABB& box, const float* x, const float* y, const float* z,
+                                       const float* r, const uint32_t* ids, size_t begin, size_t count, uint32_t* out) {
+    size_t hits = 0;
+    for (size_t i = begin; i < count; i++) {
+        float dx = std::max(std::max(box.min.x - x[i], x[i] - box.max.x), 0.0f);
+        float dy = std::max(std::max(box.min.y - y[i], y[i] - box.max.y), 0.0f);
+        float dz = std::max(std::max(box.min.z - z[i], z[i] - box.max.z), 0.0f);
+        if (dx * dx + dy * dy + dz * dz <= r[i] * r[i]) out[hits++] = ids[i];
+    }
+    return hits;
+}
+
+inline size_t SpheresTouchingBox(const AABB& box, const float* x, const float* y, const float* z,
+                                 const float* r, const uint32_t* ids, size_t count, uint32_t* out) {
+    size_t i = 0;
+    size_t hits = 0;
+#if defined(LIGHT_BINNING_AVX2)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 minX = _mm256_set1_ps(box.min.x), maxX = _mm256_set1_ps(box.max.x);
+    const __m256 minY = _mm256_set1_ps(box.min.y), maxY = _mm256_set1_ps(box.max.y);
+    const __m256 minZ = _mm256_set1_ps(box.min.z), maxZ = _mm256_set1_ps(box.max.z);
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256 pz = _mm256_loadu_ps(z + i);
+        __m256 radius = _mm256_loadu_ps(r + i);
+        // Distância do centro ao ponto mais próximo da caixa, por eixo
+        __m256 dx = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(minX, px), _mm256_sub_ps(px, maxX)), zero);
+        __m256 dy = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(minY, py), _mm256_sub_ps(py, maxY)), zero);
+        __m256 dz = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(minZ, pz), _mm256_sub_ps(pz, maxZ)), zero);
+        __m256 distance2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+        __m256 touch = _mm256_cmp_ps(distance2, _mm256_mul_ps(radius, radius), _CMP_LE_OQ);
+        for (unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(touch)); mask; mask &= mask - 1) {
+            out[hits++] = ids[i + lowestBit(mask)];
+        }
+    }
+#elif defined(LIGHT_BINNING_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 minX = _mm_set1_ps(box.min.x), maxX = _mm_set1_ps(box.max.x);
+    const __m128 minY = _mm_set1_ps(box.min.y), maxY = _mm_set1_ps(box.max.y);
+    const __m128 minZ = _mm_set1_ps(box.min.z), maxZ = _mm_set1_ps(box.max.z);
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 pz = _mm_loadu_ps(z + i);
+        __m128 radius = _mm_loadu_ps(r + i);
+        __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minX, px), _mm_sub_ps(px, maxX)), zero);
+        __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minY, py), _mm_sub_ps(py, maxY)), zero);
+        __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minZ, pz), _mm_sub_ps(pz, maxZ)), zero);
+        __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        __m128 touch = _mm_cmple_ps(distance2, _mm_mul_ps(radius, radius));
+        for (unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(touch)); mask; mask &= mask - 1) {
+            out[hits++] = ids[i + lowestBit(mask)];
+        }
+    }
+#endif
+    return hits + SpheresTouchingBoxScalar(box, x, y, z, r, ids, i, count, out + hits);
+}
+
+} // namespace LightKernels
+
+/**
+ * @brief Descobre, na CPU, quais luzes pontuais do frame tocam algum draw.
+ *
+ * Bin() faz três passes:
+ *   1. frustum: esfera de cada luz contra os planos do BeginScene;
+ *   2. tiles: as luzes visíveis são ordenadas pela profundidade em view e a
+ *      extensão na tela de cada uma vira uma faixa de tiles de TileSize
+ *      pixels, com uma lista de luzes por tile (na mesma ordem);
+ *   3. draws: cada caixa (bounds em mundo de um RenderCommand) pega, nos tiles
+ *      que cobre, só as luzes na sua faixa de profundidade (busca binária),
+ *      copia essas em SoA e testa contra a caixa.
+ * Luzes fora da tela saem no passe 2, mesmo que toquem a parte de um draw que
+ * está fora dela. Saem duas coisas: as luzes que tocam pelo menos um draw
+ * (GetUsedLights), que o Renderer manda para os clusters da GPU, e a lista de
+ * cada draw em (offset, quantidade) num array de índices, como no
+ * LightClusters. Os índices das listas são posições em GetUsedLights (a mesma
+ * numeração do texture buffer de luzes), então vão para a GPU sem tradução: o
+ * pbr.frag usa a lista do draw quando ela é menor que a do cluster do
+ * fragmento. Assume projeção perspectiva (a do Renderer). Não usa o GL.
+ */
+class LightBinner {
+public:
+    static constexpr int TileSize = 64;
+    static constexpr size_t GatherCost = 4; // Custo de juntar uma luz pelos tiles, em testes do kernel
+
+    struct Stats {
+        uint32_t lights = 0;
+        uint32_t visibleLights = 0; // Passaram no frustum e caem na tela
+        uint32_t usedLights = 0;    // Tocam pelo menos um draw
+        uint32_t tileIndices = 0;   // Pares (tile, luz)
+        uint32_t drawIndices = 0;   // Pares (draw, luz) que se tocam
+        uint32_t maxPerDraw = 0;
+        double cullMs = 0.0;
+        double tileMs = 0.0;
+        double drawMs = 0.0;
+
+        double TotalMs() const { return cullMs + tileMs + drawMs; }
+    };
+
+private:
+    // Esferas em SoA com o índice original da luz, no formato que os kernels leem
+    struct SphereSet {
+        std::vector<float> x, y, z, radius;
+        std::vector<uint32_t> ids;
+
+        void Resize(size_t count) {
+            x.resize(count); y.resize(count); z.resize(count); radius.resize(count); ids.resize(count);
+        }
+        void Copy(size_t to, const SphereSet& from, size_t index) {
+            x[to] = from.x[index]; y[to] = from.y[index]; z[to] = from.z[index];
+            radius[to] = from.radius[index]; ids[to] = from.ids[index];
+        }
+    };
+
+    SphereSet lights;                  // Todas as luzes do frame
+    std::vector<uint32_t> visible;     // Índices das que passaram no frustum
+    SphereSet visibleSet;              // As que caem na tela, por profundidade
+    std::vector<float> visibleDepth;
+    float maxRadius = 0.0f;
+
+    int tilesX = 0;
+    int tilesY = 0;
+    std::vector<uint32_t> tileRanges;  // (offset, quantidade) por tile
+    std::vector<uint32_t> tileSlots;   // Posição em visibleSet, crescente dentro de cada tile
+    std::vector<uint32_t> tileCursor;
+    std::vector<int> lightRects;       // (x0, y0, x1, y1) em tiles por luz visível
+    std::vector<std::pair<float, uint32_t>> depthOrder;
+
+    std::vector<uint32_t> drawRanges;  // (offset, quantidade) por draw
+    std::vector<uint32_t> drawLights;  // Posições em usedLights
+
+    SphereSet candidates;              // Luzes dos tiles de um draw, sem repetição
+    std::vector<uint32_t> hits;
+    std::vector<uint32_t> stamp;       // Último draw que já juntou a luz (evita duplicar entre tiles)
+    uint32_t stampValue = 0;
+
+    std::vector<uint32_t> used;        // Por luz: posição em usedLights + 1 (0 = não usada)
+    std::vector<uint32_t> usedLights;
+
+    Stats stats;
+
+    using Clock = std::chrono::steady_clock;
+
+    static double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    static int toTile(float ndc, int pixels, int tiles) {
+        int tile = static_cast<int>((ndc * 0.5f + 0.5f) * pixels) / TileSize;
+        return std::min(std::max(tile, 0), tiles - 1);
+    }
+
+    // Faixa de tiles que a esfera (em view, z positivo à frente) cobre; false se fora da tela
+    bool sphereRect(const glm::vec3& center, float radius, const glm::mat4& proj, int width, int height, int* rect) const {
+        rect[0] = 0; rect[1] = 0; rect[2] = tilesX - 1; rect[3] = tilesY - 1;
+        float zMin = center.z - radius;
+        if (zMin <= 1e-4f) return true; // Cruza o plano da câmera: tela inteira
+        float zMax = center.z + radius;
+        float lo = std::min((center.x - radius) / zMin, (center.x - radius) / zMax) * proj[0][0];
+        float hi = std::max((center.x + radius) / zMin, (center.x + radius) / zMax) * proj[0][0];
+        if (hi < -1.0f || lo > 1.0f) return false;
+        rect[0] = toTile(lo, width, tilesX);
+        rect[2] = toTile(hi, width, tilesX);
+        lo = std::min((center.y - radius) / zMin, (center.y - radius) / zMax) * proj[1][1];
+        hi = std::max((center.y + radius) / zMin, (center.y + radius) / zMax) * proj[1][1];
+        if (hi < -1.0f || lo > 1.0f) return false;
+        rect[1] = toTile(lo, height, tilesY);
+        rect[3] = toTile(hi, height, tilesY);
+        return true;
+    }
+
+    // Tiles e profundidade (clip.w) dos 8 cantos projetados da caixa; tudo se algum está atrás da câmera
+    void boxRect(const AABB& box, const glm::mat4& viewProj, int width, int height, int* rect, glm::vec2& depth) const {
+        rect[0] = 0; rect[1] = 0; rect[2] = tilesX - 1; rect[3] = tilesY - 1;
+        depth = glm::vec2(-FLT_MAX, FLT_MAX);
+        if (!box.IsValid()) return;
+        glm::vec2 lo(1.0f), hi(-1.0f);
+        glm::vec2 range(FLT_MAX, -FLT_MAX);
+        for (int corner = 0; corner < 8; corner++) {
+            glm::vec4 p(corner & 1 ? box.max.x : box.min.x, corner & 2 ? box.max.y : box.min.y,
+                        corner & 4 ? box.max.z : box.min.z, 1.0f);
+            glm::vec4 clip = viewProj * p;
+            if (clip.w <= 1e-4f) return;
+            glm::vec2 ndc(clip.x / clip.w, clip.y / clip.w);
+            lo = glm::min(lo, ndc);
+            hi = glm::max(hi, ndc);
+            range.x = std::min(range.x, clip.w);
+            range.y = std::max(range.y, clip.w);
+        }
+        rect[0] = toTile(lo.x, width, tilesX);
+        rect[1] = toTile(lo.y, height, tilesY);
+        rect[2] = toTile(hi.x, width, tilesX);
+        rect[3] = toTile(hi.y, height, tilesY);
+        depth = range;
+    }
+
+    void setLights(const PointLightData* data, size_t count) {
+        lights.Resize(count);
+        for (size_t i = 0; i < count; i++) {
+            lights.x[i] = data[i].position.x;
+            lights.y[i] = data[i].position.y;
+            lights.z[i] = data[i].position.z;
+            lights.radius[i] = data[i].radius;
+            lights.ids[i] = static_cast<uint32_t>(i);
+        }
+    }
+
+    void binTiles(const glm::mat4& view, const glm::mat4& proj, int width, int height) {
+        size_t tiles = static_cast<size_t>(tilesX) * tilesY;
+        tileCursor.assign(tiles, 0);
+        lightRects.resize(visible.size() * 4);
+        depthOrder.clear();
+        maxRadius = 0.0f;
+
+        // Faixa de tiles e profundidade de cada luz; as fora da tela saem aqui
+        for (uint32_t light : visible) {
+            glm::vec4 p = view * glm::vec4(lights.x[light], lights.y[light], lights.z[light], 1.0f);
+            float radius = lights.radius[light];
+            int* rect = &lightRects[depthOrder.size() * 4];
+            if (!sphereRect(glm::vec3(p.x, p.y, -p.z), radius, proj, width, height, rect)) continue;
+            depthOrder.emplace_back(-p.z, static_cast<uint32_t>(depthOrder.size()));
+            maxRadius = std::max(maxRadius, radius);
+        }
+        std::sort(depthOrder.begin(), depthOrder.end());
+
+        visibleSet.Resize(depthOrder.size());
+        visibleDepth.resize(depthOrder.size());
+        for (size_t v = 0; v < depthOrder.size(); v++) {
+            uint32_t kept = depthOrder[v].second;
+            visibleSet.Copy(v, lights, visible[kept]);
+            visibleDepth[v] = depthOrder[v].first;
+            const int* rect = &lightRects[kept * 4];
+            for (int ty = rect[1]; ty <= rect[3]; ty++) {
+                for (int tx = rect[0]; tx <= rect[2]; tx++) tileCursor[static_cast<size_t>(ty) * tilesX + tx]++;
+            }
+        }
+
+        // Prefix sum e preenchimento em ordem de profundidade (counting sort estável)
+        tileRanges.resize(tiles * 2);
+        uint32_t offset = 0;
+        for (size_t t = 0; t < tiles; t++) {
+            tileRanges[t * 2] = offset;
+            tileRanges[t * 2 + 1] = tileCursor[t];
+            tileCursor[t] = offset;
+            offset += tileRanges[t * 2 + 1];
+        }
+        tileSlots.resize(offset);
+        for (size_t v = 0; v < depthOrder.size(); v++) {
+            const int* rect = &lightRects[depthOrder[v].second * 4];
+            for (int ty = rect[1]; ty <= rect[3]; ty++) {
+                for (int tx = rect[0]; tx <= rect[2]; tx++) {
+                    uint32_t slot = tileCursor[static_cast<size_t>(ty) * tilesX + tx]++;
+                    tileSlots[slot] = static_cast<uint32_t>(v);
+                }
+            }
+        }
+        stats.visibleLights = static_cast<uint32_t>(visibleSet.ids.size());
+        stats.tileIndices = offset;
+    }
+
+    // Copia para candidates as luzes dos tiles do retângulo com posição em visibleSet
+    // em [first, last), sem repetir as que estão em vários tiles
+    void gatherCandidates(const int* rect, uint32_t first, uint32_t last) {
+        if (++stampValue == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            stampValue = 1;
+        }
+        size_t count = 0;
+        for (int ty = rect[1]; ty <= rect[3]; ty++) {
+            for (int tx = rect[0]; tx <= rect[2]; tx++) {
+                size_t tile = static_cast<size_t>(ty) * tilesX + tx;
+                const uint32_t* begin = tileSlots.data() + tileRanges[tile * 2];
+                const uint32_t* end = begin + tileRanges[tile * 2 + 1];
+                begin = std::lower_bound(begin, end, first);
+                end = std::lower_bound(begin, end, last);
+                for (const uint32_t* slot = begin; slot != end; slot++) {
+                    if (stamp[*slot] == stampValue) continue;
+                    stamp[*slot] = stampValue;
+                    candidates.Copy(count++, visibleSet, *slot);
+                }
+            }
+        }
+        candidates.Resize(count);
+    }
+
+    void binDraws(const AABB* boxes, size_t boxCount, const glm::mat4& viewProj, int width, int height) {
+        const size_t visibleCount = visibleSet.ids.size();
+        drawRanges.resize(boxCount * 2);
+        drawLights.clear();
+        used.assign(lights.ids.size(), 0);
+        if (stamp.size() != visibleCount) {
+            stamp.assign(visibleCount, 0);
+            stampValue = 0;
+        }
+        hits.resize(visibleCount);
+
+        for (size_t d = 0; d < boxCount; d++) {
+            int rect[4];
+            glm::vec2 depth;
+            boxRect(boxes[d], viewProj, width, height, rect, depth);
+
+            // Só luzes cujo centro está a até maxRadius da faixa de profundidade da caixa
+            uint32_t first = static_cast<uint32_t>(std::lower_bound(visibleDepth.begin(), visibleDepth.end(),
+                                                                    depth.x - maxRadius) - visibleDepth.begin());
+            uint32_t last = static_cast<uint32_t>(std::upper_bound(visibleDepth.begin() + first, visibleDepth.end(),
+                                                                   depth.y + maxRadius) - visibleDepth.begin());
+
+            // Juntar pelos tiles custa algumas vezes mais por luz que o kernel: só compensa
+            // se as entradas dos tiles cobertos são bem menos que as luzes da janela
+            const SphereSet* set = &visibleSet;
+            size_t begin = first;
+            size_t count = last - first;
+            size_t tileEntries = 0;
+            for (int ty = rect[1]; ty <= rect[3]; ty++) {
+                for (int tx = rect[0]; tx <= rect[2]; tx++) tileEntries += tileRanges[(static_cast<size_t>(ty) * tilesX + tx) * 2 + 1];
+            }
+            if (tileEntries * GatherCost < count) {
+                candidates.Resize(count);
+                gatherCandidates(rect, first, last);
+                set = &candidates;
+                begin = 0;
+                count = candidates.ids.size();
+            }
+
+            if (boxes[d].IsValid()) {
+                count = LightKernels::SpheresTouchingBox(boxes[d], set->x.data() + begin, set->y.data() + begin,
+                                                         set->z.data() + begin, set->radius.data() + begin,
+                                                         set->ids.data() + begin, count, hits.data());
+            } else {
+                std::copy(set->ids.begin() + begin, set->ids.begin() + begin + count, hits.begin()); // Sem bounds: todas as visíveis
+            }
+
+            drawRanges[d * 2] = static_cast<uint32_t>(drawLights.size());
+            drawRanges[d * 2 + 1] = static_cast<uint32_t>(count);
+            drawLights.insert(drawLights.end(), hits.begin(), hits.begin() + count);
+            for (size_t n = 0; n < count; n++) used[hits[n]] = 1;
+            stats.maxPerDraw = std::max(stats.maxPerDraw, static_cast<uint32_t>(count));
+        }
+        stats.drawIndices = static_cast<uint32_t>(drawLights.size());
+
+        // Numera as usadas em ordem crescente e troca os índices das listas por essa numeração
+        usedLights.clear();
+        for (size_t i = 0; i < used.size(); i++) {
+            if (!used[i]) continue;
+            usedLights.push_back(static_cast<uint32_t>(i));
+            used[i] = static_cast<uint32_t>(usedLights.size());
+        }
+        for (uint32_t& light : drawLights) light = used[light] - 1;
+        stats.usedLights = static_cast<uint32_t>(usedLights.size());
+    }
+
+public:
+    /**
+     * @brief Distribui as luzes do frame.
+     * @param frustum Planos da câmera (Renderer::GetFrustum, do BeginScene)
+     * @param boxes Bounds em mundo de cada draw; inválida = recebe todas as luzes visíveis
+     */
+    void Bin(const Frustum& frustum, const glm::mat4& view, const glm::mat4& proj, int width, int height,
+             const PointLightData* data, size_t lightCount, const AABB* boxes, size_t boxCount) {
+        stats = Stats();
+        stats.lights = static_cast<uint32_t>(lightCount);
+        width = std::max(width, 1);
+        height = std::max(height, 1);
+        tilesX = (width + TileSize - 1) / TileSize;
+        tilesY = (height + TileSize - 1) / TileSize;
+
+        auto start = Clock::now();
+        setLights(data, lightCount);
+        visible.resize(lightCount);
+        visible.resize(LightKernels::CullSpheres(frustum, lights.x.data(), lights.y.data(), lights.z.data(),
+                                                 lights.radius.data(), lightCount, visible.data()));
+        stats.cullMs = elapsedMs(start);
+
+        start = Clock::now();
+        binTiles(view, proj, width, height);
+        stats.tileMs = elapsedMs(start);
+
+        start = Clock::now();
+        binDraws(boxes, boxCount, proj * view, width, height);
+        stats.drawMs = elapsedMs(start);
+    }
+
+    // Luzes visíveis que tocam pelo menos um draw, em ordem crescente
+    const std::vector<uint32_t>& GetUsedLights() const { return usedLights; }
+
+    // (offset, quantidade) da lista do draw em GetDrawLightIndices
+    glm::uvec2 GetDrawRange(size_t draw) const { return glm::uvec2(drawRanges[draw * 2], drawRanges[draw * 2 + 1]); }
+
+    // Listas de todos os draws, com posições em GetUsedLights
+    const std::vector<uint32_t>& GetDrawLightIndices() const { return drawLights; }
+
+    // Luzes que tocam o draw (posições em GetUsedLights)
+    const uint32_t* GetDrawLights(size_t draw, uint32_t& count) const {
+        count = drawRanges[draw * 2 + 1];
+        return drawLights.data() + drawRanges[draw * 2];
+    }
+
+    const Stats& GetStats() const { return stats; }
+};
+
+#endif // LIGHT_BINNING_HPP
@@ -0,0 +1,499 @@
+#ifndef LIGHT_CLUSTERS_HPP
+#define LIGHT_CLUSTERS_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LIGHT_CLUSTERS_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHT_CLUSTERS_SSE 1
+#endif
+
+#include "gl_state.hpp"
+#include "stream_buffer.hpp"
+
+struct PointLightData {
+    glm::vec3 position;
+    glm::vec3 color;
+    float intensity;
+    float radius;
+};
+
+/**
+ * @brief Atribuição de luzes pontuais a clusters (froxels) para o forward shading.
+ *
+ * O frustum é dividido em tiles de TileSize pixels na tela e DepthSlices fatias
+ * em profundidade (distribuição logarítmica). Build() testa a esfera de cada
+ * luz contra as caixas (espaço de view) dos clusters que ela pode tocar e monta
+ * uma lista compacta: por cluster, (offset, quantidade) num array de índices de
+ * luz. Upload() envia luzes, faixas e índices para texture buffers, e o
+ * pbr.frag avalia só as luzes do cluster do fragmento. Upload() também leva as
+ * listas por draw do LightBinner (quarto texture buffer): o fragmento usa a do
+ * seu draw quando ela é menor que a do cluster.
+ *
+ * As caixas ficam em SoA por linha de tiles; testRow testa a esfera contra 8
+ * clusters por vez com AVX2 ou 4 com SSE (mesmo esquema do FrustumCuller),
+ * com resto escalar. Build() não usa o GL (pode ser medido sem contexto).
+ *
+ * Os quatro arrays vão para um StreamBuffer em anel: cada frame escreve na sua
+ * região e aponta os texture buffers daquele slot para ela com
+ * glTexBufferRange, sem realocar armazenamento. Sem GL 4.3 /
+ * ARB_texture_buffer_range, volta ao orphaning com glBufferData.
+ */
+class LightClusters {
+public:
+    static constexpr int TileSize = 64;     // Pixels por tile
+    static constexpr int DepthSlices = 24;
+
+    // Unidades de textura dos texture buffers (depois dos arrays da MaterialTable)
+    static constexpr unsigned int LightsUnit = 20;
+    static constexpr unsigned int RangesUnit = 21;
+    static constexpr unsigned int IndicesUnit = 22;
+    static constexpr unsigned int DrawIndicesUnit = 23;
+
+    struct Stats {
+        uint32_t lights = 0;         // Luzes submetidas
+        uint32_t visibleLights = 0;  // Luzes que tocaram algum cluster
+        uint32_t indices = 0;        // Pares (cluster, luz)
+        uint32_t maxPerCluster = 0;
+        uint32_t truncated = 0;      // Pares descartados por limite do texture buffer
+        double buildMs = 0.0;
+    };
+
+private:
+    int dimX = 0;
+    int dimY = 0;
+    int width = 0;
+    int height = 0;
+    float zNear = 0.1f;
+    float zFar = 100.0f;
+    float projX = 1.0f; // proj[0][0]
+    float projY = 1.0f; // proj[1][1]
+    float sliceScale = 0.0f;
+    float sliceBias = 0.0f;
+
+    // Caixas dos clusters em espaço de view, com z como distância positiva
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+    // Resultado do Build
+    std::vector<uint32_t> ranges;        // (offset, quantidade) por cluster
+    std::vector<uint32_t> lightIndices;
+    std::vector<float> lightData;        // 8 floats por luz: posição/raio, cor/intensidade
+
+    // Temporários reaproveitados entre frames
+    std::vector<uint32_t> pairCluster;
+    std::vector<uint32_t> pairLight;
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> hits;
+
+    size_t maxIndices = 1u << 20;
+    Stats stats;
+
+    // Anel: um conjunto de texture buffers por região do StreamBuffer, para
+    // não redirecionar um TBO que a GPU ainda lê do frame anterior
+    StreamBuffer stream;
+    static constexpr int BufferCount = 4; // Luzes, faixas e índices dos clusters, índices por draw
+    GLuint textures[StreamBuffer::FrameCount][BufferCount] = {};
+    int slot = 0;
+    bool created = false;
+    bool useRanges = false;
+    size_t rangeAlignment = 16;
+
+    // Fallback sem glTexBufferRange: um buffer por array, com orphaning
+    GLuint buffers[BufferCount] = {};
+
+    static constexpr GLenum Formats[BufferCount] = { GL_RGBA32F, GL_RG32UI, GL_R32UI, GL_R32UI };
+
+    int clusterCount() const { return dimX * dimY * DepthSlices; }
+
+    int sliceOf(float depth) const {
+        int slice = static_cast<int>(std::floor(std::log(depth) * sliceScale + sliceBias));
+        return std::min(std::max(slice, 0), DepthSlices - 1);
+    }
+
+    // Recalcula as caixas quando o viewport ou a projeção mudam
+    void rebuildGrid(int viewportWidth, int viewportHeight, const glm::mat4& proj) {
+        float nearPlane = proj[3][2] / (proj[2][2] - 1.0f);
+        float farPlane = proj[3][2] / (proj[2][2] + 1.0f);
+        int newDimX = (viewportWidth + TileSize - 1) / TileSize;
+        int newDimY = (viewportHeight + TileSize - 1) / TileSize;
+        if (newDimX == dimX && newDimY == dimY && viewportWidth == width && viewportHeight == height &&
+            nearPlane == zNear && farPlane == zFar && proj[0][0] == projX && proj[1][1] == projY) return;
+
+        dimX = newDimX;
+        dimY = newDimY;
+        width = viewportWidth;
+        height = viewportHeight;
+        zNear = nearPlane;
+        zFar = farPlane;
+        projX = proj[0][0];
+        projY = proj[1][1];
+
+        // slice = log(z) * scale + bias  <=>  z = near * (far/near)^(slice/DepthSlices)
+        float logRatio = std::log(zFar / zNear);
+        sliceScale = DepthSlices / logRatio;
+        sliceBias = -DepthSlices * std::log(zNear) / logRatio;
+
+        size_t count = static_cast<size_t>(clusterCount());
+        minX.resize(count); minY.resize(count); minZ.resize(count);
+        maxX.resize(count); maxY.resize(count); maxZ.resize(count);
+
+        for (int k = 0; k < DepthSlices; k++) {
+            float z0 = zNear * std::pow(zFar / zNear, static_cast<float>(k) / DepthSlices);
+            float z1 = zNear * std::pow(zFar / zNear, static_cast<float>(k + 1) / DepthSlices);
+            for (int j = 0; j < dimY; j++) {
+                float y0 = (static_cast<float>(j * TileSize) / height) * 2.0f - 1.0f;
+                float y1 = (std::min(static_cast<float>((j + 1) * TileSize) / height, 1.0f)) * 2.0f - 1.0f;
+                for (int i = 0; i < dimX; i++) {
+                    float x0 = (static_cast<float>(i * TileSize) / width) * 2.0f - 1.0f;
+                    float x1 = (std::min(static_cast<float>((i + 1) * TileSize) / width, 1.0f)) * 2.0f - 1.0f;
+
+                    // Cantos do tile nas duas profundidades (projeção simétrica: x_view = ndc * z / proj[0][0])
+                    size_t c = (static_cast<size_t>(k) * dimY + j) * dimX + i;
+                    minX[c] = std::min(x0 * z0, x0 * z1) / projX;
+                    maxX[c] = std::max(x1 * z0, x1 * z1) / projX;
+                    minY[c] = std::min(y0 * z0, y0 * z1) / projY;
+                    maxY[c] = std::max(y1 * z0, y1 * z1) / projY;
+                    minZ[c] = z0;
+                    maxZ[c] = z1;
+                }
+            }
+        }
+    }
+
+    // Faixa [first, last] de tiles num eixo para o intervalo [lo, hi] em NDC; false se fora da tela
+    static bool tileRange(float lo, float hi, int pixels, int dim, int& first, int& last) {
+        if (hi < -1.0f || lo > 1.0f) return false;
+        first = static_cast<int>((lo * 0.5f + 0.5f) * pixels) / TileSize;
+        last = static_cast<int>((hi * 0.5f + 0.5f) * pixels) / TileSize;
+        first = std::min(std::max(first, 0), dim - 1);
+        last = std::min(std::max(last, 0), dim - 1);
+        return true;
+    }
+
+    // Posição do bit menos significativo (máscaras do movemask nunca são 0 aqui)
+    static int lowestBit(unsigned int mask) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    // Clusters [begin, count) da linha tocados pela esfera, sem SIMD
+    int testRowScalar(const float* x0, const float* x1, const float* y0, const float* y1,
+                      const float* z0, const float* z1, int begin, int count,
+                      float cx, float cy, float cz, float radius2, uint32_t* out) const {
+        int found = 0;
+        for (int i = begin; i < count; i++) {
+            // Distância da esfera ao ponto mais próximo da caixa
+            float dx = std::max(std::max(x0[i] - cx, cx - x1[i]), 0.0f);
+            float dy = std::max(std::max(y0[i] - cy, cy - y1[i]), 0.0f);
+            float dz = std::max(std::max(z0[i] - cz, cz - z1[i]), 0.0f);
+            if (dx * dx + dy * dy + dz * dz <= radius2) out[found++] = static_cast<uint32_t>(i);
+        }
+        return found;
+    }
+
+    // Escreve em hits as posições (relativas a base) dos clusters da linha que a esfera toca
+    int testRow(size_t base, int count, float cx, float cy, float cz, float radius2) {
+        const float* x0 = minX.data() + base;
+        const float* x1 = maxX.data() + base;
+        const float* y0 = minY.data() + base;
+        const float* y1 = maxY.data() + base;
+        const float* z0 = minZ.data() + base;
+        const float* z1 = maxZ.data() + base;
+        uint32_t* out = hits.data();
+        int i = 0;
+        int found = 0;
+#if defined(LIGHT_CLUSTERS_AVX2)
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 px = _mm256_set1_ps(cx), py = _mm256_set1_ps(cy), pz = _mm256_set1_ps(cz);
+        const __m256 r2 = _mm256_set1_ps(radius2);
+        for (; i + 8 <= count; i += 8) {
+            __m256 dx = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(x0 + i), px),
+                                                    _mm256_sub_ps(px, _mm256_loadu_ps(x1 + i))), zero);
+            __m256 dy = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(y0 + i), py),
+                                                    _mm256_sub_ps(py, _mm256_loadu_ps(y1 + i))), zero);
+            __m256 dz = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(z0 + i), pz),
+                                                    _mm256_sub_ps(pz, _mm256_loadu_ps(z1 + i))), zero);
+            __m256 distance2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+            unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(distance2, r2, _CMP_LE_OQ)));
+            for (; mask; mask &= mask - 1) out[found++] = static_cast<uint32_t>(i + lowestBit(mask));
+        }
+#elif defined(LIGHT_CLUSTERS_SSE)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 px = _mm_set1_ps(cx), py = _mm_set1_ps(cy), pz = _mm_set1_ps(cz);
+        const __m128 r2 = _mm_set1_ps(radius2);
+        for (; i + 4 <= count; i += 4) {
+            __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(x0 + i), px),
+                                              _mm_sub_ps(px, _mm_loadu_ps(x1 + i))), zero);
+            __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(y0 + i), py),
+                                              _mm_sub_ps(py, _mm_loadu_ps(y1 + i))), zero);
+            __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(z0 + i), pz),
+                                              _mm_sub_ps(pz, _mm_loadu_ps(z1 + i))), zero);
+            __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(_mm_cmple_ps(distance2, r2)));
+            for (; mask; mask &= mask - 1) out[found++] = static_cast<uint32_t>(i + lowestBit(mask));
+        }
+#endif
+        return found + testRowScalar(x0, x1, y0, y1, z0, z1, i, count, cx, cy, cz, radius2, out + found);
+    }
+
+    void createBuffers() {
+        created = true;
+        useRanges = GLEW_VERSION_4_3 || GLEW_ARB_texture_buffer_range;
+
+        GLint maxTexels = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+        if (maxTexels > 0) maxIndices = static_cast<size_t>(maxTexels);
+
+        if (useRanges) {
+            GLint offsetAlignment = 0;
+            glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+            rangeAlignment = static_cast<size_t>(std::max(offsetAlignment, 16));
+            // Começa com espaço para 1024 luzes e 64k índices por frame; Reserve cresce se faltar
+            useRanges = stream.Create(GL_TEXTURE_BUFFER, 1024 * 8 * sizeof(float) + (64u << 10) * sizeof(uint32_t),
+                                      rangeAlignment);
+        }
+
+        if (useRanges) {
+            glGenTextures(StreamBuffer::FrameCount * BufferCount, &textures[0][0]);
+            return;
+        }
+
+        std::cerr << "LightClusters: sem glTexBufferRange, usando orphaning" << std::endl;
+        glGenBuffers(BufferCount, buffers);
+        glGenTextures(BufferCount, textures[0]);
+        for (int i = 0; i < BufferCount; i++) {
+            glBindBuffer(GL_TEXTURE_BUFFER, buffers[i]);
+            glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_STREAM_DRAW);
+            GLState::GetInstance().BindTexture(GL_TEXTURE_BUFFER, textures[0][i]);
+            glTexBuffer(GL_TEXTURE_BUFFER, Formats[i], buffers[i]);
+        }
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+
+    // Fallback. Orphaning: o driver troca o armazenamento se a GPU ainda lê o do frame anterior
+    static void uploadBuffer(GLuint buffer, const void* data, size_t bytes) {
+        static const uint32_t empty[4] = {};
+        glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+        if (bytes == 0) glBufferData(GL_TEXTURE_BUFFER, sizeof(empty), empty, GL_STREAM_DRAW);
+        else glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(bytes), data, GL_STREAM_DRAW);
+    }
+
+    // Região do anel: nunca vazia (glTexBufferRange não aceita tamanho 0)
+    size_t streamBytes(size_t bytes) const {
+        return (std::max(bytes, static_cast<size_t>(16)) + rangeAlignment - 1) / rangeAlignment * rangeAlignment;
+    }
+
+    // Copia os arrays para a região do frame e aponta os TBOs do slot para elas
+    bool uploadRing(const void* const* data, const size_t* bytes) {
+        size_t total = 0;
+        for (int i = 0; i < BufferCount; i++) total += streamBytes(bytes[i]);
+
+        stream.BeginFrame();
+        stream.Reserve(total);
+
+        size_t offsets[BufferCount];
+        for (int i = 0; i < BufferCount; i++) {
+            StreamBuffer::Allocation allocation = stream.Allocate(streamBytes(bytes[i]));
+            if (!allocation.data) return false;
+            if (bytes[i] > 0) std::memcpy(allocation.data, data[i], bytes[i]);
+            offsets[i] = allocation.offset;
+        }
+        stream.Flush();
+
+        slot = (slot + 1) % StreamBuffer::FrameCount;
+        GLState& gl = GLState::GetInstance();
+        for (int i = 0; i < BufferCount; i++) {
+            gl.BindTexture(GL_TEXTURE_BUFFER, textures[slot][i]);
+            glTexBufferRange(GL_TEXTURE_BUFFER, Formats[i], stream.GetID(), static_cast<GLintptr>(offsets[i]),
+                             static_cast<GLsizeiptr>(streamBytes(bytes[i])));
+        }
+        return true;
+    }
+
+public:
+    LightClusters() = default;
+
+    ~LightClusters() {
+        if (!created) return;
+        for (auto& slotTextures : textures) {
+            for (GLuint texture : slotTextures) {
+                if (texture) GLState::GetInstance().ForgetTexture(texture);
+            }
+        }
+        if (useRanges) glDeleteTextures(StreamBuffer::FrameCount * BufferCount, &textures[0][0]);
+        else {
+            glDeleteTextures(BufferCount, textures[0]);
+            glDeleteBuffers(BufferCount, buffers);
+        }
+    }
+
+    /**
+     * @brief Monta as listas de luzes por cluster (só CPU).
+     * @param view Matriz de view da câmera
+     * @param proj Projeção perspectiva simétrica (glm::perspective)
+     */
+    void Build(const glm::mat4& view, const glm::mat4& proj, int viewportWidth, int viewportHeight,
+               const PointLightData* lights, size_t lightCount) {
+        auto start = std::chrono::steady_clock::now();
+        rebuildGrid(std::max(viewportWidth, 1), std::max(viewportHeight, 1), proj);
+
+        stats = Stats();
+        stats.lights = static_cast<uint32_t>(lightCount);
+
+        lightData.resize(lightCount * 8);
+        for (size_t l = 0; l < lightCount; l++) {
+            const PointLightData& light = lights[l];
+            float* out = &lightData[l * 8];
+            out[0] = light.position.x; out[1] = light.position.y; out[2] = light.position.z; out[3] = light.radius;
+            out[4] = light.color.x; out[5] = light.color.y; out[6] = light.color.z; out[7] = light.intensity;
+        }
+
+        pairCluster.clear();
+        pairLight.clear();
+        hits.resize(static_cast<size_t>(dimX));
+
+        for (size_t l = 0; l < lightCount; l++) {
+            const PointLightData& light = lights[l];
+            float r = light.radius;
+            glm::vec4 p = view * glm::vec4(light.position, 1.0f);
+            float cx = p.x, cy = p.y, cz = -p.z; // z como distância à frente da câmera
+            if (r <= 0.0f || cz + r < zNear || cz - r > zFar) continue;
+
+            int k0 = sliceOf(std::max(cz - r, zNear));
+            int k1 = sliceOf(std::min(cz + r, zFar));
+
+            // Extensão na tela da caixa da esfera; cruzando o near plane, a tela inteira
+            int i0 = 0, i1 = dimX - 1, j0 = 0, j1 = dimY - 1;
+            float zMin = cz - r;
+            if (zMin > zNear) {
+                float zMax = cz + r;
+                float lo = std::min((cx - r) / zMin, (cx - r) / zMax) * projX;
+                float hi = std::max((cx + r) / zMin, (cx + r) / zMax) * projX;
+                if (!tileRange(lo, hi, width, dimX, i0, i1)) continue;
+                lo = std::min((cy - r) / zMin, (cy - r) / zMax) * projY;
+                hi = std::max((cy + r) / zMin, (cy + r) / zMax) * projY;
+                if (!tileRange(lo, hi, height, dimY, j0, j1)) continue;
+            }
+
+            float radius2 = r * r;
+            size_t before = pairCluster.size();
+            for (int k = k0; k <= k1; k++) {
+                for (int j = j0; j <= j1; j++) {
+                    size_t base = (static_cast<size_t>(k) * dimY + j) * dimX + i0;
+                    int count = i1 - i0 + 1;
+                    int found = testRow(base, count, cx, cy, cz, radius2);
+                    for (int n = 0; n < found; n++) {
+                        pairCluster.push_back(static_cast<uint32_t>(base + hits[n]));
+                        pairLight.push_back(static_cast<uint32_t>(l));
+                    }
+                }
+            }
+            if (pairCluster.size() > before) stats.visibleLights++;
+        }
+
+        // Counting sort dos pares por cluster
+        size_t clusters = static_cast<size_t>(clusterCount());
+        counts.assign(clusters, 0);
+        for (uint32_t cluster : pairCluster) counts[cluster]++;
+
+        // Limite do texture buffer: corta o excesso por cluster (raro; conta em truncated)
+        uint32_t perClusterLimit = UINT32_MAX;
+        if (pairCluster.size() > maxIndices) {
+            perClusterLimit = static_cast<uint32_t>(maxIndices / clusters);
+            std::cerr << "LightClusters: " << pairCluster.size() << " índices excedem o texture buffer" << std::endl;
+        }
+
+        ranges.resize(clusters * 2);
+        uint32_t offset = 0;
+        for (size_t c = 0; c < clusters; c++) {
+            uint32_t count = std::min(counts[c], perClusterLimit);
+            stats.truncated += counts[c] - count;
+            stats.maxPerCluster = std::max(stats.maxPerCluster, count);
+            ranges[c * 2] = offset;
+            ranges[c * 2 + 1] = count;
+            counts[c] = offset; // Vira o cursor de escrita
+            offset += count;
+        }
+
+        lightIndices.resize(offset);
+        for (size_t n = 0; n < pairCluster.size(); n++) {
+            uint32_t c = pairCluster[n];
+            if (counts[c] - ranges[c * 2] >= ranges[c * 2 + 1]) continue;
+            lightIndices[counts[c]++] = pairLight[n];
+        }
+        stats.indices = offset;
+        stats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * @brief Envia o resultado do último Build para os texture buffers. Uma vez
+     * por frame (avança o anel).
+     * @param drawLights Listas por draw (LightBinner::GetDrawLightIndices), com
+     * índices na mesma numeração das luzes passadas ao Build; nullptr se não há
+     * @return false se as listas por draw não couberam (o Renderer não as usa)
+     */
+    bool Upload(const uint32_t* drawLights = nullptr, size_t drawLightCount = 0) {
+        if (!created) createBuffers();
+        bool drawListsFit = drawLightCount <= maxIndices;
+        if (!drawListsFit) drawLightCount = 0;
+
+        const void* data[BufferCount] = { lightData.data(), ranges.data(), lightIndices.data(), drawLights };
+        const size_t bytes[BufferCount] = { lightData.size() * sizeof(float), ranges.size() * sizeof(uint32_t),
+                                            lightIndices.size() * sizeof(uint32_t), drawLightCount * sizeof(uint32_t) };
+        if (useRanges) {
+            if (!uploadRing(data, bytes)) {
+                std::cerr << "LightClusters: StreamBuffer sem espaço para as listas de luzes" << std::endl;
+                drawListsFit = false;
+            }
+        } else {
+            for (int i = 0; i < BufferCount; i++) uploadBuffer(buffers[i], data[i], bytes[i]);
+        }
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        return drawListsFit;
+    }
+
+    // Liga os texture buffers nas unidades fixas (samplers clusterLights/Ranges/Indices e drawLightIndices)
+    void Bind() const {
+        GLState& gl = GLState::GetInstance();
+        gl.BindTexture(LightsUnit, GL_TEXTURE_BUFFER, textures[slot][0]);
+        gl.BindTexture(RangesUnit, GL_TEXTURE_BUFFER, textures[slot][1]);
+        gl.BindTexture(IndicesUnit, GL_TEXTURE_BUFFER, textures[slot][2]);
+        gl.BindTexture(DrawIndicesUnit, GL_TEXTURE_BUFFER, textures[slot][3]);
+    }
+
+    // Para o bloco FrameData: grade (x, y, fatias, tamanho do tile) e fatiamento em profundidade
+    glm::ivec4 GetDimensions() const { return glm::ivec4(dimX, dimY, DepthSlices, TileSize); }
+    glm::vec4 GetDepthParams() const { return glm::vec4(zNear, zFar, sliceScale, sliceBias); }
+
+    // Consulta do resultado do Build (benchmark, depuração)
+    uint32_t GetClusterIndex(int x, int y, int slice) const { return static_cast<uint32_t>((slice * dimY + y) * dimX + x); }
+    uint32_t GetLightCount(uint32_t cluster) const { return ranges[cluster * 2 + 1]; }
+    const uint32_t* GetLights(uint32_t cluster) const { return lightIndices.data() + ranges[cluster * 2]; }
+    int GetClusterCount() const { return clusterCount(); }
+
+    const Stats& GetStats() const { return stats; }
+
+    // Estatísticas do anel (somadas às dos outros StreamBuffers no RenderStats)
+    StreamBuffer::Stats ResetStreamStats() { return stream.ResetStats(); }
+
+    LightClusters(const LightClusters&) = delete;
+    LightClusters& operator=(const LightClusters&) = delete;
+};
+
+#endif // LIGHT_CLUSTERS_HPP
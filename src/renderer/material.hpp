@@ -3,10 +3,14 @@
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
 #include "texture.hpp"
+#include "uniform_buffer.hpp"
 
 struct MaterialProperties {
     glm::vec3 albedo = glm::vec3(1.0f);
@@ -30,13 +34,123 @@ private:
     MaterialProperties properties;
     std::vector<std::shared_ptr<Texture>> textures;
 
+    // Identificador único (chave de ordenação do Renderer). Cópias ganham um novo.
+    uint32_t id;
+
+    // Índices em UniformLocations::properties
+    enum Property {
+        Albedo = 0, Metallic, Roughness, AO, Emission, EmissionStrength,
+        Ambient, Diffuse, Specular, Shininess, PropertyCount
+    };
+
+    // Locations resolvidas para um programa: uma por propriedade e uma por textura
+    struct UniformLocations {
+        unsigned int program = 0;
+        GLint properties[PropertyCount];
+        bool hasProperties = false; // Falso quando o shader usa o bloco MaterialData
+        std::vector<GLint> samplers;
+    };
+
+    // Poucos programas por material (normalmente 1): busca linear basta
+    mutable std::vector<UniformLocations> locationCache;
+
+    static uint32_t nextID() {
+        static std::atomic<uint32_t> counter{ 1 };
+        return counter++;
+    }
+
+    static const char* samplerPrefix(TextureType type) {
+        switch (type) {
+            case TextureType::DIFFUSE: return "texture_diffuse";
+            case TextureType::SPECULAR: return "texture_specular";
+            case TextureType::NORMAL: return "texture_normal";
+            case TextureType::HEIGHT: return "texture_height";
+            case TextureType::EMISSION: return "texture_emission";
+            case TextureType::METALLIC: return "texture_metallic";
+            case TextureType::ROUGHNESS: return "texture_roughness";
+            case TextureType::AO: return "texture_ao";
+            default: return nullptr; // Sem sampler no shader
+        }
+    }
+
+    /**
+     * @brief Locations deste material no programa, resolvidas só na primeira vez.
+     * As strings ("texture_diffuse1", "material.albedo"...) só existem aqui.
+     */
+    const UniformLocations& getLocations(unsigned int shaderProgram) const {
+        for (const auto& entry : locationCache) {
+            if (entry.program == shaderProgram) return entry;
+        }
+
+        static const char* propertyNames[PropertyCount] = {
+            "material.albedo", "material.metallic", "material.roughness", "material.ao",
+            "material.emission", "material.emissionStrength",
+            "material.ambient", "material.diffuse", "material.specular", "material.shininess"
+        };
+
+        UniformLocations entry;
+        entry.program = shaderProgram;
+        for (int i = 0; i < PropertyCount; i++) {
+            entry.properties[i] = glGetUniformLocation(shaderProgram, propertyNames[i]);
+            if (entry.properties[i] >= 0) entry.hasProperties = true;
+        }
+
+        // Numeração por tipo: texture_diffuse1, texture_diffuse2...
+        int counters[static_cast<int>(TextureType::UNKNOWN) + 1] = { 0 };
+        entry.samplers.reserve(textures.size());
+        for (const auto& texture : textures) {
+            const char* prefix = samplerPrefix(texture->GetType());
+            if (!prefix) {
+                entry.samplers.push_back(-1);
+                continue;
+            }
+            int number = ++counters[static_cast<int>(texture->GetType())];
+            std::string uniformName = prefix + std::to_string(number);
+            entry.samplers.push_back(glGetUniformLocation(shaderProgram, uniformName.c_str()));
+        }
+
+        locationCache.push_back(std::move(entry));
+        return locationCache.back();
+    }
+
+    void sendProperties(const UniformLocations& locations) const {
+        const GLint* loc = locations.properties;
+        glUniform3fv(loc[Albedo], 1, &properties.albedo[0]);
+        glUniform1f(loc[Metallic], properties.metallic);
+        glUniform1f(loc[Roughness], properties.roughness);
+        glUniform1f(loc[AO], properties.ao);
+
+        glUniform3fv(loc[Emission], 1, &properties.emission[0]);
+        glUniform1f(loc[EmissionStrength], properties.emissionStrength);
+
+        // Phong properties
+        glUniform3fv(loc[Ambient], 1, &properties.ambient[0]);
+        glUniform3fv(loc[Diffuse], 1, &properties.diffuse[0]);
+        glUniform3fv(loc[Specular], 1, &properties.specular[0]);
+        glUniform1f(loc[Shininess], properties.shininess);
+    }
+
 public:
     Material(const std::string& materialName = "Default") 
-        : name(materialName) {}
+        : name(materialName), id(nextID()) {}
+
+    Material(const Material& other)
+        : name(other.name), properties(other.properties), textures(other.textures), id(nextID()) {}
+
+    Material& operator=(const Material& other) {
+        name = other.name;
+        properties = other.properties;
+        textures = other.textures;
+        locationCache.clear();
+        return *this;
+    }
+
+    uint32_t GetID() const { return id; }
 
     void AddTexture(std::shared_ptr<Texture> texture) {
         if (texture && texture->IsLoaded()) {
             textures.push_back(texture);
+            locationCache.clear();
         }
     }
 
@@ -53,69 +167,58 @@ public:
     }
 
     void Apply(unsigned int shaderProgram) const {
-        int diffuseNr = 1;
-        int specularNr = 1;
-        int normalNr = 1;
-        int heightNr = 1;
-        int emissionNr = 1;
-        int metallicNr = 1;
-        int roughnessNr = 1;
-        int aoNr = 1;
+        const UniformLocations& locations = getLocations(shaderProgram);
 
         // Bind texturas
         for (size_t i = 0; i < textures.size(); i++) {
             textures[i]->Bind(i);
+            glUniform1i(locations.samplers[i], static_cast<GLint>(i));
+        }
 
-            std::string uniformName;
-            TextureType type = textures[i]->GetType();
-
-            switch (type) {
-                case TextureType::DIFFUSE:
-                    uniformName = "texture_diffuse" + std::to_string(diffuseNr++);
-                    break;
-                case TextureType::SPECULAR:
-                    uniformName = "texture_specular" + std::to_string(specularNr++);
-                    break;
-                case TextureType::NORMAL:
-                    uniformName = "texture_normal" + std::to_string(normalNr++);
-                    break;
-                case TextureType::HEIGHT:
-                    uniformName = "texture_height" + std::to_string(heightNr++);
-                    break;
-                case TextureType::EMISSION:
-                    uniformName = "texture_emission" + std::to_string(emissionNr++);
-                    break;
-                case TextureType::METALLIC:
-                    uniformName = "texture_metallic" + std::to_string(metallicNr++);
-                    break;
-                case TextureType::ROUGHNESS:
-                    uniformName = "texture_roughness" + std::to_string(roughnessNr++);
-                    break;
-                case TextureType::AO:
-                    uniformName = "texture_ao" + std::to_string(aoNr++);
-                    break;
-            }
+        // Shaders com o bloco MaterialData recebem as propriedades por GetUniformData
+        if (locations.hasProperties) sendProperties(locations);
+    }
 
-            glUniform1i(glGetUniformLocation(shaderProgram, uniformName.c_str()), i);
-        }
+    // Conteúdo do bloco MaterialData (std140) para este material
+    MaterialUniforms GetUniformData() const {
+        MaterialUniforms data{};
+        data.albedo = properties.albedo;
+        data.metallic = properties.metallic;
+        data.emission = properties.emission;
+        data.emissionStrength = properties.emissionStrength;
+        data.ambient = properties.ambient;
+        data.roughness = properties.roughness;
+        data.diffuse = properties.diffuse;
+        data.ao = properties.ao;
+        data.specular = properties.specular;
+        data.shininess = properties.shininess;
 
-        SendProperties(shaderProgram);
+        for (const auto& texture : textures) {
+            switch (texture->GetType()) {
+                case TextureType::DIFFUSE: data.textureMask |= MaterialTextureBits::Diffuse; break;
+                case TextureType::NORMAL: data.textureMask |= MaterialTextureBits::Normal; break;
+                case TextureType::METALLIC: data.textureMask |= MaterialTextureBits::Metallic; break;
+                case TextureType::ROUGHNESS: data.textureMask |= MaterialTextureBits::Roughness; break;
+                case TextureType::AO: data.textureMask |= MaterialTextureBits::AO; break;
+                case TextureType::EMISSION: data.textureMask |= MaterialTextureBits::Emission; break;
+                default: break;
+            }
+        }
+        return data;
     }
 
     void SendProperties(unsigned int shaderProgram) const {
-        glUniform3fv(glGetUniformLocation(shaderProgram, "material.albedo"), 1, &properties.albedo[0]);
-        glUniform1f(glGetUniformLocation(shaderProgram, "material.metallic"), properties.metallic);
-        glUniform1f(glGetUniformLocation(shaderProgram, "material.roughness"), properties.roughness);
-        glUniform1f(glGetUniformLocation(shaderProgram, "material.ao"), properties.ao);
-        
-        glUniform3fv(glGetUniformLocation(shaderProgram, "material.emission"), 1, &properties.emission[0]);
-        glUniform1f(glGetUniformLocation(shaderProgram, "material.emissionStrength"), properties.emissionStrength);
-        
-        // Phong properties
-        glUniform3fv(glGetUniformLocation(shaderProgram, "material.ambient"), 1, &properties.ambient[0]);
-        glUniform3fv(glGetUniformLocation(shaderProgram, "material.diffuse"), 1, &properties.diffuse[0]);
-        glUniform3fv(glGetUniformLocation(shaderProgram, "material.specular"), 1, &properties.specular[0]);
-        glUniform1f(glGetUniformLocation(shaderProgram, "material.shininess"), properties.shininess);
+        sendProperties(getLocations(shaderProgram));
+    }
+
+    // Programa deletado ou recompilado com o mesmo id: descarta as locations
+    void ForgetProgram(unsigned int shaderProgram) {
+        for (size_t i = 0; i < locationCache.size(); i++) {
+            if (locationCache[i].program == shaderProgram) {
+                locationCache.erase(locationCache.begin() + i);
+                return;
+            }
+        }
     }
 
     // Getters e Setters
@@ -151,6 +254,7 @@ public:
 
     void Clear() {
         textures.clear();
+        locationCache.clear();
     }
 };
 
@@ -212,6 +316,19 @@ public:
         return mat;
     }
 
+    // Materiais acima pelo nome, sem diferenciar maiúsculas ("gold", "Silver"...)
+    static bool Create(const std::string& name, Material& material) {
+        std::string key = name;
+        for (auto& c : key) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (key == "gold") material = CreateGold();
+        else if (key == "silver") material = CreateSilver();
+        else if (key == "copper") material = CreateCopper();
+        else if (key == "plastic") material = CreatePlastic();
+        else if (key == "rubber") material = CreateRubber();
+        else return false;
+        return true;
+    }
+
     static Material CreatePhong(const glm::vec3& diffuseColor) {
         Material mat("Phong");
         mat.SetDiffuse(diffuseColor);
@@ -0,0 +1,273 @@
+#ifndef MATERIAL_TABLE_HPP
+#define MATERIAL_TABLE_HPP
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "material.hpp"
+#include "texture.hpp"
+#include "uniform_buffer.hpp"
+#include "gl_state.hpp"
+
+/**
+ * @brief Todos os materiais num único uniform block, com as texturas copiadas
+ * para GL_TEXTURE_2D_ARRAY agrupados por tamanho.
+ *
+ * Cada material vira um MaterialTableEntry (propriedades + camada de cada
+ * textura) e o draw só informa o índice do material, como atributo de
+ * instância. Trocar de material deixa de ligar texturas e de reenviar o bloco
+ * MaterialData, então comandos com materiais diferentes podem ir no mesmo
+ * batch / multi-draw. O pbr.frag lê a tabela quando compilado com MATERIAL_TABLE.
+ *
+ * As texturas são lidas de volta da GPU uma vez (glGetTexImage) e copiadas para
+ * a camada do array do seu tamanho; os originais continuam valendo para o
+ * caminho com Material::Apply. Sem bindless no GL 3.3: os arrays ocupam
+ * MaxTextureArrays unidades fixas a partir de FirstTextureUnit.
+ */
+class MaterialTable {
+public:
+    static constexpr int MaxMaterials = UniformBlocks::MaxTableMaterials;
+    static constexpr int MaxTextureArrays = 4;       // MAX_TEXTURE_ARRAYS no pbr.frag
+    static constexpr unsigned int FirstTextureUnit = 16; // Depois das unidades de material e IBL
+    static constexpr int32_t NoTexture = -1;
+
+private:
+    // Um array por (largura, altura, sRGB); todas as camadas em RGBA8
+    struct TextureArray {
+        GLuint id = 0;
+        int width = 0;
+        int height = 0;
+        bool srgb = false;
+        int layers = 0;
+        int capacity = 0;
+        bool mipmapsDirty = false;
+    };
+
+    std::vector<TextureArray> arrays;
+    std::unordered_map<const Texture*, int32_t> textureRefs;
+    std::vector<std::shared_ptr<Texture>> sources; // Mantém vivos os originais (o ponteiro é a chave)
+
+    std::vector<MaterialTableEntry> entries;
+    std::unordered_map<uint32_t, uint32_t> indexByMaterial; // Material::GetID() -> índice
+    GLuint uniformBuffer = 0;
+    bool entriesDirty = false;
+    bool warnedFull = false;
+
+    static int textureSlot(TextureType type) {
+        switch (type) {
+            case TextureType::DIFFUSE: return MaterialTextureSlots::Diffuse;
+            case TextureType::NORMAL: return MaterialTextureSlots::Normal;
+            case TextureType::METALLIC: return MaterialTextureSlots::Metallic;
+            case TextureType::ROUGHNESS: return MaterialTextureSlots::Roughness;
+            case TextureType::AO: return MaterialTextureSlots::AO;
+            case TextureType::EMISSION: return MaterialTextureSlots::Emission;
+            default: return -1;
+        }
+    }
+
+    // Mesma regra do Texture::Upload: só cor (difusa, emissão) é sRGB
+    static bool isSRGB(TextureType type) {
+        return type == TextureType::DIFFUSE || type == TextureType::EMISSION;
+    }
+
+    // Realoca o array com mais camadas, preservando o conteúdo do nível 0
+    void growArray(TextureArray& array, int capacity) {
+        std::vector<uint8_t> pixels;
+        if (array.layers > 0) {
+            pixels.resize(static_cast<size_t>(array.width) * array.height * 4 * array.capacity);
+            GLState::GetInstance().BindTexture(GL_TEXTURE_2D_ARRAY, array.id);
+            glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        }
+
+        GLState& gl = GLState::GetInstance();
+        if (array.id) {
+            gl.ForgetTexture(array.id);
+            glDeleteTextures(1, &array.id);
+        }
+        glGenTextures(1, &array.id);
+        gl.BindTexture(GL_TEXTURE_2D_ARRAY, array.id);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, array.srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8,
+                     array.width, array.height, capacity, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        if (array.layers > 0) {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, array.width, array.height, array.layers,
+                            GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        }
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        array.capacity = capacity;
+        array.mipmapsDirty = true;
+    }
+
+    int findArray(int width, int height, bool srgb) {
+        for (size_t i = 0; i < arrays.size(); i++) {
+            const TextureArray& array = arrays[i];
+            if (array.width == width && array.height == height && array.srgb == srgb) return static_cast<int>(i);
+        }
+        if (static_cast<int>(arrays.size()) >= MaxTextureArrays) return -1;
+
+        TextureArray array;
+        array.width = width;
+        array.height = height;
+        array.srgb = srgb;
+        growArray(array, 4);
+        arrays.push_back(array);
+        return static_cast<int>(arrays.size() - 1);
+    }
+
+    // Camada da textura (copiando para o array na primeira vez); NoTexture se não há array livre
+    int32_t addTexture(const std::shared_ptr<Texture>& texture) {
+        auto it = textureRefs.find(texture.get());
+        if (it != textureRefs.end()) return it->second;
+
+        int arrayIndex = findArray(texture->GetWidth(), texture->GetHeight(), isSRGB(texture->GetType()));
+        if (arrayIndex < 0) {
+            std::cerr << "MaterialTable: sem array para " << texture->GetWidth() << "x" << texture->GetHeight()
+                      << " (" << texture->GetPath() << "), material fica sem essa textura" << std::endl;
+            textureRefs[texture.get()] = NoTexture;
+            sources.push_back(texture);
+            return NoTexture;
+        }
+
+        TextureArray& array = arrays[arrayIndex];
+        if (array.layers == array.capacity) growArray(array, array.capacity * 2);
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(array.width) * array.height * 4);
+        GLState& gl = GLState::GetInstance();
+        gl.BindTexture(GL_TEXTURE_2D, texture->GetID());
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        gl.BindTexture(GL_TEXTURE_2D_ARRAY, array.id);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, array.layers, array.width, array.height, 1,
+                        GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+        int32_t ref = (arrayIndex << 16) | array.layers;
+        array.layers++;
+        array.mipmapsDirty = true;
+        textureRefs[texture.get()] = ref;
+        sources.push_back(texture);
+        return ref;
+    }
+
+    MaterialTableEntry buildEntry(const Material& material) {
+        MaterialTableEntry entry{};
+        entry.properties = material.GetUniformData();
+        for (int32_t& ref : entry.textureRefs) ref = NoTexture;
+
+        // Primeira textura de cada tipo, como texture_diffuse1 no caminho com samplers
+        for (size_t i = 0; i < material.GetTextureCount(); i++) {
+            std::shared_ptr<Texture> texture = material.GetTexture(i);
+            int slot = textureSlot(texture->GetType());
+            if (slot < 0 || entry.textureRefs[slot] != NoTexture) continue;
+            entry.textureRefs[slot] = addTexture(texture);
+        }
+
+        // Sem camada, o shader usa a propriedade constante
+        const int32_t bits[] = {
+            MaterialTextureBits::Diffuse, MaterialTextureBits::Normal, MaterialTextureBits::Metallic,
+            MaterialTextureBits::Roughness, MaterialTextureBits::AO, MaterialTextureBits::Emission
+        };
+        for (int slot = 0; slot <= MaterialTextureSlots::Emission; slot++) {
+            if (entry.textureRefs[slot] == NoTexture) entry.properties.textureMask &= ~bits[slot];
+        }
+        return entry;
+    }
+
+public:
+    MaterialTable() = default;
+
+    ~MaterialTable() {
+        GLState& gl = GLState::GetInstance();
+        for (auto& array : arrays) {
+            gl.ForgetTexture(array.id);
+            glDeleteTextures(1, &array.id);
+        }
+        if (uniformBuffer) {
+            gl.ForgetUniformBuffer(uniformBuffer);
+            glDeleteBuffers(1, &uniformBuffer);
+        }
+    }
+
+    bool Init() {
+        if (uniformBuffer) return true;
+        glGenBuffers(1, &uniformBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(MaterialTableEntry) * MaxMaterials, nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        return uniformBuffer != 0;
+    }
+
+    /**
+     * @brief Índice do material na tabela, registrando na primeira vez.
+     * Propriedades alteradas depois do registro são detectadas aqui.
+     * Com a tabela cheia devolve 0 (o material é desenhado com o primeiro).
+     */
+    uint32_t Resolve(const Material& material) {
+        auto it = indexByMaterial.find(material.GetID());
+        if (it != indexByMaterial.end()) {
+            MaterialTableEntry& entry = entries[it->second];
+            MaterialUniforms properties = material.GetUniformData();
+            properties.textureMask = entry.properties.textureMask;
+            if (std::memcmp(&properties, &entry.properties, sizeof(properties)) != 0) {
+                entry.properties = properties;
+                entriesDirty = true;
+            }
+            return it->second;
+        }
+
+        if (static_cast<int>(entries.size()) >= MaxMaterials) {
+            if (!warnedFull) {
+                std::cerr << "MaterialTable: limite de " << MaxMaterials << " materiais atingido" << std::endl;
+                warnedFull = true;
+            }
+            return 0;
+        }
+
+        uint32_t index = static_cast<uint32_t>(entries.size());
+        entries.push_back(buildEntry(material));
+        indexByMaterial[material.GetID()] = index;
+        entriesDirty = true;
+        return index;
+    }
+
+    // Envia o que mudou (entradas e mipmaps dos arrays); chamar antes dos draws
+    void Upload() {
+        GLState& gl = GLState::GetInstance();
+        for (auto& array : arrays) {
+            if (!array.mipmapsDirty) continue;
+            gl.BindTexture(GL_TEXTURE_2D_ARRAY, array.id);
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+            array.mipmapsDirty = false;
+        }
+
+        if (entriesDirty && !entries.empty()) {
+            glBindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, entries.size() * sizeof(MaterialTableEntry), entries.data());
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            entriesDirty = false;
+        }
+    }
+
+    // Liga o bloco e os arrays nas unidades fixas
+    void Bind() const {
+        GLState& gl = GLState::GetInstance();
+        gl.BindUniformBuffer(UniformBlocks::MaterialTableBinding, uniformBuffer);
+        for (size_t i = 0; i < arrays.size(); i++) {
+            gl.BindTexture(FirstTextureUnit + static_cast<unsigned int>(i), GL_TEXTURE_2D_ARRAY, arrays[i].id);
+        }
+    }
+
+    size_t GetMaterialCount() const { return entries.size(); }
+    size_t GetTextureArrayCount() const { return arrays.size(); }
+
+    MaterialTable(const MaterialTable&) = delete;
+    MaterialTable& operator=(const MaterialTable&) = delete;
+};
+
+#endif // MATERIAL_TABLE_HPP
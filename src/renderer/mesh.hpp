@@ -3,73 +3,220 @@
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <iostream>
 #include "material.hpp"
+#include "shader.hpp"
+#include "vertex_format.hpp"
+#include "bounds.hpp"
+#include "gl_state.hpp"
+#include "geometry_arena.hpp"
 
-struct Vertex {
-    glm::vec3 Position;
-    glm::vec3 Normal;
-    glm::vec2 TexCoords;
-    glm::vec3 Tangent;
-    glm::vec3 Bitangent;
+// Memória de GPU das meshes vivas. indexBytes32 é o que os índices ocupariam sem a escolha de largura.
+struct MeshMemoryStats {
+    size_t meshCount = 0;
+    size_t narrowIndexMeshes = 0;
+    size_t vertexBytes = 0;
+    size_t indexBytes = 0;
+    size_t indexBytes32 = 0;
+    size_t cpuBytes = 0;          // cópias de vértices/índices mantidas na RAM
+    size_t cpuReleasedMeshes = 0;
+
+    void Print() const {
+        std::cout << "=== Memória de Meshes ===" << std::endl;
+        std::cout << "  Meshes: " << meshCount << " (" << narrowIndexMeshes << " com índices de 16 bits)" << std::endl;
+        std::cout << "  Vértices: " << vertexBytes / 1024.0 << " KB" << std::endl;
+        std::cout << "  Índices: " << indexBytes32 / 1024.0 << " KB -> " << indexBytes / 1024.0
+                  << " KB (economia de " << (indexBytes32 - indexBytes) / 1024.0 << " KB)" << std::endl;
+        std::cout << "  Cópias na CPU: " << cpuBytes / 1024.0 << " KB (" << cpuReleasedMeshes
+                  << " meshes só na GPU)" << std::endl;
+    }
+};
+
+// Faixa do index buffer usada por um nível de detalhe. LOD 0 é a malha completa.
+struct MeshLOD {
+    uint32_t indexOffset;
+    uint32_t indexCount;
+    float error; // erro geométrico em unidades do objeto (0 no LOD 0)
+};
+
+// O que fazer com as cópias de vértices/índices na CPU depois do upload
+enum class MeshResidency {
+    KeepCPUData,       // padrão: mantém vertices/indices (picking, física, exportação)
+    ReleaseAfterUpload // só GPU; RestoreCPUData() traz de volta sob demanda
 };
 
 class Mesh {
 private:
     unsigned int VAO, VBO, EBO;
     std::shared_ptr<Material> material;
+    VertexFormat format = VertexFormat::Standard;
+    GLenum indexType = GL_UNSIGNED_INT;
+    std::vector<uint16_t> indices16; // usado no lugar de indices quando o índice cabe em 16 bits
+    bool tracked = false;            // contabilizada em GetMemoryStats()
+
+    // Continuam válidos depois de ReleaseCPUData()
+    size_t vertexCount = 0;
+    size_t indexCount = 0; // total no index buffer, somando todos os LODs
+    std::vector<MeshLOD> lods;
+    AABB bounds;
+    bool hasCPUData = true;
+
+    // Faixa nos buffers compartilhados; quando válida, VAO é o do pool e VBO/EBO ficam 0
+    GeometryArena::Allocation arena;
+
+    // Identifica a mesh na chave de ordenação (no arena o VAO é o mesmo para várias meshes)
+    uint32_t sortID = nextSortID();
+
+    static uint32_t nextSortID() {
+        static std::atomic<uint32_t> counter{ 1 };
+        return counter++;
+    }
+
+    // Location de packedVertex do último programa passado a Draw(unsigned int)
+    unsigned int packedProgram = 0;
+    GLint packedLocation = -1;
+
+    void drawElements(const glm::mat4& transform) {
+        GLState::GetInstance().BindVertexArray(VAO);
+        SetConstantInstanceAttributes(transform);
+        glDrawElementsBaseVertex(GL_TRIANGLES, GetIndexCount(), indexType,
+                                 (void*)(GetFirstIndex() * GetIndexSize()), GetBaseVertex());
+    }
+
+    // Escolhe a largura do índice pelo número de vértices. Com copy32 = false,
+    // índices de 32 bits não são copiados (quem chama envia direto de indexData)
+    void assignIndices(const unsigned int* indexData, size_t count, bool copy32 = true) {
+        indexCount = count;
+        lods.assign(1, MeshLOD{ 0, static_cast<uint32_t>(count), 0.0f });
+        if (FitsUInt16(vertexCount)) {
+            indexType = GL_UNSIGNED_SHORT;
+            indices16.assign(indexData, indexData + count);
+            indices.clear();
+            indices.shrink_to_fit();
+        } else {
+            indexType = GL_UNSIGNED_INT;
+            if (copy32) indices.assign(indexData, indexData + count);
+            else indices.clear();
+            indices16.clear();
+        }
+    }
+
+    const void* getIndexData() const {
+        return indexType == GL_UNSIGNED_SHORT ? static_cast<const void*>(indices16.data())
+                                              : static_cast<const void*>(indices.data());
+    }
+
+    void trackMemory(bool add) {
+        if (tracked == add) return;
+        tracked = add;
+        MeshMemoryStats& stats = GetMemoryStats();
+        size_t sign = add ? 1 : size_t(-1); // subtração com wrap-around
+        stats.meshCount += sign;
+        stats.narrowIndexMeshes += (indexType == GL_UNSIGNED_SHORT) ? sign : 0;
+        stats.vertexBytes += sign * GetVertexBufferSize();
+        stats.indexBytes += sign * GetIndexBufferSize();
+        stats.indexBytes32 += sign * (indexCount * sizeof(unsigned int));
+        stats.cpuBytes += sign * GetCPUDataSize();
+        stats.cpuReleasedMeshes += hasCPUData ? 0 : sign;
+    }
+
+    void setCPUResidency(bool resident) {
+        if (hasCPUData == resident) return;
+        bool wasTracked = tracked;
+        trackMemory(false);
+        hasCPUData = resident;
+        if (wasTracked) trackMemory(true);
+    }
     
+    // Sobe para o GeometryArena; false se não coube (a mesh cai no caminho com buffers próprios)
+    bool setupArena(const Vertex* vertexData, const void* indexData) {
+        GeometryArena& geometryArena = GeometryArena::GetInstance();
+        if (format == VertexFormat::Packed) {
+            std::vector<PackedVertex> packed = VertexPacking::Pack(vertexData, vertexCount);
+            arena = geometryArena.Allocate(format, indexType, packed.data(), static_cast<uint32_t>(vertexCount),
+                                           indexData, static_cast<uint32_t>(indexCount));
+        } else {
+            arena = geometryArena.Allocate(format, indexType, vertexData, static_cast<uint32_t>(vertexCount),
+                                           indexData, static_cast<uint32_t>(indexCount));
+        }
+        if (!arena.IsValid()) return false;
+
+        VAO = geometryArena.GetPool(arena.pool).vao;
+        VBO = 0;
+        EBO = 0;
+        return true;
+    }
+
+    void releaseBuffers() {
+        if (arena.IsValid()) {
+            GeometryArena::GetInstance().Free(arena);
+            return; // VAO pertence ao pool
+        }
+        GLState::GetInstance().ForgetVertexArray(VAO);
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+        glDeleteBuffers(1, &EBO);
+    }
+
     void setupMesh() {
+        vertexCount = vertices.size();
+        upload(vertices.data(), getIndexData());
+    }
+
+    // Cria os buffers a partir de vertexData/indexData (vertexCount, indexCount e indexType já definidos)
+    void upload(const Vertex* vertexData, const void* indexData) {
+        bounds = AABB::FromVertices(vertexData, vertexCount);
+
+        if (GeometryArena::GetInstance().IsEnabled() && setupArena(vertexData, indexData)) {
+            trackMemory(true);
+            return;
+        }
+
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
 
-        glBindVertexArray(VAO);
+        GLState::GetInstance().BindVertexArray(VAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), 
-                     &vertices[0], GL_STATIC_DRAW);
+        if (format == VertexFormat::Packed) {
+            std::vector<PackedVertex> packed = VertexPacking::Pack(vertexData, vertexCount);
+            glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(PackedVertex),
+                         packed.data(), GL_STATIC_DRAW);
+        } else {
+            glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), 
+                         vertexData, GL_STATIC_DRAW);
+        }
 
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
-                     &indices[0], GL_STATIC_DRAW);
-
-        // Posições dos vértices
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-
-        // Normais dos vértices
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), 
-                              (void*)offsetof(Vertex, Normal));
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, GetIndexBufferSize(),
+                     indexData, GL_STATIC_DRAW);
 
-        // Coordenadas de textura
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), 
-                              (void*)offsetof(Vertex, TexCoords));
+        SetupVertexAttributes(format);
 
-        // Tangente
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                              (void*)offsetof(Vertex, Tangent));
+        GLState::GetInstance().BindVertexArray(0);
 
-        // Bitangente
-        glEnableVertexAttribArray(4);
-        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                              (void*)offsetof(Vertex, Bitangent));
-
-        glBindVertexArray(0);
+        trackMemory(true);
     }
 
 public:
+    // Cópias na CPU. Ficam vazias depois de ReleaseCPUData(); use HasCPUData() antes de ler.
     std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+    std::vector<unsigned int> indices; // vazio quando a mesh usa índices de 16 bits
 
     Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices,
-         std::shared_ptr<Material> mat = nullptr)
-        : vertices(vertices), indices(indices), material(mat) {
+         std::shared_ptr<Material> mat = nullptr,
+         VertexFormat vertexFormat = VertexFormat::Standard)
+        : vertices(std::move(vertices)), material(mat), format(vertexFormat) {
         
+        vertexCount = this->vertices.size();
+        assignIndices(indices.data(), indices.size());
+
         if (!material) {
             material = std::make_shared<Material>("Default");
         }
@@ -77,29 +224,181 @@ public:
         setupMesh();
     }
 
+    // Construtor a partir de memória externa (ex: cache mapeado). O upload lê direto
+    // dos ponteiros; só índices que cabem em 16 bits (e o formato Packed) passam por
+    // uma conversão. As cópias na CPU só são feitas com KeepCPUData.
+    Mesh(const Vertex* vertexData, size_t vertexCount,
+         const unsigned int* indexData, size_t indexCount,
+         std::shared_ptr<Material> mat = nullptr,
+         VertexFormat vertexFormat = VertexFormat::Standard,
+         MeshResidency residency = MeshResidency::KeepCPUData)
+        : material(mat), format(vertexFormat) {
+
+        bool keepCPUData = residency == MeshResidency::KeepCPUData;
+        this->vertexCount = vertexCount;
+        assignIndices(indexData, indexCount, keepCPUData);
+        if (keepCPUData) vertices.assign(vertexData, vertexData + vertexCount);
+
+        if (!material) {
+            material = std::make_shared<Material>("Default");
+        }
+
+        upload(vertexData, indexType == GL_UNSIGNED_SHORT ? static_cast<const void*>(indices16.data()) : indexData);
+        if (!keepCPUData) ReleaseCPUData();
+    }
+
     ~Mesh() {
-        glDeleteVertexArrays(1, &VAO);
-        glDeleteBuffers(1, &VBO);
-        glDeleteBuffers(1, &EBO);
+        trackMemory(false);
+        releaseBuffers();
     }
 
-    void Draw(unsigned int shaderProgram) {
+    // Draw avulso, fora do Renderer. O pbr.vert lê a matriz dos atributos de instância
+    // (não há uniform model): transform vira o valor constante deles
+    void Draw(const Shader& shader, const glm::mat4& transform = glm::mat4(1.0f)) {
         // Aplicar material
+        if (material) {
+            material->Apply(shader.GetProgramID());
+        }
+        shader.SetBool(Uniforms::PackedVertex, IsPacked());
+        drawElements(transform);
+    }
+
+    // Para quem só tem o ID do programa: a location só é buscada quando o programa muda
+    void Draw(unsigned int shaderProgram, const glm::mat4& transform = glm::mat4(1.0f)) {
         if (material) {
             material->Apply(shaderProgram);
         }
+        if (shaderProgram != packedProgram) {
+            packedProgram = shaderProgram;
+            packedLocation = glGetUniformLocation(shaderProgram, "packedVertex");
+        }
+        glUniform1i(packedLocation, IsPacked() ? 1 : 0);
+        drawElements(transform);
+    }
 
-        // Desenhar mesh
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+    // --- Residência dos dados na CPU ---
 
-        // Reset texture
-        glActiveTexture(GL_TEXTURE0);
+    // Libera as cópias de vértices/índices. A mesh continua desenhável; contagens e bounds são mantidos.
+    void ReleaseCPUData() {
+        if (!hasCPUData) return;
+        setCPUResidency(false);
+        std::vector<Vertex>().swap(vertices);
+        std::vector<unsigned int>().swap(indices);
+        std::vector<uint16_t>().swap(indices16);
     }
 
+    // Restaura as cópias a partir de dados externos (ex: cache de meshes). Não reenvia para a GPU.
+    bool RestoreCPUData(const Vertex* vertexData, size_t count,
+                        const unsigned int* indexData, size_t indexDataCount) {
+        if (hasCPUData) return true;
+        if (count != vertexCount || indexDataCount != indexCount) return false;
+
+        vertices.assign(vertexData, vertexData + count);
+        if (indexType == GL_UNSIGNED_SHORT) indices16.assign(indexData, indexData + indexDataCount);
+        else indices.assign(indexData, indexData + indexDataCount);
+        setCPUResidency(true);
+        return true;
+    }
+
+    // Restaura as cópias lendo os buffers de volta da GPU (mais lento; Packed volta com a precisão reduzida)
+    bool RestoreCPUDataFromGPU() {
+        if (hasCPUData) return true;
+
+        // Sem VAO ligado, o bind do EBO abaixo não altera o VAO desta mesh
+        // No arena os dados estão nos buffers do pool, a partir de baseVertex/firstIndex
+        GLState::GetInstance().BindVertexArray(0);
+        GLuint vertexBuffer = VBO;
+        GLuint indexBuffer = EBO;
+        if (arena.IsValid()) {
+            const GeometryArena::Pool& pool = GeometryArena::GetInstance().GetPool(arena.pool);
+            vertexBuffer = pool.vbo;
+            indexBuffer = pool.ebo;
+        }
+        GLintptr vertexOffset = static_cast<GLintptr>(GetBaseVertex() * GetVertexStride(format));
+        GLintptr indexOffset = static_cast<GLintptr>(GetFirstIndex() * GetIndexSize());
+
+        glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+        if (format == VertexFormat::Packed) {
+            std::vector<PackedVertex> packed(vertexCount);
+            glGetBufferSubData(GL_ARRAY_BUFFER, vertexOffset, packed.size() * sizeof(PackedVertex), packed.data());
+            vertices.resize(vertexCount);
+            for (size_t i = 0; i < vertexCount; i++) {
+                vertices[i] = VertexPacking::Unpack(packed[i]);
+            }
+        } else {
+            vertices.resize(vertexCount);
+            glGetBufferSubData(GL_ARRAY_BUFFER, vertexOffset, vertexCount * sizeof(Vertex), vertices.data());
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        if (indexType == GL_UNSIGNED_SHORT) {
+            indices16.resize(indexCount);
+            glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, indexOffset, GetIndexBufferSize(), indices16.data());
+        } else {
+            indices.resize(indexCount);
+            glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, indexOffset, GetIndexBufferSize(), indices.data());
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        setCPUResidency(true);
+        return true;
+    }
+
+    bool HasCPUData() const { return hasCPUData; }
+
+    // Índice i como 32 bits, independente da largura armazenada (exige HasCPUData())
+    unsigned int GetIndex(size_t i) const {
+        return indexType == GL_UNSIGNED_SHORT ? indices16[i] : indices[i];
+    }
+
+    size_t GetCPUDataSize() const {
+        if (!hasCPUData) return 0;
+        return vertices.size() * sizeof(Vertex) + indices.size() * sizeof(unsigned int) +
+               indices16.size() * sizeof(uint16_t);
+    }
+
+    const AABB& GetBounds() const { return bounds; }
+
     unsigned int GetVAO() const { return VAO; }
-    unsigned int GetIndexCount() const { return indices.size(); }
+    uint32_t GetSortID() const { return sortID; }
+    // Posição da mesh nos buffers compartilhados (0 quando tem buffers próprios)
+    bool IsInArena() const { return arena.IsValid(); }
+    GLint GetBaseVertex() const { return static_cast<GLint>(arena.baseVertex); }
+    uint32_t GetFirstIndex() const { return arena.firstIndex; }
+    size_t GetVertexCount() const { return vertexCount; }
+    // Índices do LOD 0; o buffer pode conter mais (ver GetLOD)
+    unsigned int GetIndexCount() const { return lods[0].indexCount; }
+    size_t GetTotalIndexCount() const { return indexCount; }
+
+    // Define as faixas de LOD dentro do index buffer já enviado
+    void SetLODs(const std::vector<MeshLOD>& levels) {
+        if (levels.empty()) return;
+        for (const auto& lod : levels) {
+            if (size_t(lod.indexOffset) + lod.indexCount > indexCount) return;
+        }
+        lods = levels;
+    }
+
+    size_t GetLODCount() const { return lods.size(); }
+    const MeshLOD& GetLOD(size_t level) const { return lods[std::min(level, lods.size() - 1)]; }
+    GLenum GetIndexType() const { return indexType; }
+    size_t GetIndexSize() const { return indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int); }
+    size_t GetIndexBufferSize() const { return indexCount * GetIndexSize(); }
+
+    // Índice máximo 65535 (sem primitive restart)
+    static bool FitsUInt16(size_t vertexCount) { return vertexCount <= 65536; }
+
+    static MeshMemoryStats& GetMemoryStats() {
+        static MeshMemoryStats stats;
+        return stats;
+    }
+    VertexFormat GetVertexFormat() const { return format; }
+    bool IsPacked() const { return format == VertexFormat::Packed; }
+
+    // Tamanho do VBO na GPU e quanto ele ocuparia no formato Standard
+    size_t GetVertexBufferSize() const { return vertexCount * GetVertexStride(format); }
+    size_t GetStandardVertexBufferSize() const { return vertexCount * sizeof(Vertex); }
 
     // Material management
     void SetMaterial(std::shared_ptr<Material> mat) {
@@ -119,31 +418,56 @@ public:
         : vertices(std::move(other.vertices)),
           indices(std::move(other.indices)),
           material(std::move(other.material)),
+          format(other.format),
+          indexType(other.indexType),
+          indices16(std::move(other.indices16)),
+          tracked(other.tracked),
+          vertexCount(other.vertexCount),
+          indexCount(other.indexCount),
+          lods(std::move(other.lods)),
+          bounds(other.bounds),
+          hasCPUData(other.hasCPUData),
+          arena(other.arena),
+          sortID(other.sortID),
           VAO(other.VAO), VBO(other.VBO), EBO(other.EBO) {
+        other.arena = GeometryArena::Allocation();
         other.VAO = 0;
         other.VBO = 0;
         other.EBO = 0;
+        other.tracked = false;
     }
 
     Mesh& operator=(Mesh&& other) noexcept {
         if (this != &other) {
-            glDeleteVertexArrays(1, &VAO);
-            glDeleteBuffers(1, &VBO);
-            glDeleteBuffers(1, &EBO);
+            trackMemory(false);
+            releaseBuffers();
 
             vertices = std::move(other.vertices);
             indices = std::move(other.indices);
             material = std::move(other.material);
+            format = other.format;
+            indexType = other.indexType;
+            indices16 = std::move(other.indices16);
+            tracked = other.tracked;
+            vertexCount = other.vertexCount;
+            indexCount = other.indexCount;
+            lods = std::move(other.lods);
+            bounds = other.bounds;
+            hasCPUData = other.hasCPUData;
+            arena = other.arena;
+            sortID = other.sortID;
             VAO = other.VAO;
             VBO = other.VBO;
             EBO = other.EBO;
 
+            other.arena = GeometryArena::Allocation();
             other.VAO = 0;
             other.VBO = 0;
             other.EBO = 0;
+            other.tracked = false;
         }
         return *this;
     }
 };
 
-#endif // MESH_HPP
\ No newline at end of file
+#endif // MESH_HPP
@@ -0,0 +1,373 @@
+#ifndef MESH_CACHE_HPP
+#define MESH_CACHE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "mesh.hpp"
+#include "material.hpp"
+#include "model_data.hpp"
+#include "../core/hash.hpp"
+#include "../core/filesystem.hpp"
+
+/**
+ * @brief Cache binário de meshes já processadas pelo Assimp.
+ *
+ * Layout do arquivo (.omc), tudo alinhado em 4 bytes:
+ *   FileHeader
+ *   string  sourcePath
+ *   blobs   [index, size, bytes]           (texturas embutidas "*N" do GLB)
+ *   meshes  [material, texturas, vertices, indices, lods]
+ *
+ * O arquivo é mapeado em memória na leitura: os arrays de Vertex e de
+ * índices são usados direto do mapeamento para o upload na GPU.
+ */
+namespace MeshCache {
+
+constexpr uint32_t VERSION = 2; // 2: faixas de LOD por mesh
+constexpr char MAGIC[8] = { 'O', 'G', 'L', 'M', 'E', 'S', 'H', '\0' };
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t importFlags;
+    int64_t sourceMtime;
+    uint64_t sourceSize;
+    uint32_t vertexStride;
+    uint32_t meshCount;
+    uint32_t blobCount;
+    uint32_t optionFlags; // processamento feito após o Assimp (ex: otimização); 0 = nenhum
+};
+
+// Identifica uma importação: mesmo arquivo, mesma data, mesmas flags do Assimp e do pós-processamento
+struct Key {
+    std::string sourcePath;
+    int64_t sourceMtime = 0;
+    uint64_t sourceSize = 0;
+    uint32_t importFlags = 0;
+    uint32_t optionFlags = 0;
+};
+
+struct TextureRef {
+    TextureType type;
+    std::string path; // "*N" => blob embutido N
+};
+
+struct MeshRecord {
+    std::string materialName;
+    MaterialProperties properties;
+    std::vector<TextureRef> textures;
+
+    const Vertex* vertices = nullptr;
+    uint32_t vertexCount = 0;
+    const unsigned int* indices = nullptr;
+    uint32_t indexCount = 0;
+    std::vector<MeshLOD> lods;
+};
+
+struct BlobRecord {
+    uint32_t index = 0;
+    const unsigned char* data = nullptr;
+    uint32_t size = 0;
+};
+
+inline bool MakeKey(const std::string& sourcePath, uint32_t importFlags, Key& key, uint32_t optionFlags = 0) {
+    std::error_code ec;
+    auto mtime = fs::last_write_time(sourcePath, ec);
+    if (ec) return false;
+    auto size = fs::file_size(sourcePath, ec);
+    if (ec) return false;
+
+    key.sourcePath = sourcePath;
+    key.sourceMtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    key.sourceSize = static_cast<uint64_t>(size);
+    key.importFlags = importFlags;
+    key.optionFlags = optionFlags;
+    return true;
+}
+
+inline std::string GetCacheDirectory() {
+    return (fs::path(FS::GetRoot()) / ".cache" / "meshes").string();
+}
+
+// Um arquivo por caminho de origem; data e flags são validadas no header
+inline std::string GetCachePath(const Key& key) {
+    return GetCacheDirectory() + "/" + Hash::ToHex(Hash::FNV1a(key.sourcePath)) + ".omc";
+}
+
+/**
+ * @brief Arquivo somente-leitura mapeado em memória (RAII).
+ */
+class MappedFile {
+private:
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    std::vector<unsigned char> buffer;
+#endif
+
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    bool Open(const std::string& path) {
+        Close();
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        size = buffer.size();
+        return size > 0;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            close(fd);
+            return false;
+        }
+
+        void* ptr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (ptr == MAP_FAILED) return false;
+
+        data = static_cast<const unsigned char*>(ptr);
+        size = static_cast<size_t>(st.st_size);
+        return true;
+#endif
+    }
+
+    void Close() {
+#ifdef _WIN32
+        buffer.clear();
+#else
+        if (data) munmap(const_cast<unsigned char*>(data), size);
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    const unsigned char* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+    bool IsOpen() const { return data != nullptr; }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+/**
+ * @brief Leitura do cache. Os ponteiros dos records apontam para dentro do
+ * mapeamento e só valem enquanto o Reader estiver vivo.
+ */
+class Reader {
+private:
+    MappedFile file;
+    size_t cursor = 0;
+
+    bool read(void* dst, size_t bytes) {
+        if (cursor + bytes > file.GetSize()) return false;
+        std::memcpy(dst, file.GetData() + cursor, bytes);
+        cursor += bytes;
+        return true;
+    }
+
+    const unsigned char* view(size_t bytes) {
+        if (cursor + bytes > file.GetSize()) return nullptr;
+        const unsigned char* ptr = file.GetData() + cursor;
+        cursor += (bytes + 3) & ~size_t(3);
+        return ptr;
+    }
+
+    bool readU32(uint32_t& value) { return read(&value, sizeof(value)); }
+
+    bool readString(std::string& out) {
+        uint32_t length;
+        if (!readU32(length)) return false;
+        const unsigned char* ptr = view(length);
+        if (!ptr && length > 0) return false;
+        out.assign(reinterpret_cast<const char*>(ptr), length);
+        return true;
+    }
+
+public:
+    std::vector<MeshRecord> meshes;
+    std::vector<BlobRecord> blobs;
+
+    bool Open(const Key& key) {
+        if (!file.Open(GetCachePath(key))) return false;
+
+        cursor = 0;
+        meshes.clear();
+        blobs.clear();
+
+        FileHeader header;
+        if (!read(&header, sizeof(header))) return false;
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) return false;
+        if (header.version != VERSION) return false;
+        if (header.vertexStride != sizeof(Vertex)) return false;
+        if (header.importFlags != key.importFlags) return false;
+        if (header.optionFlags != key.optionFlags) return false;
+        if (header.sourceMtime != key.sourceMtime) return false;
+        if (header.sourceSize != key.sourceSize) return false;
+
+        std::string sourcePath;
+        if (!readString(sourcePath) || sourcePath != key.sourcePath) return false;
+
+        blobs.resize(header.blobCount);
+        for (auto& blob : blobs) {
+            if (!readU32(blob.index) || !readU32(blob.size)) return false;
+            blob.data = view(blob.size);
+            if (!blob.data) return false;
+        }
+
+        meshes.resize(header.meshCount);
+        for (auto& mesh : meshes) {
+            if (!readString(mesh.materialName)) return false;
+            if (!read(&mesh.properties, sizeof(MaterialProperties))) return false;
+
+            uint32_t textureCount;
+            if (!readU32(textureCount)) return false;
+            mesh.textures.resize(textureCount);
+            for (auto& tex : mesh.textures) {
+                uint32_t type;
+                if (!readU32(type) || !readString(tex.path)) return false;
+                tex.type = static_cast<TextureType>(type);
+            }
+
+            if (!readU32(mesh.vertexCount) || !readU32(mesh.indexCount)) return false;
+            mesh.vertices = reinterpret_cast<const Vertex*>(view(size_t(mesh.vertexCount) * sizeof(Vertex)));
+            mesh.indices = reinterpret_cast<const unsigned int*>(view(size_t(mesh.indexCount) * sizeof(unsigned int)));
+            if (!mesh.vertices || !mesh.indices) return false;
+
+            uint32_t lodCount;
+            if (!readU32(lodCount)) return false;
+            mesh.lods.resize(lodCount);
+            if (lodCount > 0 && !read(mesh.lods.data(), lodCount * sizeof(MeshLOD))) return false;
+        }
+
+        return true;
+    }
+
+    const BlobRecord* FindBlob(uint32_t index) const {
+        for (const auto& blob : blobs) {
+            if (blob.index == index) return &blob;
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * @brief Escrita do cache. Grava num arquivo temporário e renomeia no final
+ * para que uma leitura concorrente nunca veja um arquivo pela metade.
+ */
+class Writer {
+private:
+    std::ofstream out;
+
+    void write(const void* src, size_t bytes) {
+        out.write(static_cast<const char*>(src), bytes);
+        static const char zeros[4] = { 0, 0, 0, 0 };
+        size_t pad = ((bytes + 3) & ~size_t(3)) - bytes;
+        if (pad) out.write(zeros, pad);
+    }
+
+    void writeU32(uint32_t value) { write(&value, sizeof(value)); }
+
+    void writeString(const std::string& str) {
+        writeU32(static_cast<uint32_t>(str.size()));
+        write(str.data(), str.size());
+    }
+
+public:
+    struct Blob {
+        uint32_t index;
+        const void* data;
+        uint32_t size;
+    };
+
+    bool Write(const Key& key, const std::vector<MeshData>& meshes, const std::vector<Blob>& blobs) {
+        std::error_code ec;
+        fs::create_directories(GetCacheDirectory(), ec);
+
+        std::string finalPath = GetCachePath(key);
+        std::string tempPath = finalPath + ".tmp";
+
+        out.open(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "[MeshCache] Não foi possível criar: " << tempPath << std::endl;
+            return false;
+        }
+
+        FileHeader header = {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.importFlags = key.importFlags;
+        header.sourceMtime = key.sourceMtime;
+        header.sourceSize = key.sourceSize;
+        header.vertexStride = sizeof(Vertex);
+        header.meshCount = static_cast<uint32_t>(meshes.size());
+        header.blobCount = static_cast<uint32_t>(blobs.size());
+        header.optionFlags = key.optionFlags;
+        write(&header, sizeof(header));
+
+        writeString(key.sourcePath);
+
+        for (const auto& blob : blobs) {
+            writeU32(blob.index);
+            writeU32(blob.size);
+            write(blob.data, blob.size);
+        }
+
+        for (const auto& mesh : meshes) {
+            writeString(mesh.material.name);
+            write(&mesh.material.properties, sizeof(MaterialProperties));
+
+            writeU32(static_cast<uint32_t>(mesh.material.textures.size()));
+            for (const auto& tex : mesh.material.textures) {
+                writeU32(static_cast<uint32_t>(tex.type));
+                writeString(tex.path);
+            }
+
+            writeU32(static_cast<uint32_t>(mesh.GetVertexCount()));
+            writeU32(static_cast<uint32_t>(mesh.GetIndexCount()));
+            write(mesh.GetVertices(), mesh.GetVertexCount() * sizeof(Vertex));
+            write(mesh.GetIndices(), mesh.GetIndexCount() * sizeof(unsigned int));
+
+            writeU32(static_cast<uint32_t>(mesh.lods.size()));
+            if (!mesh.lods.empty()) write(mesh.lods.data(), mesh.lods.size() * sizeof(MeshLOD));
+        }
+
+        out.close();
+        if (!out) {
+            fs::remove(tempPath, ec);
+            return false;
+        }
+
+        fs::rename(tempPath, finalPath, ec);
+        if (ec) {
+            fs::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+};
+
+} // namespace MeshCache
+
+#endif // MESH_CACHE_HPP
@@ -0,0 +1,343 @@
+#ifndef MESH_OPTIMIZER_HPP
+#define MESH_OPTIMIZER_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <glm/glm.hpp>
+
+#include "vertex_format.hpp"
+
+/**
+ * @brief Reordenação de malhas indexadas para a GPU.
+ *
+ * Optimize() aplica, em ordem:
+ *  1. OptimizeVertexCache: ordem dos triângulos para o cache pós-transformação (Forsyth)
+ *  2. OptimizeOverdraw:    ordem dos clusters de triângulos de fora para dentro (estilo Tipsify),
+ *                          aceita só se o ACMR não piorar mais que o limiar
+ *  3. OptimizeVertexFetch: renumera os vértices pela ordem de primeiro uso
+ *
+ * Só reordena: o resultado desenha exatamente os mesmos triângulos.
+ */
+namespace MeshOptimizer {
+
+struct CacheStats {
+    float acmr = 0.0f; // vértices transformados por triângulo (ideal ~0.5, pior 3.0)
+    float atvr = 0.0f; // vértices transformados por vértice único (ideal 1.0)
+};
+
+/**
+ * @brief Simula um cache FIFO de vértices transformados.
+ */
+inline CacheStats AnalyzeVertexCache(const unsigned int* indices, size_t indexCount,
+                                     size_t vertexCount, unsigned int cacheSize = 16) {
+    CacheStats stats;
+    if (indexCount < 3 || vertexCount == 0) return stats;
+
+    // timestamp do momento em que o vértice entrou no cache
+    std::vector<unsigned int> timestamps(vertexCount, 0);
+    std::vector<bool> used(vertexCount, false);
+    unsigned int time = cacheSize + 1;
+    size_t misses = 0;
+    size_t unique = 0;
+
+    for (size_t i = 0; i < indexCount; i++) {
+        unsigned int v = indices[i];
+        if (time - timestamps[v] > cacheSize) {
+            timestamps[v] = time++;
+            misses++;
+        }
+        if (!used[v]) {
+            used[v] = true;
+            unique++;
+        }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+    stats.atvr = unique ? static_cast<float>(misses) / static_cast<float>(unique) : 0.0f;
+    return stats;
+}
+
+namespace detail {
+
+constexpr int ForsythCacheSize = 32;
+
+inline float forsythVertexScore(int cachePosition, unsigned int liveTriangles) {
+    const float cacheDecayPower = 1.5f;
+    const float lastTriangleScore = 0.75f;
+    const float valenceBoostScale = 2.0f;
+    const float valenceBoostPower = 0.5f;
+
+    if (liveTriangles == 0) return -1.0f; // nada mais usa este vértice
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // Vértices do último triângulo: valor fixo para não favorecer repetir o mesmo
+            score = lastTriangleScore;
+        } else {
+            const float scaler = 1.0f / (ForsythCacheSize - 3);
+            score = 1.0f - (cachePosition - 3) * scaler;
+            score = std::pow(score, cacheDecayPower);
+        }
+    }
+
+    // Vértices com poucos triângulos restantes ganham prioridade para sair logo do caminho
+    score += valenceBoostScale * std::pow(static_cast<float>(liveTriangles), -valenceBoostPower);
+    return score;
+}
+
+} // namespace detail
+
+/**
+ * @brief Reordena os triângulos para localidade no cache de vértices (Forsyth, "Linear-Speed
+ * Vertex Cache Optimisation"). Cache LRU simulado de 32 entradas.
+ */
+inline void OptimizeVertexCache(unsigned int* indices, size_t indexCount, size_t vertexCount) {
+    using namespace detail;
+
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || vertexCount == 0) return;
+
+    // Adjacência vértice -> triângulos (CSR)
+    std::vector<unsigned int> liveTriangles(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; i++) liveTriangles[indices[i]]++;
+
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) offsets[v + 1] = offsets[v] + liveTriangles[v];
+
+    std::vector<unsigned int> adjacency(triangleCount * 3);
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++) adjacency[fill[indices[t * 3 + k]]++] = static_cast<unsigned int>(t);
+    }
+
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) vertexScore[v] = forsythVertexScore(-1, liveTriangles[v]);
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<unsigned int> output;
+    output.reserve(triangleCount * 3);
+
+    std::vector<unsigned int> cache;
+    std::vector<unsigned int> newCache;
+    cache.reserve(ForsythCacheSize + 3);
+    newCache.reserve(ForsythCacheSize + 3);
+
+    size_t inputCursor = 0; // próximo triângulo não emitido na ordem original
+    long bestTriangle = -1;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+        if (bestTriangle < 0) {
+            // Sem candidato no cache: recomeça pelo primeiro triângulo ainda não emitido
+            while (emitted[inputCursor]) inputCursor++;
+            bestTriangle = static_cast<long>(inputCursor);
+        }
+
+        unsigned int tri = static_cast<unsigned int>(bestTriangle);
+        const unsigned int* triIndices = &indices[tri * 3];
+        output.insert(output.end(), triIndices, triIndices + 3);
+        emitted[tri] = true;
+
+        // Remove o triângulo da adjacência dos seus vértices
+        for (int k = 0; k < 3; k++) {
+            unsigned int v = triIndices[k];
+            unsigned int* begin = &adjacency[offsets[v]];
+            unsigned int* end = begin + liveTriangles[v];
+            unsigned int* it = std::find(begin, end, tri);
+            if (it != end) {
+                *it = *(end - 1);
+                liveTriangles[v]--;
+            }
+        }
+
+        // Atualiza o cache LRU: vértices do triângulo vão para a frente
+        newCache.clear();
+        newCache.insert(newCache.end(), triIndices, triIndices + 3);
+        for (unsigned int v : cache) {
+            if (v != triIndices[0] && v != triIndices[1] && v != triIndices[2]) newCache.push_back(v);
+        }
+
+        // Vértices que saíram do cache perdem a pontuação de cache
+        for (size_t i = ForsythCacheSize; i < newCache.size(); i++) {
+            vertexScore[newCache[i]] = forsythVertexScore(-1, liveTriangles[newCache[i]]);
+        }
+        if (newCache.size() > static_cast<size_t>(ForsythCacheSize)) newCache.resize(ForsythCacheSize);
+        cache.swap(newCache);
+
+        for (size_t i = 0; i < cache.size(); i++) {
+            unsigned int v = cache[i];
+            vertexScore[v] = forsythVertexScore(static_cast<int>(i), liveTriangles[v]);
+        }
+
+        // Recalcula os triângulos vizinhos do cache e escolhe o melhor
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (unsigned int v : cache) {
+            for (unsigned int a = 0; a < liveTriangles[v]; a++) {
+                unsigned int t = adjacency[offsets[v] + a];
+                float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] +
+                              vertexScore[indices[t * 3 + 2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = static_cast<long>(t);
+                }
+            }
+        }
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+/**
+ * @brief Reordena clusters de triângulos para reduzir overdraw: clusters voltados para fora do
+ * centro do modelo são desenhados primeiro, ocultando o que está atrás deles.
+ *
+ * Os clusters são cortados onde a simulação de cache encontra um triângulo com 3 misses,
+ * preservando a localidade obtida por OptimizeVertexCache. O resultado só é aceito se o
+ * ACMR final for no máximo threshold * ACMR original.
+ */
+inline void OptimizeOverdraw(unsigned int* indices, size_t indexCount,
+                             const Vertex* vertices, size_t vertexCount, float threshold = 1.05f) {
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || vertexCount == 0) return;
+
+    const unsigned int cacheSize = 16;
+    CacheStats before = AnalyzeVertexCache(indices, indexCount, vertexCount, cacheSize);
+
+    // 1. Fronteiras dos clusters
+    std::vector<size_t> clusterStart;
+    {
+        std::vector<unsigned int> timestamps(vertexCount, 0);
+        unsigned int time = cacheSize + 1;
+        for (size_t t = 0; t < triangleCount; t++) {
+            int misses = 0;
+            for (int k = 0; k < 3; k++) {
+                unsigned int v = indices[t * 3 + k];
+                if (time - timestamps[v] > cacheSize) {
+                    timestamps[v] = time++;
+                    misses++;
+                }
+            }
+            if (t == 0 || misses == 3) clusterStart.push_back(t);
+        }
+    }
+    if (clusterStart.size() < 2) return;
+    clusterStart.push_back(triangleCount);
+
+    // 2. Centroide do modelo ponderado por área
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < triangleCount; t++) {
+        const glm::vec3& p0 = vertices[indices[t * 3]].Position;
+        const glm::vec3& p1 = vertices[indices[t * 3 + 1]].Position;
+        const glm::vec3& p2 = vertices[indices[t * 3 + 2]].Position;
+        float area = glm::length(glm::cross(p1 - p0, p2 - p0));
+        meshCentroid += (p0 + p1 + p2) * (area / 3.0f);
+        meshArea += area;
+    }
+    if (meshArea > 0.0f) meshCentroid /= meshArea;
+
+    // 3. Chave de ordenação de cada cluster: quanto ele aponta para fora do centro
+    size_t clusterCount = clusterStart.size() - 1;
+    std::vector<float> sortKey(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++) {
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = clusterStart[c]; t < clusterStart[c + 1]; t++) {
+            const glm::vec3& p0 = vertices[indices[t * 3]].Position;
+            const glm::vec3& p1 = vertices[indices[t * 3 + 1]].Position;
+            const glm::vec3& p2 = vertices[indices[t * 3 + 2]].Position;
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            float a = glm::length(n);
+            centroid += (p0 + p1 + p2) * (a / 3.0f);
+            normal += n;
+            area += a;
+        }
+        if (area > 0.0f) centroid /= area;
+        float length = glm::length(normal);
+        if (length > 0.0f) normal /= length;
+        sortKey[c] = glm::dot(centroid - meshCentroid, normal);
+    }
+
+    std::vector<size_t> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++) order[c] = c;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKey[a] > sortKey[b]; });
+
+    std::vector<unsigned int> result;
+    result.reserve(indexCount);
+    for (size_t c : order) {
+        result.insert(result.end(), indices + clusterStart[c] * 3, indices + clusterStart[c + 1] * 3);
+    }
+
+    CacheStats after = AnalyzeVertexCache(result.data(), result.size(), vertexCount, cacheSize);
+    if (after.acmr <= before.acmr * threshold) {
+        std::copy(result.begin(), result.end(), indices);
+    }
+}
+
+/**
+ * @brief Renumera os vértices pela ordem em que aparecem nos índices. Vértices não
+ * referenciados são descartados. Retorna o novo número de vértices.
+ */
+inline size_t OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    const unsigned int unused = ~0u;
+    std::vector<unsigned int> remap(vertices.size(), unused);
+    std::vector<Vertex> reordered;
+    reordered.reserve(vertices.size());
+
+    for (auto& index : indices) {
+        if (remap[index] == unused) {
+            remap[index] = static_cast<unsigned int>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    vertices.swap(reordered);
+    return vertices.size();
+}
+
+struct Report {
+    CacheStats before;
+    CacheStats after;
+    size_t verticesBefore = 0;
+    size_t verticesAfter = 0;
+    double ms = 0.0;
+
+    void Print(const std::string& name) const {
+        std::cout << "  Otimização " << name << ": ACMR " << before.acmr << " -> " << after.acmr
+                  << ", ATVR " << before.atvr << " -> " << after.atvr;
+        if (verticesAfter != verticesBefore) {
+            std::cout << ", vértices " << verticesBefore << " -> " << verticesAfter;
+        }
+        std::cout << " (" << ms << " ms)" << std::endl;
+    }
+};
+
+// Pipeline completo: cache de vértices, overdraw e ordem de fetch
+inline Report Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    auto start = std::chrono::steady_clock::now();
+
+    Report report;
+    report.verticesBefore = vertices.size();
+    report.before = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+
+    OptimizeVertexCache(indices.data(), indices.size(), vertices.size());
+    OptimizeOverdraw(indices.data(), indices.size(), vertices.data(), vertices.size());
+    OptimizeVertexFetch(vertices, indices);
+
+    report.after = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+    report.verticesAfter = vertices.size();
+    report.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+} // namespace MeshOptimizer
+
+#endif // MESH_OPTIMIZER_HPP
@@ -0,0 +1,334 @@
+#ifndef MESH_SIMPLIFIER_HPP
+#define MESH_SIMPLIFIER_HPP
+
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <glm/glm.hpp>
+
+#include "mesh.hpp"
+#include "mesh_optimizer.hpp"
+
+/**
+ * @brief Simplificação de malhas por colapso de arestas com métrica de erro quádrica
+ * (Garland & Heckbert).
+ *
+ * O colapso é "half-edge": um vértice é movido para cima de um vizinho existente, então
+ * nenhum vértice novo é criado. Todos os LODs usam o mesmo vertex buffer e só mudam os
+ * índices, que ficam concatenados num único index buffer (ver MeshLOD).
+ *
+ * Vértices de borda e de costura (mesma posição, atributos diferentes, ex: UV seams)
+ * ficam travados: podem receber colapsos, mas nunca se movem. Isso evita buracos e
+ * rasgos na textura ao custo de simplificar menos perto dessas regiões.
+ */
+namespace MeshSimplifier {
+
+namespace detail {
+
+// Matriz 4x4 simétrica (a b c d / e f g / h i / j) mais a soma dos pesos
+struct Quadric {
+    double a = 0, b = 0, c = 0, d = 0, e = 0, f = 0, g = 0, h = 0, i = 0, j = 0;
+    double weight = 0;
+
+    static Quadric FromPlane(double nx, double ny, double nz, double dist, double weight) {
+        Quadric q;
+        q.a = nx * nx * weight; q.b = nx * ny * weight; q.c = nx * nz * weight; q.d = nx * dist * weight;
+        q.e = ny * ny * weight; q.f = ny * nz * weight; q.g = ny * dist * weight;
+        q.h = nz * nz * weight; q.i = nz * dist * weight;
+        q.j = dist * dist * weight;
+        q.weight = weight;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& o) {
+        a += o.a; b += o.b; c += o.c; d += o.d; e += o.e;
+        f += o.f; g += o.g; h += o.h; i += o.i; j += o.j;
+        weight += o.weight;
+        return *this;
+    }
+
+    // v^T Q v / peso, com v = (x, y, z, 1): distância quadrática média aos planos
+    double Evaluate(const glm::vec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        double error = a * x * x + 2 * b * x * y + 2 * c * x * z + 2 * d * x +
+                       e * y * y + 2 * f * y * z + 2 * g * y +
+                       h * z * z + 2 * i * z + j;
+        return weight > 0 ? error / weight : 0.0;
+    }
+};
+
+struct Collapse {
+    double cost;
+    unsigned int from;
+    unsigned int to;
+    unsigned int fromVersion;
+    unsigned int toVersion;
+
+    bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+struct PositionHash {
+    size_t operator()(const glm::vec3& p) const {
+        uint32_t bits[3];
+        std::memcpy(bits, &p, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+struct PositionEqual {
+    bool operator()(const glm::vec3& a, const glm::vec3& b) const {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+};
+
+inline glm::vec3 triangleNormal(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2) {
+    return glm::cross(p1 - p0, p2 - p0);
+}
+
+} // namespace detail
+
+/**
+ * @brief Simplifica até targetIndexCount índices ou até o erro passar de maxError.
+ * @param maxError erro máximo relativo ao tamanho do modelo (diagonal do AABB)
+ * @param outIndices índices do resultado, referenciando os mesmos vértices
+ * @return erro atingido, relativo ao tamanho do modelo
+ */
+inline float Simplify(const Vertex* vertices, size_t vertexCount,
+                      const unsigned int* indices, size_t indexCount,
+                      size_t targetIndexCount, float maxError,
+                      std::vector<unsigned int>& outIndices) {
+    using namespace detail;
+
+    outIndices.assign(indices, indices + indexCount);
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || targetIndexCount >= indexCount) return 0.0f;
+
+    AABB bounds = AABB::FromVertices(vertices, vertexCount);
+    double scale = glm::length(bounds.max - bounds.min);
+    if (scale <= 0.0) return 0.0f;
+    double maxCost = (maxError * scale) * (maxError * scale);
+
+    std::vector<unsigned int>& tri = outIndices;
+    std::vector<bool> triAlive(triangleCount, true);
+    size_t aliveTriangles = triangleCount;
+
+    // 1. Soldar posições: grupos com mais de um vértice são costuras
+    std::unordered_map<glm::vec3, unsigned int, PositionHash, PositionEqual> positionIds;
+    std::vector<unsigned int> weld(vertexCount);
+    std::vector<unsigned int> weldCount;
+    for (size_t v = 0; v < vertexCount; v++) {
+        auto it = positionIds.emplace(vertices[v].Position, static_cast<unsigned int>(weldCount.size()));
+        if (it.second) weldCount.push_back(0);
+        weld[v] = it.first->second;
+        weldCount[weld[v]]++;
+    }
+
+    std::vector<bool> locked(vertexCount, false);
+    for (size_t v = 0; v < vertexCount; v++) {
+        if (weldCount[weld[v]] > 1) locked[v] = true;
+    }
+
+    // 2. Bordas: aresta (soldada) usada por só um triângulo
+    {
+        std::unordered_map<uint64_t, unsigned int> edgeUse;
+        edgeUse.reserve(indexCount);
+        auto edgeKey = [&](unsigned int a, unsigned int b) {
+            unsigned int wa = weld[a], wb = weld[b];
+            if (wa > wb) std::swap(wa, wb);
+            return (static_cast<uint64_t>(wa) << 32) | wb;
+        };
+        for (size_t t = 0; t < triangleCount; t++) {
+            for (int k = 0; k < 3; k++) edgeUse[edgeKey(tri[t * 3 + k], tri[t * 3 + (k + 1) % 3])]++;
+        }
+        for (size_t t = 0; t < triangleCount; t++) {
+            for (int k = 0; k < 3; k++) {
+                unsigned int a = tri[t * 3 + k], b = tri[t * 3 + (k + 1) % 3];
+                if (edgeUse[edgeKey(a, b)] == 1) {
+                    locked[a] = true;
+                    locked[b] = true;
+                }
+            }
+        }
+    }
+
+    // 3. Quádricas por vértice e adjacência vértice -> triângulos
+    std::vector<Quadric> quadrics(vertexCount);
+    std::vector<std::vector<unsigned int>> vertexTriangles(vertexCount);
+    for (size_t t = 0; t < triangleCount; t++) {
+        const glm::vec3& p0 = vertices[tri[t * 3]].Position;
+        const glm::vec3& p1 = vertices[tri[t * 3 + 1]].Position;
+        const glm::vec3& p2 = vertices[tri[t * 3 + 2]].Position;
+        glm::vec3 n = triangleNormal(p0, p1, p2);
+        double area = glm::length(n);
+        if (area > 0.0) {
+            double nx = n.x / area, ny = n.y / area, nz = n.z / area;
+            double dist = -(nx * p0.x + ny * p0.y + nz * p0.z);
+            Quadric q = Quadric::FromPlane(nx, ny, nz, dist, area * 0.5);
+            for (int k = 0; k < 3; k++) quadrics[tri[t * 3 + k]] += q;
+        }
+        for (int k = 0; k < 3; k++) vertexTriangles[tri[t * 3 + k]].push_back(static_cast<unsigned int>(t));
+    }
+
+    // 4. Fila de colapsos com invalidação preguiçosa por versão
+    std::vector<unsigned int> version(vertexCount, 0);
+    std::vector<bool> removed(vertexCount, false);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+    auto pushCollapse = [&](unsigned int from, unsigned int to) {
+        if (locked[from] || from == to) return;
+        Quadric q = quadrics[from];
+        q += quadrics[to];
+        double cost = std::max(0.0, q.Evaluate(vertices[to].Position));
+        heap.push({ cost, from, to, version[from], version[to] });
+    };
+
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++) {
+            unsigned int a = tri[t * 3 + k], b = tri[t * 3 + (k + 1) % 3];
+            pushCollapse(a, b);
+            pushCollapse(b, a);
+        }
+    }
+
+    double achievedCost = 0.0;
+    size_t targetTriangles = targetIndexCount / 3;
+    std::vector<unsigned int> neighbors;
+
+    while (aliveTriangles > targetTriangles && !heap.empty()) {
+        Collapse c = heap.top();
+        heap.pop();
+
+        if (removed[c.from] || removed[c.to]) continue;
+        if (c.fromVersion != version[c.from] || c.toVersion != version[c.to]) continue;
+        if (c.cost > maxCost) break;
+
+        const glm::vec3& target = vertices[c.to].Position;
+
+        // Rejeita colapsos que invertem algum triângulo
+        bool flips = false;
+        for (unsigned int t : vertexTriangles[c.from]) {
+            if (!triAlive[t]) continue;
+            unsigned int* ti = &tri[t * 3];
+            if (ti[0] == c.to || ti[1] == c.to || ti[2] == c.to) continue;
+
+            glm::vec3 p[3] = { vertices[ti[0]].Position, vertices[ti[1]].Position, vertices[ti[2]].Position };
+            glm::vec3 before = triangleNormal(p[0], p[1], p[2]);
+            for (int k = 0; k < 3; k++) {
+                if (ti[k] == c.from) p[k] = target;
+            }
+            glm::vec3 after = triangleNormal(p[0], p[1], p[2]);
+            if (glm::dot(before, after) <= 0.0f) {
+                flips = true;
+                break;
+            }
+        }
+        if (flips) continue;
+
+        // Aplica: triângulos com as duas pontas somem, os outros passam a usar "to"
+        for (unsigned int t : vertexTriangles[c.from]) {
+            if (!triAlive[t]) continue;
+            unsigned int* ti = &tri[t * 3];
+            if (ti[0] == c.to || ti[1] == c.to || ti[2] == c.to) {
+                triAlive[t] = false;
+                aliveTriangles--;
+                continue;
+            }
+            for (int k = 0; k < 3; k++) {
+                if (ti[k] == c.from) ti[k] = c.to;
+            }
+            vertexTriangles[c.to].push_back(t);
+        }
+
+        removed[c.from] = true;
+        quadrics[c.to] += quadrics[c.from];
+        version[c.to]++;
+        achievedCost = std::max(achievedCost, c.cost);
+
+        // Reavalia as arestas em volta de "to"
+        neighbors.clear();
+        auto& toTriangles = vertexTriangles[c.to];
+        size_t write = 0;
+        for (size_t r = 0; r < toTriangles.size(); r++) {
+            unsigned int t = toTriangles[r];
+            if (!triAlive[t]) continue;
+            toTriangles[write++] = t;
+            for (int k = 0; k < 3; k++) {
+                unsigned int n = tri[t * 3 + k];
+                if (n != c.to) neighbors.push_back(n);
+            }
+        }
+        toTriangles.resize(write);
+
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        for (unsigned int n : neighbors) {
+            pushCollapse(n, c.to);
+            pushCollapse(c.to, n);
+        }
+    }
+
+    // Compacta os triângulos vivos
+    size_t write = 0;
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (!triAlive[t]) continue;
+        for (int k = 0; k < 3; k++) tri[write * 3 + k] = tri[t * 3 + k];
+        write++;
+    }
+    tri.resize(write * 3);
+
+    return static_cast<float>(std::sqrt(achievedCost) / scale);
+}
+
+/**
+ * @brief Gera a cadeia de LODs de uma malha.
+ *
+ * Os índices de cada LOD são anexados ao final de indices. O LOD 0 é a malha original.
+ * O erro de cada MeshLOD é guardado em unidades do objeto, para o Renderer converter
+ * em pixels na tela.
+ *
+ * @param reduction fração de triângulos mantida de um nível para o próximo
+ * @param maxError erro máximo relativo ao tamanho do modelo; a cadeia para ao atingi-lo
+ */
+inline std::vector<MeshLOD> GenerateLODs(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                         int extraLevels, float reduction = 0.5f, float maxError = 0.05f) {
+    std::vector<MeshLOD> lods;
+    lods.push_back({ 0, static_cast<uint32_t>(indices.size()), 0.0f });
+    if (extraLevels <= 0 || indices.size() < 3) return lods;
+
+    AABB bounds = AABB::FromVertices(vertices.data(), vertices.size());
+    float scale = glm::length(bounds.max - bounds.min);
+
+    std::vector<unsigned int> previous(indices.begin(), indices.end());
+    std::vector<unsigned int> simplified;
+
+    for (int level = 1; level <= extraLevels; level++) {
+        size_t target = static_cast<size_t>(previous.size() * reduction) / 3 * 3;
+        float error = Simplify(vertices.data(), vertices.size(), previous.data(), previous.size(),
+                               target, maxError, simplified);
+
+        // Não reduziu o suficiente: os próximos níveis seriam iguais
+        if (simplified.size() == 0 || simplified.size() > previous.size() * 0.9f) break;
+
+        MeshOptimizer::OptimizeVertexCache(simplified.data(), simplified.size(), vertices.size());
+
+        MeshLOD lod;
+        lod.indexOffset = static_cast<uint32_t>(indices.size());
+        lod.indexCount = static_cast<uint32_t>(simplified.size());
+        // Cada nível parte do anterior: somar os erros é uma estimativa conservadora
+        lod.error = lods.back().error + error * scale;
+        lods.push_back(lod);
+
+        indices.insert(indices.end(), simplified.begin(), simplified.end());
+        previous.swap(simplified);
+    }
+
+    return lods;
+}
+
+} // namespace MeshSimplifier
+
+#endif // MESH_SIMPLIFIER_HPP
@@ -15,64 +15,301 @@
 #include "mesh.hpp"
 #include "material.hpp"
 #include "texture.hpp"
+#include "model_data.hpp"
+#include "mesh_cache.hpp"
+#include "mesh_optimizer.hpp"
+#include "mesh_simplifier.hpp"
+#include "../core/hash.hpp"
+#include "../core/job_system.hpp"
 
 #include <string>
 #include <vector>
 #include <iostream>
 #include <memory>
 #include <map>
+#include <chrono>
+#include <future>
+#include <algorithm>
 
+struct ModelLoadOptions {
+    bool useMeshCache = true; // Lê/grava o cache binário em .cache/meshes
+    VertexFormat vertexFormat = VertexFormat::Standard; // Layout do VBO de todas as meshes
+    MeshResidency residency = MeshResidency::KeepCPUData; // Cópias na CPU após o upload
+    bool optimizeMeshes = false; // Reordena índices/vértices para cache e overdraw (ver mesh_optimizer.hpp)
+    int lodLevels = 0;           // LODs extras gerados por simplificação (ver mesh_simplifier.hpp)
+    float lodReduction = 0.5f;   // Fração de triângulos mantida de um LOD para o próximo
+};
+
+/**
+ * @brief Modelo carregado via Assimp (ou pelo cache de meshes).
+ *
+ * O carregamento tem duas fases:
+ *  1. Import(): Assimp/cache, conversão de vértices e decodificação das
+ *     texturas. Só CPU, pode rodar em qualquer thread.
+ *  2. Uploader: cria texturas e meshes na GPU, uma unidade por Step(), na
+ *     thread do contexto OpenGL.
+ * O construtor Model(path) executa as duas fases de forma síncrona.
+ */
 class Model {
+public:
+    // FIX: Remover aiProcess_FlipUVs - deixa o Assimp decidir baseado no formato
+    // Faz parte da chave do cache: mudar as flags invalida os arquivos antigos
+    static constexpr unsigned int ImportFlags =
+        aiProcess_Triangulate |
+        aiProcess_CalcTangentSpace |
+        aiProcess_GenNormals |
+        aiProcess_EmbedTextures |
+        aiProcess_OptimizeMeshes |
+        aiProcess_OptimizeGraph |
+        aiProcess_FlipUVs |
+        aiProcess_GenUVCoords |           // FIX: Gerar UVs se não existirem
+        aiProcess_TransformUVCoords;      // FIX: Aplicar transformações de UV do material
+
+    class Uploader;
+
 private:
     std::vector<Mesh> meshes;
-    std::string directory;
+    std::string sourcePath;
+    ModelLoadOptions loadOptions;
+    AABB bounds;
 
-    void loadModel(std::string path) {
-        Assimp::Importer importer;
-        
-        // FIX: Remover aiProcess_FlipUVs - deixa o Assimp decidir baseado no formato
-        const aiScene *scene = importer.ReadFile(path, 
-            aiProcess_Triangulate | 
-            aiProcess_CalcTangentSpace |
-            aiProcess_GenNormals |
-            aiProcess_EmbedTextures |
-            aiProcess_OptimizeMeshes |
-            aiProcess_OptimizeGraph |
-            aiProcess_FlipUVs |
-            aiProcess_GenUVCoords |           // FIX: Gerar UVs se não existirem
-            aiProcess_TransformUVCoords       // FIX: Aplicar transformações de UV do material
-        );
+    // Estado de uma importação (vive apenas durante Import)
+    struct ImportContext {
+        const aiScene* scene = nullptr;
+        std::string directory;
+    };
 
-        if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-            std::cerr << "Erro ao carregar modelo (Assimp): " 
-                      << importer.GetErrorString() << std::endl;
-            return;
+    // Bytes de uma textura embutida ("*N"), no aiScene ou no arquivo de cache
+    struct EmbeddedBlob {
+        const unsigned char* data = nullptr;
+        int size = 0;
+    };
+
+    // Uma imagem única a decodificar; várias TextureData podem apontar para ela
+    struct DecodeJob {
+        std::string label;
+        std::string path;
+        EmbeddedBlob blob;
+        bool flipVertically = true;
+        ImageData image;
+        double decodeMs = 0.0;
+    };
+
+    // Bits de MeshCache::Key::optionFlags: o cache guarda a malha já pós-processada
+    static uint32_t cacheOptionFlags(const ModelLoadOptions& options) {
+        uint32_t flags = options.optimizeMeshes ? 1u : 0u;
+        if (options.lodLevels > 0) {
+            flags |= static_cast<uint32_t>(std::min(options.lodLevels, 255)) << 8;
+            flags |= static_cast<uint32_t>(glm::clamp(options.lodReduction, 0.0f, 1.0f) * 255.0f) << 16;
+        }
+        return flags;
+    }
+
+    // Otimiza e gera LODs de cada mesh em paralelo; os relatórios saem na ordem das meshes
+    static void postProcessMeshes(ModelData& data, const ModelLoadOptions& options) {
+        JobSystem& jobSystem = JobSystem::GetInstance();
+        std::vector<MeshOptimizer::Report> reports(data.meshes.size());
+        std::vector<std::future<void>> futures;
+        futures.reserve(data.meshes.size());
+
+        for (size_t i = 0; i < data.meshes.size(); i++) {
+            MeshData* mesh = &data.meshes[i];
+            MeshOptimizer::Report* report = &reports[i];
+            futures.push_back(jobSystem.Submit([mesh, report, &options]() {
+                if (options.optimizeMeshes) {
+                    *report = MeshOptimizer::Optimize(mesh->vertices, mesh->indices);
+                }
+                if (options.lodLevels > 0) {
+                    mesh->lods = MeshSimplifier::GenerateLODs(mesh->vertices, mesh->indices,
+                                                              options.lodLevels, options.lodReduction);
+                }
+            }));
+        }
+        for (auto& future : futures) jobSystem.Wait(future);
+
+        for (size_t i = 0; i < data.meshes.size(); i++) {
+            std::string name = data.meshes[i].material.name + " #" + std::to_string(i);
+            if (options.optimizeMeshes) reports[i].Print(name);
+
+            const auto& lods = data.meshes[i].lods;
+            if (lods.size() > 1) {
+                std::cout << "  LODs " << name << ":";
+                for (const auto& lod : lods) {
+                    std::cout << " " << lod.indexCount / 3;
+                }
+                std::cout << " triângulos (erro final " << lods.back().error << ")" << std::endl;
+            }
+        }
+    }
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static bool importFromCache(const MeshCache::Key& key, ModelData& data,
+                                std::map<uint32_t, EmbeddedBlob>& blobs) {
+        auto reader = std::make_shared<MeshCache::Reader>();
+        if (!reader->Open(key)) return false;
+
+        for (const auto& blob : reader->blobs) {
+            blobs[blob.index] = { blob.data, static_cast<int>(blob.size) };
+        }
+
+        data.meshes.resize(reader->meshes.size());
+        for (size_t m = 0; m < reader->meshes.size(); m++) {
+            const auto& record = reader->meshes[m];
+            MeshData& mesh = data.meshes[m];
+
+            mesh.mappedVertices = record.vertices;
+            mesh.mappedVertexCount = record.vertexCount;
+            mesh.mappedIndices = record.indices;
+            mesh.mappedIndexCount = record.indexCount;
+            mesh.lods = record.lods;
+            mesh.material.name = record.materialName;
+            mesh.material.properties = record.properties;
+
+            for (const auto& ref : record.textures) {
+                TextureData tex;
+                tex.type = ref.type;
+                tex.path = ref.path;
+                if (tex.IsEmbedded()) tex.params.flipVertically = false;
+                mesh.material.textures.push_back(std::move(tex));
+            }
+        }
+
+        data.keepAlive = reader;
+        return true;
+    }
+
+    /**
+     * @brief Decodifica todas as texturas referenciadas pelo modelo em paralelo.
+     *
+     * Cada imagem distinta vira um job: arquivos em disco são agrupados pelo
+     * caminho e texturas embutidas pelo hash do conteúdo, então dois "*N" com os
+     * mesmos bytes são decodificados uma vez só. Texturas que falham são removidas.
+     */
+    static void decodeTextures(ModelData& data, const std::map<uint32_t, EmbeddedBlob>& blobs) {
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<DecodeJob> jobs;
+        std::map<std::string, size_t> jobByKey;
+        std::vector<std::vector<std::pair<TextureData*, size_t>>> targets(data.meshes.size());
+
+        for (size_t m = 0; m < data.meshes.size(); m++) {
+            for (auto& tex : data.meshes[m].material.textures) {
+                DecodeJob job;
+                std::string key;
+
+                if (tex.IsEmbedded()) {
+                    auto it = blobs.find(static_cast<uint32_t>(std::stoul(tex.path.substr(1))));
+                    if (it == blobs.end()) continue;
+
+                    tex.contentHash = Hash::FNV1a(it->second.data, static_cast<size_t>(it->second.size));
+                    key = "#" + Hash::ToHex(tex.contentHash);
+                    job.blob = it->second;
+                } else {
+                    // Já carregada por outro modelo: o upload reaproveita a do TextureManager
+                    if (TextureManager::GetInstance().Contains(tex.path)) continue;
+                    key = tex.path;
+                    job.path = tex.path;
+                }
+
+                auto found = jobByKey.find(key);
+                if (found == jobByKey.end()) {
+                    job.label = tex.path;
+                    job.flipVertically = tex.params.flipVertically;
+                    found = jobByKey.emplace(key, jobs.size()).first;
+                    jobs.push_back(std::move(job));
+                }
+                targets[m].push_back({ &tex, found->second });
+            }
+        }
+
+        if (jobs.empty()) return;
+
+        JobSystem& jobSystem = JobSystem::GetInstance();
+        std::vector<std::future<void>> futures;
+        futures.reserve(jobs.size());
+        for (auto& job : jobs) {
+            DecodeJob* target = &job;
+            futures.push_back(jobSystem.Submit([target]() {
+                auto jobStart = std::chrono::steady_clock::now();
+                if (target->blob.data) {
+                    Texture::DecodeMemory(target->blob.data, target->blob.size, target->flipVertically, target->image);
+                } else {
+                    Texture::DecodeFile(target->path, target->flipVertically, target->image);
+                }
+                target->decodeMs = elapsedMs(jobStart);
+            }));
+        }
+        // Wait executa jobs pendentes: funciona mesmo quando Import já roda num worker
+        for (auto& future : futures) jobSystem.Wait(future);
+
+        double totalMs = 0.0;
+        for (const auto& job : jobs) {
+            totalMs += job.decodeMs;
+            std::cout << "  Textura decodificada: " << job.label << " (";
+            if (job.image.IsValid()) std::cout << job.image.width << "x" << job.image.height << ", ";
+            else std::cout << "falhou, ";
+            std::cout << job.decodeMs << " ms)" << std::endl;
+        }
+
+        size_t references = 0;
+        for (size_t m = 0; m < data.meshes.size(); m++) {
+            for (const auto& target : targets[m]) {
+                target.first->image = jobs[target.second].image;
+                references++;
+            }
+
+            // Remove texturas que não decodificaram (exceto as que o TextureManager já tem)
+            auto& textures = data.meshes[m].material.textures;
+            textures.erase(std::remove_if(textures.begin(), textures.end(), [](const TextureData& tex) {
+                return !tex.image.IsValid() &&
+                       (tex.IsEmbedded() || !TextureManager::GetInstance().Contains(tex.path));
+            }), textures.end());
         }
 
-        directory = path.substr(0, path.find_last_of('/'));
-        processNode(scene->mRootNode, scene);
-        
-        std::cout << "Modelo carregado: " << path << " (" << meshes.size() << " meshes)" << std::endl;
+        std::cout << "  " << jobs.size() << " texturas decodificadas (" << references << " referências) em "
+                  << elapsedMs(start) << " ms (soma " << totalMs << " ms, "
+                  << jobSystem.GetWorkerCount() << " threads)" << std::endl;
     }
 
-    void processNode(aiNode *node, const aiScene *scene) {
+    static void writeCache(const MeshCache::Key& key, const ModelData& data, const aiScene* scene) {
+        std::vector<MeshCache::Writer::Blob> blobs;
+        for (unsigned int i = 0; i < scene->mNumTextures; i++) {
+            const aiTexture* aiTex = scene->mTextures[i];
+            uint32_t size = (aiTex->mHeight == 0) ? aiTex->mWidth : aiTex->mWidth * aiTex->mHeight * 4;
+            blobs.push_back({ i, aiTex->pcData, size });
+        }
+
+        MeshCache::Writer writer;
+        if (!writer.Write(key, data.meshes, blobs)) {
+            std::cerr << "[MeshCache] Falha ao gravar cache de: " << key.sourcePath << std::endl;
+        }
+    }
+
+    static void processNode(aiNode *node, ImportContext& ctx, ModelData& data) {
         for(unsigned int i = 0; i < node->mNumMeshes; i++) {
-            aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
-            meshes.push_back(processMesh(mesh, scene));
+            aiMesh *mesh = ctx.scene->mMeshes[node->mMeshes[i]];
+            data.meshes.push_back(processMesh(mesh, ctx));
         }
         for(unsigned int i = 0; i < node->mNumChildren; i++) {
-            processNode(node->mChildren[i], scene);
+            processNode(node->mChildren[i], ctx, data);
         }
     }
 
-    Mesh processMesh(aiMesh *mesh, const aiScene *scene) {
-        std::vector<Vertex> vertices;
-        std::vector<unsigned int> indices;
+    static MeshData processMesh(aiMesh *mesh, ImportContext& ctx) {
+        MeshData data;
+        std::vector<Vertex>& vertices = data.vertices;
+        std::vector<unsigned int>& indices = data.indices;
+
+        vertices.reserve(mesh->mNumVertices);
+        indices.reserve(mesh->mNumFaces * 3);
 
         // 1. Processar Vértices
         for(unsigned int i = 0; i < mesh->mNumVertices; i++) {
             Vertex vertex;
-            
+
             // Posição
             vertex.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
 
@@ -95,7 +332,7 @@ private:
             if(mesh->HasTangentsAndBitangents()) {
                 vertex.Tangent = glm::vec3(mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z);
                 vertex.Bitangent = glm::vec3(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z);
-                
+
                 // FIX: Normalizar tangentes e bitangentes
                 vertex.Tangent = glm::normalize(vertex.Tangent);
                 vertex.Bitangent = glm::normalize(vertex.Bitangent);
@@ -103,12 +340,12 @@ private:
                 // FIX: Calcular tangente baseada na normal
                 glm::vec3 c1 = glm::cross(vertex.Normal, glm::vec3(0.0f, 0.0f, 1.0f));
                 glm::vec3 c2 = glm::cross(vertex.Normal, glm::vec3(0.0f, 1.0f, 0.0f));
-                
+
                 if(glm::length(c1) > glm::length(c2))
                     vertex.Tangent = glm::normalize(c1);
                 else
                     vertex.Tangent = glm::normalize(c2);
-                
+
                 vertex.Bitangent = glm::normalize(glm::cross(vertex.Normal, vertex.Tangent));
             }
 
@@ -123,112 +360,211 @@ private:
         }
 
         // 3. Processar Material
-        std::shared_ptr<Material> material = std::make_shared<Material>("Material_" + std::to_string(mesh->mMaterialIndex));
+        data.material.name = "Material_" + std::to_string(mesh->mMaterialIndex);
 
         if(mesh->mMaterialIndex >= 0) {
-            aiMaterial *aiMat = scene->mMaterials[mesh->mMaterialIndex];
-            loadMaterialProperties(material, aiMat, scene);
+            aiMaterial *aiMat = ctx.scene->mMaterials[mesh->mMaterialIndex];
+            loadMaterialProperties(data.material, aiMat, ctx);
         }
 
-        return Mesh(vertices, indices, material);
+        return data;
     }
 
-    void loadMaterialProperties(std::shared_ptr<Material> material, aiMaterial *aiMat, const aiScene *scene) {
+    static void loadMaterialProperties(MaterialData& material, aiMaterial *aiMat, ImportContext& ctx) {
         aiColor3D color(1.0f, 1.0f, 1.0f);
         float value;
 
         // --- Propriedades Escalares ---
         if(aiMat->Get(AI_MATKEY_COLOR_DIFFUSE, color) == AI_SUCCESS)
-            material->SetAlbedo(glm::vec3(color.r, color.g, color.b));
-            
+            material.properties.albedo = glm::vec3(color.r, color.g, color.b);
+
         if(aiMat->Get(AI_MATKEY_COLOR_SPECULAR, color) == AI_SUCCESS)
-            material->SetSpecular(glm::vec3(color.r, color.g, color.b));
+            material.properties.specular = glm::vec3(color.r, color.g, color.b);
 
         // Shininess para Roughness
         if(aiMat->Get(AI_MATKEY_SHININESS, value) == AI_SUCCESS) {
-            material->SetShininess(value);
-            float roughness = 1.0f - (sqrt(value) / sqrt(100.0f)); 
-            material->SetRoughness(glm::clamp(roughness, 0.05f, 1.0f));
+            material.properties.shininess = value;
+            float roughness = 1.0f - (sqrt(value) / sqrt(100.0f));
+            material.properties.roughness = glm::clamp(roughness, 0.05f, 1.0f);
         }
 
         // --- Carregamento de Texturas ---
-        loadMaterialTextures(material, aiMat, aiTextureType_DIFFUSE, TextureType::DIFFUSE, scene);
-        loadMaterialTextures(material, aiMat, aiTextureType_BASE_COLOR, TextureType::DIFFUSE, scene);
-        loadMaterialTextures(material, aiMat, aiTextureType_SPECULAR, TextureType::SPECULAR, scene);
-        loadMaterialTextures(material, aiMat, aiTextureType_NORMALS, TextureType::NORMAL, scene);
-        loadMaterialTextures(material, aiMat, aiTextureType_HEIGHT, TextureType::NORMAL, scene);
-        loadMaterialTextures(material, aiMat, aiTextureType_METALNESS, TextureType::METALLIC, scene);
-        loadMaterialTextures(material, aiMat, aiTextureType_DIFFUSE_ROUGHNESS, TextureType::ROUGHNESS, scene);
-        loadMaterialTextures(material, aiMat, aiTextureType_AMBIENT_OCCLUSION, TextureType::AO, scene);
-        loadMaterialTextures(material, aiMat, aiTextureType_LIGHTMAP, TextureType::AO, scene);
-        loadMaterialTextures(material, aiMat, aiTextureType_EMISSIVE, TextureType::EMISSION, scene);
-    }
-
-    void loadMaterialTextures(std::shared_ptr<Material> targetMat, aiMaterial *mat, 
-                              aiTextureType aiType, TextureType texType, const aiScene* scene) {
-        
-        if (targetMat->HasTextureType(texType)) return;
+        loadMaterialTextures(material, aiMat, aiTextureType_DIFFUSE, TextureType::DIFFUSE, ctx);
+        loadMaterialTextures(material, aiMat, aiTextureType_BASE_COLOR, TextureType::DIFFUSE, ctx);
+        loadMaterialTextures(material, aiMat, aiTextureType_SPECULAR, TextureType::SPECULAR, ctx);
+        loadMaterialTextures(material, aiMat, aiTextureType_NORMALS, TextureType::NORMAL, ctx);
+        loadMaterialTextures(material, aiMat, aiTextureType_HEIGHT, TextureType::NORMAL, ctx);
+        loadMaterialTextures(material, aiMat, aiTextureType_METALNESS, TextureType::METALLIC, ctx);
+        loadMaterialTextures(material, aiMat, aiTextureType_DIFFUSE_ROUGHNESS, TextureType::ROUGHNESS, ctx);
+        loadMaterialTextures(material, aiMat, aiTextureType_AMBIENT_OCCLUSION, TextureType::AO, ctx);
+        loadMaterialTextures(material, aiMat, aiTextureType_LIGHTMAP, TextureType::AO, ctx);
+        loadMaterialTextures(material, aiMat, aiTextureType_EMISSIVE, TextureType::EMISSION, ctx);
+    }
+
+    // Só registra as referências; a decodificação acontece depois, em paralelo
+    static void loadMaterialTextures(MaterialData& targetMat, aiMaterial *mat,
+                                     aiTextureType aiType, TextureType texType, ImportContext& ctx) {
+
+        if (targetMat.HasTextureType(texType)) return;
 
         for(unsigned int i = 0; i < mat->GetTextureCount(aiType); i++) {
             aiString str;
             mat->GetTexture(aiType, i, &str);
             std::string filename = std::string(str.C_Str());
-            
+
             // --- TEXTURA EMBUTIDA ---
             if (filename.length() > 0 && filename[0] == '*') {
                 int textureIndex = std::stoi(filename.substr(1));
-                if (textureIndex < (int)scene->mNumTextures) {
-                    aiTexture* aiTex = scene->mTextures[textureIndex];
-                    
-                    auto embeddedTex = std::make_shared<Texture>();
-                    
-                    int size = (aiTex->mHeight == 0) ? aiTex->mWidth : aiTex->mWidth * aiTex->mHeight * 4;
-                    
-                    TextureParams params;
+                if (textureIndex < (int)ctx.scene->mNumTextures) {
+                    TextureData tex;
+                    tex.type = texType;
+                    tex.path = filename; // "*N", referência usada pelo cache
                     // FIX: Não flipar texturas embutidas - GLB/GLTF já vêm corretos
-                    params.flipVertically = false;
-                    
+                    tex.params.flipVertically = false;
+
                     // FIX: Normal maps precisam de configuração específica
                     // if (texType == TextureType::NORMAL) {
                     //     params.sRGB = false; // Normal maps devem ser lineares
                     // }
-                    
-                    bool loaded = embeddedTex->LoadFromMemory(
-                        reinterpret_cast<unsigned char*>(aiTex->pcData),
-                        size,
-                        texType,
-                        params
-                    );
-
-                    if (loaded) {
-                        targetMat->AddTexture(embeddedTex);
-                        return; 
-                    }
+
+                    targetMat.textures.push_back(std::move(tex));
+                    return;
                 }
-            } 
+            }
             // --- ARQUIVO EM DISCO ---
             else {
-                std::string fullPath = directory + '/' + filename;
-                
-                auto tex = TextureManager::GetInstance().LoadTexture(fullPath, texType);
-                if (tex) {
-                    targetMat->AddTexture(tex);
-                }
+                TextureData tex;
+                tex.type = texType;
+                tex.path = ctx.directory + '/' + filename;
+                targetMat.textures.push_back(std::move(tex));
             }
         }
     }
 
 public:
-    Model(const std::string &path) {
-        loadModel(path);
+    Model() = default;
+
+    Model(const std::string &path, const ModelLoadOptions& options = ModelLoadOptions());
+
+    /**
+     * @brief Fase de CPU do carregamento. Não usa OpenGL; segura para workers.
+     */
+    static std::shared_ptr<ModelData> Import(const std::string& path,
+                                             const ModelLoadOptions& options = ModelLoadOptions()) {
+        auto start = std::chrono::steady_clock::now();
+        auto data = std::make_shared<ModelData>();
+        data->path = path;
+
+        MeshCache::Key cacheKey;
+        data->cacheable = options.useMeshCache &&
+                          MeshCache::MakeKey(path, ImportFlags, cacheKey, cacheOptionFlags(options));
+
+        std::map<uint32_t, EmbeddedBlob> blobs;
+        if (data->cacheable && importFromCache(cacheKey, *data, blobs)) {
+            decodeTextures(*data, blobs);
+            data->fromCache = true;
+            data->valid = true;
+            data->importMs = elapsedMs(start);
+            return data;
+        }
+        data->meshes.clear();
+        blobs.clear();
+
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile(path, ImportFlags);
+
+        if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+            std::cerr << "Erro ao carregar modelo (Assimp): "
+                      << importer.GetErrorString() << std::endl;
+            return data;
+        }
+
+        ImportContext ctx;
+        ctx.scene = scene;
+        ctx.directory = path.substr(0, path.find_last_of('/'));
+        processNode(scene->mRootNode, ctx, *data);
+
+        if (options.optimizeMeshes || options.lodLevels > 0) {
+            postProcessMeshes(*data, options);
+        }
+
+        for (unsigned int i = 0; i < scene->mNumTextures; i++) {
+            const aiTexture* aiTex = scene->mTextures[i];
+            int size = (aiTex->mHeight == 0) ? aiTex->mWidth : aiTex->mWidth * aiTex->mHeight * 4;
+            blobs[i] = { reinterpret_cast<const unsigned char*>(aiTex->pcData), size };
+        }
+        decodeTextures(*data, blobs);
+
+        if (data->cacheable) {
+            writeCache(cacheKey, *data, scene);
+        }
+
+        data->valid = true;
+        data->importMs = elapsedMs(start);
+        return data;
     }
 
-    void Draw(unsigned int shaderProgram) {
+    /**
+     * @brief Traz de volta as cópias na CPU de meshes liberadas por ReleaseAfterUpload.
+     * Lê do cache de meshes quando ele ainda é válido; senão, lê os buffers da GPU.
+     */
+    bool RestoreCPUData() {
+        std::shared_ptr<MeshCache::Reader> reader;
+        MeshCache::Key key;
+        if (loadOptions.useMeshCache &&
+            MeshCache::MakeKey(sourcePath, ImportFlags, key, cacheOptionFlags(loadOptions))) {
+            reader = std::make_shared<MeshCache::Reader>();
+            if (!reader->Open(key) || reader->meshes.size() != meshes.size()) reader.reset();
+        }
+
+        bool ok = true;
+        for (size_t i = 0; i < meshes.size(); i++) {
+            Mesh& mesh = meshes[i];
+            if (mesh.HasCPUData()) continue;
+
+            bool restored = false;
+            if (reader) {
+                const auto& record = reader->meshes[i];
+                restored = mesh.RestoreCPUData(record.vertices, record.vertexCount,
+                                               record.indices, record.indexCount);
+            }
+            if (!restored) restored = mesh.RestoreCPUDataFromGPU();
+            ok = ok && restored;
+        }
+        return ok;
+    }
+
+    void ReleaseCPUData() {
+        for (auto& mesh : meshes) mesh.ReleaseCPUData();
+    }
+
+    const AABB& GetBounds() const { return bounds; }
+    const std::string& GetPath() const { return sourcePath; }
+
+    // transform: matriz model do modelo inteiro (ver Mesh::Draw)
+    void Draw(const Shader& shader, const glm::mat4& transform = glm::mat4(1.0f)) {
         for(unsigned int i = 0; i < meshes.size(); i++)
-            meshes[i].Draw(shaderProgram);
+            meshes[i].Draw(shader, transform);
+    }
+
+    void Draw(unsigned int shaderProgram, const glm::mat4& transform = glm::mat4(1.0f)) {
+        for(unsigned int i = 0; i < meshes.size(); i++)
+            meshes[i].Draw(shaderProgram, transform);
     }
 
     size_t GetMeshCount() const { return meshes.size(); }
+
+    size_t GetVertexBufferSize() const {
+        size_t bytes = 0;
+        for (const auto& mesh : meshes) bytes += mesh.GetVertexBufferSize();
+        return bytes;
+    }
+
+    size_t GetStandardVertexBufferSize() const {
+        size_t bytes = 0;
+        for (const auto& mesh : meshes) bytes += mesh.GetStandardVertexBufferSize();
+        return bytes;
+    }
     const Mesh& GetMesh(size_t index) const { return meshes[index]; }
 
     void SetMaterialAll(std::shared_ptr<Material> material) {
@@ -236,6 +572,108 @@ public:
             mesh.SetMaterial(material);
         }
     }
+
+    void SetMeshMaterial(size_t index, std::shared_ptr<Material> material) {
+        meshes[index].SetMaterial(material);
+    }
 };
 
-#endif // MODEL_HPP
\ No newline at end of file
+/**
+ * @brief Fase de GPU do carregamento. Cada Step() cria uma textura ou uma mesh,
+ * permitindo distribuir o upload de um modelo grande por vários frames.
+ */
+class Model::Uploader {
+private:
+    std::shared_ptr<ModelData> data;
+    Model& target;
+    VertexFormat vertexFormat;
+    MeshResidency residency;
+    size_t meshIndex = 0;
+    size_t textureIndex = 0;
+    std::shared_ptr<Material> currentMaterial;
+    std::map<std::string, std::shared_ptr<Texture>> embedded; // "hash|tipo" -> textura
+    double uploadMs = 0.0;
+
+    std::shared_ptr<Texture> uploadTexture(const TextureData& tex) {
+        if (!tex.IsEmbedded()) {
+            if (!tex.image.IsValid()) {
+                return TextureManager::GetInstance().LoadTexture(tex.path, tex.type, tex.params);
+            }
+            return TextureManager::GetInstance().LoadTexture(tex.path, tex.image, tex.type, tex.params);
+        }
+
+        // Chave pelo conteúdo: blobs embutidos idênticos compartilham a mesma textura
+        std::string key = Hash::ToHex(tex.contentHash) + "|" + std::to_string(static_cast<int>(tex.type));
+        auto it = embedded.find(key);
+        if (it != embedded.end()) return it->second;
+
+        auto texture = std::make_shared<Texture>();
+        if (!texture->Upload(tex.image, tex.type, tex.params)) return nullptr;
+        texture->setPath(tex.path);
+        embedded[key] = texture;
+        return texture;
+    }
+
+public:
+    Uploader(std::shared_ptr<ModelData> modelData, Model& model,
+             const ModelLoadOptions& options = ModelLoadOptions())
+        : data(std::move(modelData)), target(model), vertexFormat(options.vertexFormat),
+          residency(options.residency) {
+        target.sourcePath = data->path;
+        target.loadOptions = options;
+        target.meshes.reserve(target.meshes.size() + data->meshes.size());
+    }
+
+    // Executa uma unidade de upload. Retorna true quando o modelo está completo.
+    bool Step() {
+        if (IsDone()) return true;
+        auto start = std::chrono::steady_clock::now();
+
+        MeshData& mesh = data->meshes[meshIndex];
+        if (!currentMaterial) {
+            currentMaterial = std::make_shared<Material>(mesh.material.name);
+            currentMaterial->GetProperties() = mesh.material.properties;
+        }
+
+        if (textureIndex < mesh.material.textures.size()) {
+            auto texture = uploadTexture(mesh.material.textures[textureIndex++]);
+            if (texture) currentMaterial->AddTexture(texture);
+        } else {
+            // Sobe direto do MeshData (ou do cache mapeado); cópias na CPU só com KeepCPUData
+            target.meshes.emplace_back(mesh.GetVertices(), mesh.GetVertexCount(), mesh.GetIndices(),
+                                       mesh.GetIndexCount(), currentMaterial, vertexFormat, residency);
+            target.meshes.back().SetLODs(mesh.lods);
+            target.bounds.Expand(target.meshes.back().GetBounds());
+            currentMaterial.reset();
+            textureIndex = 0;
+            meshIndex++;
+        }
+
+        uploadMs += elapsedMs(start);
+
+        if (IsDone()) {
+            std::cout << "Modelo carregado: " << data->path << " (" << target.meshes.size() << " meshes, cache: "
+                      << (data->fromCache ? "hit" : (data->cacheable ? "miss" : "off"))
+                      << ", import " << data->importMs << " ms, upload " << uploadMs << " ms)" << std::endl;
+            if (vertexFormat == VertexFormat::Packed) {
+                size_t gpuBytes = target.GetVertexBufferSize();
+                size_t standardBytes = target.GetStandardVertexBufferSize();
+                std::cout << "  Vértices compactados: " << standardBytes / 1024 << " KB -> " << gpuBytes / 1024
+                          << " KB (economia de " << (standardBytes - gpuBytes) / 1024 << " KB)" << std::endl;
+            }
+            data->keepAlive.reset();
+            return true;
+        }
+        return false;
+    }
+
+    bool IsDone() const { return !data->valid || meshIndex >= data->meshes.size(); }
+    const std::shared_ptr<ModelData>& GetData() const { return data; }
+};
+
+inline Model::Model(const std::string &path, const ModelLoadOptions& options) {
+    Uploader uploader(Import(path, options), *this, options);
+    while (!uploader.Step()) {}
+}
+
+#endif // MODEL_HPP
@@ -0,0 +1,75 @@
+#ifndef MODEL_DATA_HPP
+#define MODEL_DATA_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "mesh.hpp"
+#include "material.hpp"
+#include "texture.hpp"
+
+/**
+ * @brief Resultado da importação de um modelo, ainda sem nenhum objeto GL.
+ *
+ * Produzido por Model::Import (pode rodar numa thread de carregamento) e
+ * consumido por Model::Uploader na thread do contexto OpenGL.
+ */
+
+struct TextureData {
+    TextureType type = TextureType::UNKNOWN;
+    std::string path;      // caminho em disco ou "*N" para textura embutida
+    TextureParams params;
+    ImageData image;       // vazio se a textura já estava no TextureManager
+    uint64_t contentHash = 0; // hash dos bytes de uma textura embutida
+
+    bool IsEmbedded() const { return !path.empty() && path[0] == '*'; }
+};
+
+struct MaterialData {
+    std::string name;
+    MaterialProperties properties;
+    std::vector<TextureData> textures;
+
+    bool HasTextureType(TextureType type) const {
+        for (const auto& tex : textures) {
+            if (tex.type == type) return true;
+        }
+        return false;
+    }
+};
+
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+
+    // Quando vem do cache, os dados ficam no arquivo mapeado e os vetores ficam vazios
+    const Vertex* mappedVertices = nullptr;
+    const unsigned int* mappedIndices = nullptr;
+    size_t mappedVertexCount = 0;
+    size_t mappedIndexCount = 0;
+
+    // Faixas de LOD dentro dos índices; vazio = só o LOD 0
+    std::vector<MeshLOD> lods;
+
+    MaterialData material;
+
+    const Vertex* GetVertices() const { return mappedVertices ? mappedVertices : vertices.data(); }
+    size_t GetVertexCount() const { return mappedVertices ? mappedVertexCount : vertices.size(); }
+    const unsigned int* GetIndices() const { return mappedIndices ? mappedIndices : indices.data(); }
+    size_t GetIndexCount() const { return mappedIndices ? mappedIndexCount : indices.size(); }
+};
+
+struct ModelData {
+    std::string path;
+    std::vector<MeshData> meshes;
+    std::shared_ptr<void> keepAlive; // mantém o mapeamento do cache vivo até o upload
+
+    bool valid = false;
+    bool fromCache = false;
+    bool cacheable = false;
+    double importMs = 0.0;
+};
+
+#endif // MODEL_DATA_HPP
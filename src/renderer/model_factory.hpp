@@ -5,9 +5,27 @@
 #include <cmath>
 #include <memory>
 #include "mesh.hpp"
+#include "mesh_optimizer.hpp"
 
 class ModelFactory {
+private:
+    static bool& optimizeFlag() {
+        static bool optimize = false;
+        return optimize;
+    }
+
+    static Mesh buildMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, const char* name) {
+        if (optimizeFlag()) {
+            MeshOptimizer::Optimize(vertices, indices).Print(name);
+        }
+        return Mesh(vertices, indices, nullptr);
+    }
+
 public:
+    // Passa as meshes geradas pelo mesmo otimizador usado na importação de modelos
+    static void SetOptimizeMeshes(bool enabled) { optimizeFlag() = enabled; }
+    static bool GetOptimizeMeshes() { return optimizeFlag(); }
+
     static Mesh CreateSphere(float radius = 1.0f, int sectors = 36, int stacks = 18) {
         std::vector<Vertex> vertices;
         std::vector<unsigned int> indices;
@@ -69,7 +87,7 @@ public:
             }
         }
         
-        return Mesh(vertices, indices, nullptr); 
+        return buildMesh(vertices, indices, "Sphere");
     }
     
     static Mesh CreateCube(float size = 1.0f) {
@@ -127,7 +145,7 @@ public:
             indices.push_back(offset + 0);
         }
         
-        return Mesh(vertices, indices, nullptr);
+        return buildMesh(vertices, indices, "Cube");
     }
     
     static Mesh CreateCylinder(float radius = 0.5f, float height = 2.0f, int sectors = 36) {
@@ -240,7 +258,7 @@ public:
             indices.push_back(topCenterIndex + 1 + ((i + 1) % sectors));
         }
         
-        return Mesh(vertices, indices, nullptr);
+        return buildMesh(vertices, indices, "Cylinder");
     }
     
     static Mesh CreateCone(float radius = 0.5f, float height = 2.0f, int sectors = 36) {
@@ -324,7 +342,7 @@ public:
             indices.push_back(baseCenterIndex + 1 + i);
         }
         
-        return Mesh(vertices, indices, nullptr);
+        return buildMesh(vertices, indices, "Cone");
     }
     
     static Mesh CreateTorus(float majorRadius = 1.0f, float minorRadius = 0.3f, 
@@ -378,7 +396,7 @@ public:
             }
         }
         
-        return Mesh(vertices, indices, nullptr);
+        return buildMesh(vertices, indices, "Torus");
     }
     
     static Mesh CreatePlaneMesh(float size = 20.0f) {
@@ -403,7 +421,7 @@ public:
         
         indices = {0, 2, 1, 2, 0, 3};
         
-        return Mesh(vertices, indices, nullptr);
+        return buildMesh(vertices, indices, "Plane");
     }
     
     static Mesh CreateCapsule(float radius = 0.5f, float height = 2.0f, 
@@ -534,7 +552,7 @@ public:
             }
         }
         
-        return Mesh(vertices, indices, nullptr);
+        return buildMesh(vertices, indices, "Capsule");
     }
 };
 
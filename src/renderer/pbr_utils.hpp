@@ -59,24 +59,49 @@ public:
     EnvironmentMap() : envCubemap(0), irradianceMap(0), prefilterMap(0), brdfLUTTexture(0) {}
 
     ~EnvironmentMap() {
-        if (envCubemap) glDeleteTextures(1, &envCubemap);
-        if (irradianceMap) glDeleteTextures(1, &irradianceMap);
-        if (prefilterMap) glDeleteTextures(1, &prefilterMap);
-        if (brdfLUTTexture) glDeleteTextures(1, &brdfLUTTexture);
+        if (envCubemap) {
+            GLState::GetInstance().ForgetTexture(envCubemap);
+            glDeleteTextures(1, &envCubemap);
+        }
+        if (irradianceMap) {
+            GLState::GetInstance().ForgetTexture(irradianceMap);
+            glDeleteTextures(1, &irradianceMap);
+        }
+        if (prefilterMap) {
+            GLState::GetInstance().ForgetTexture(prefilterMap);
+            glDeleteTextures(1, &prefilterMap);
+        }
+        if (brdfLUTTexture) {
+            GLState::GetInstance().ForgetTexture(brdfLUTTexture);
+            glDeleteTextures(1, &brdfLUTTexture);
+        }
     }
 
     /**
      * @brief Loads HDR image and generates all necessary IBL maps.
      */
     void LoadFromHDR(const std::string& path) {
+        ImageData image;
+        if (!Texture::DecodeHDR(path, image)) {
+            std::cerr << "[IBL] Failed to load HDR: " << path << std::endl;
+            return;
+        }
+        LoadFromHDRImage(image);
+    }
+
+    /**
+     * @brief Builds the IBL maps from an already decoded HDR image.
+     * Decoding can run on a loader thread; this part needs the GL context.
+     */
+    void LoadFromHDRImage(const ImageData& image) {
         if (!skyboxManager.Initialize()) {
             std::cerr << "[IBL] Failed to initialize SkyboxManager!" << std::endl;
             return;
         }
 
         Texture hdrTexture;
-        if (!hdrTexture.LoadHDR(path)) {
-            std::cerr << "[IBL] Failed to load HDR: " << path << std::endl;
+        if (!hdrTexture.UploadHDR(image)) {
+            std::cerr << "[IBL] Failed to upload HDR image" << std::endl;
             return;
         }
 
@@ -155,6 +180,9 @@ public:
         GeneratePrefilterMap();
         GenerateBRDFLUT();
 
+        // A captura usa GL direto (FBOs, viewports, texturas em várias unidades)
+        GLState::GetInstance().Invalidate();
+
         std::cout << "[IBL] Environment maps generated successfully." << std::endl;
     }
     
@@ -379,10 +407,22 @@ public:
 
     EnvironmentMap& operator=(EnvironmentMap&& other) noexcept {
         if (this != &other) {
-            if (envCubemap) glDeleteTextures(1, &envCubemap);
-            if (irradianceMap) glDeleteTextures(1, &irradianceMap);
-            if (prefilterMap) glDeleteTextures(1, &prefilterMap);
-            if (brdfLUTTexture) glDeleteTextures(1, &brdfLUTTexture);
+            if (envCubemap) {
+                GLState::GetInstance().ForgetTexture(envCubemap);
+                glDeleteTextures(1, &envCubemap);
+            }
+            if (irradianceMap) {
+                GLState::GetInstance().ForgetTexture(irradianceMap);
+                glDeleteTextures(1, &irradianceMap);
+            }
+            if (prefilterMap) {
+                GLState::GetInstance().ForgetTexture(prefilterMap);
+                glDeleteTextures(1, &prefilterMap);
+            }
+            if (brdfLUTTexture) {
+                GLState::GetInstance().ForgetTexture(brdfLUTTexture);
+                glDeleteTextures(1, &brdfLUTTexture);
+            }
             
             envCubemap = other.envCubemap;
             irradianceMap = other.irradianceMap;
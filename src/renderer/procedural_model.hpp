@@ -5,6 +5,7 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include <cmath>
+#include "gl_state.hpp"
 
 class ProceduralModel {
 private:
@@ -16,7 +17,10 @@ public:
     ProceduralModel() : VAO(0), VBO(0), EBO(0), vertexCount(0), indexCount(0) {}
 
     ~ProceduralModel() {
-        if (VAO) glDeleteVertexArrays(1, &VAO);
+        if (VAO) {
+            GLState::GetInstance().ForgetVertexArray(VAO);
+            glDeleteVertexArrays(1, &VAO);
+        }
         if (VBO) glDeleteBuffers(1, &VBO);
         if (EBO) glDeleteBuffers(1, &EBO);
     }
@@ -214,9 +218,8 @@ public:
     }
 
     void Draw() {
-        glBindVertexArray(VAO);
+        GLState::GetInstance().BindVertexArray(VAO);
         glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
     }
 
 private:
@@ -228,7 +231,7 @@ private:
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
 
-        glBindVertexArray(VAO);
+        GLState::GetInstance().BindVertexArray(VAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, vertexSize, vertexData, GL_STATIC_DRAW);
@@ -251,7 +254,7 @@ private:
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float),
                               (void*)(6 * sizeof(float)));
 
-        glBindVertexArray(0);
+        GLState::GetInstance().BindVertexArray(0);
     }
 };
 
@@ -3,6 +3,7 @@
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <cstdint>
 #include "mesh.hpp"
 #include "material.hpp"
 
@@ -14,9 +15,12 @@ struct RenderCommand {
     // Distância da câmera (para ordenação)
     float distanceToCamera; 
 
+    // Nível de detalhe escolhido no Submit (0 = malha completa)
+    uint32_t lod;
+
     // Construtor auxiliar
-    RenderCommand(Mesh* m, Material* mat, const glm::mat4& trans, float dist = 0.0f)
-        : mesh(m), material(mat), transform(trans), distanceToCamera(dist) {}
+    RenderCommand(Mesh* m, Material* mat, const glm::mat4& trans, float dist = 0.0f, uint32_t level = 0)
+        : mesh(m), material(mat), transform(trans), distanceToCamera(dist), lod(level) {}
 };
 
 #endif // RENDER_COMMAND_HPP
\ No newline at end of file
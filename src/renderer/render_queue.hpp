@@ -0,0 +1,115 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// Item ordenado no lugar do RenderCommand (80+ bytes): chave + índice na fila
+struct SortItem {
+    uint64_t key;
+    uint32_t index;
+};
+
+enum class SortMode {
+    Distance, // Só profundidade, de frente para trás (comportamento antigo)
+    StateKey  // Shader > material > mesh > profundidade: minimiza trocas de estado
+};
+
+/**
+ * @brief Chave de ordenação de 64 bits.
+ *
+ *   63..56  shader    (8 bits)
+ *   55..40  material  (16 bits)
+ *   39..32  VAO       (8 bits)
+ *   31..16  mesh      (16 bits, Mesh::GetSortID)
+ *   15..0   profundidade quantizada (16 bits, crescente = frente para trás)
+ *
+ * Comandos com o mesmo shader/material/mesh ficam adjacentes, e dentro de cada
+ * grupo a ordem é de frente para trás para aproveitar o early-z. A mesh tem
+ * campo próprio abaixo do VAO porque no GeometryArena várias meshes dividem o
+ * VAO do pool: sem ele, meshes diferentes se intercalariam pela profundidade e
+ * o instancing quebraria em batches de um.
+ */
+namespace SortKey {
+
+constexpr int DepthBits = 16;
+constexpr int MeshBits = 16;
+constexpr int VertexArrayBits = 8;
+constexpr int MaterialBits = 16;
+constexpr int ShaderBits = 8;
+
+constexpr uint64_t Mask(int bits) { return (uint64_t(1) << bits) - 1; }
+
+inline uint32_t QuantizeDepth(float distance, float maxDistance) {
+    if (!(distance > 0.0f) || !(maxDistance > 0.0f)) return 0;
+    float normalized = distance / maxDistance;
+    if (normalized >= 1.0f) return static_cast<uint32_t>(Mask(DepthBits));
+    return static_cast<uint32_t>(normalized * static_cast<float>(Mask(DepthBits)));
+}
+
+inline uint64_t Make(uint32_t shader, uint32_t material, uint32_t vertexArray, uint32_t mesh, uint32_t depth) {
+    return ((shader & Mask(ShaderBits)) << (DepthBits + MeshBits + VertexArrayBits + MaterialBits)) |
+           ((material & Mask(MaterialBits)) << (DepthBits + MeshBits + VertexArrayBits)) |
+           ((vertexArray & Mask(VertexArrayBits)) << (DepthBits + MeshBits)) |
+           ((mesh & Mask(MeshBits)) << DepthBits) |
+           (depth & Mask(DepthBits));
+}
+
+// Só profundidade (SortMode::Distance)
+inline uint64_t MakeDepthOnly(uint32_t depth) {
+    return depth & Mask(DepthBits);
+}
+
+} // namespace SortKey
+
+/**
+ * @brief Radix sort LSD estável de 8 bits por passo sobre a chave de 64 bits.
+ *
+ * Custo linear no número de itens. Bytes em que todas as chaves são iguais
+ * (ex.: shader quando só há um, ou os bytes altos no modo Distance) são
+ * detectados pelo histograma e o passo é pulado.
+ */
+inline void RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch) {
+    const size_t count = items.size();
+    if (count < 2) return;
+    scratch.resize(count);
+
+    // Todos os histogramas numa única leitura
+    uint32_t histograms[8][256];
+    std::memset(histograms, 0, sizeof(histograms));
+    for (const auto& item : items) {
+        for (int pass = 0; pass < 8; pass++) {
+            histograms[pass][(item.key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    SortItem* src = items.data();
+    SortItem* dst = scratch.data();
+    for (int pass = 0; pass < 8; pass++) {
+        uint32_t* histogram = histograms[pass];
+        int shift = pass * 8;
+
+        // Passo inútil: todas as chaves têm o mesmo byte aqui
+        if (histogram[(src[0].key >> shift) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (int digit = 0; digit < 256; digit++) {
+            uint32_t n = histogram[digit];
+            histogram[digit] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; i++) {
+            dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != items.data()) {
+        std::memcpy(items.data(), src, count * sizeof(SortItem));
+    }
+}
+
+#endif // RENDER_QUEUE_HPP
@@ -4,13 +4,24 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <chrono>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "render_command.hpp"
+#include "frustum.hpp"
+#include "render_queue.hpp"
+#include "gl_state.hpp"
+#include "uniform_buffer.hpp"
+#include "stream_buffer.hpp"
+#include "material_table.hpp"
+#include "light_clusters.hpp"
+#include "light_binning.hpp"
+#include "gbuffer.hpp"
 #include "shader.hpp"
 #include "model.hpp"
 #include "skybox_manager.hpp"
+#include "../core/profiler.hpp"
 
 // Dados globais da cena (Câmera, Luzes)
 struct SceneData {
@@ -28,11 +39,32 @@ struct DirectionalLight {
     float intensity = 1.0f;
 };
 
-struct PointLightData {
-    glm::vec3 position;
-    glm::vec3 color;
-    float intensity;
-    float radius;
+// Contadores do último frame (zerados em BeginScene)
+struct RenderStats {
+    uint32_t drawCalls = 0;
+    uint32_t instances = 0;     // Objetos desenhados (drawCalls < instances quando há instancing)
+    uint64_t triangles = 0;     // Triângulos efetivamente desenhados
+    uint64_t trianglesLOD0 = 0; // Quantos seriam sem LOD
+    uint32_t lodDraws[4] = {};  // Instâncias por nível (o último acumula os níveis >= 3)
+    uint32_t visible = 0;       // Comandos que passaram no frustum culling
+    uint32_t culled = 0;        // Comandos descartados pelo frustum culling
+    double cullMs = 0.0;
+    double sortMs = 0.0;
+    uint32_t shaderBinds = 0;   // Trocas efetivas de estado no loop de desenho
+    uint32_t materialBinds = 0;
+    uint32_t vaoBinds = 0;
+    uint32_t indirectCommands = 0; // Comandos emitidos via glMultiDrawElementsIndirect
+    uint64_t streamBytes = 0;   // Bytes escritos nos StreamBuffers (instâncias + blocos)
+    uint32_t streamWaits = 0;   // Vezes em que o CPU esperou a GPU liberar uma região
+    double streamWaitMs = 0.0;
+    uint32_t pointLights = 0;      // Luzes pontuais submetidas
+    uint32_t lightIndices = 0;     // Pares (cluster, luz) nas listas do LightClusters
+    uint32_t maxLightsPerCluster = 0;
+    double lightClusterMs = 0.0;
+    uint32_t lightsInFrustum = 0;  // Luzes pontuais que passaram no frustum (LightBinner)
+    uint32_t lightsUsed = 0;       // Luzes que tocam pelo menos um draw; só essas vão para os clusters
+    uint32_t drawLightIndices = 0; // Pares (draw, luz): listas por draw lidas pelo pbr.frag
+    double lightBinMs = 0.0;
 };
 
 class Renderer {
@@ -43,6 +75,7 @@ private:
 
     SceneData sceneData;
     Shader* activeShader;
+    Shader* opaqueShader = nullptr; // Programa do passe opaco do frame (activeShader, tableShader ou variantes GBUFFER)
 
     // Recursos Internos do Renderer
     unsigned int screenQuadVAO = 0;
@@ -54,12 +87,359 @@ private:
     // FILAS DE LUZ
     DirectionalLight sunLight;
     std::vector<PointLightData> pointLights;
+    LightClusters lightClusters; // Listas de luzes por froxel, refeitas a cada frame
+
+    // Binning na CPU: descarta as luzes que não tocam nenhum draw visível antes dos clusters
+    bool lightBinning = true;
+    LightBinner lightBinner;
+    std::vector<PointLightData> binnedLights;
+    size_t frameLightCount = 0; // Luzes entregues ao LightClusters neste frame
+
+    // Listas de luzes por draw do LightBinner: cada instância leva (offset,
+    // quantidade) da lista do seu draw (atributo 10, array de uvec2 no
+    // instanceStream depois das matrizes) e o pbr.frag usa a lista quando ela
+    // é menor que a do cluster. Sem binning (ou no deferred), NoDrawLights.
+    bool frameDrawLights = false;
+    size_t drawLightsOffset = 0;
 
     unsigned int iblIrradiance = 0;
     unsigned int iblPrefilter = 0;
     unsigned int iblBrdf = 0;
     bool useIBL = false;
 
+    // Dados por frame em anéis triplos com fence: FrameData (câmera e luzes,
+    // um por frame, qualquer que seja o número de shaders) e um MaterialData por
+    // troca de material vão para uniformStream; as matrizes de instância para
+    // instanceStream. Tudo é escrito antes do primeiro draw do frame.
+    StreamBuffer uniformStream;
+    StreamBuffer instanceStream;
+    FrameUniforms frameData{};
+    size_t frameDataOffset = 0;
+
+    // Seleção de LOD: maior nível cujo erro projetado fica abaixo de lodPixelError
+    bool lodEnabled = true;
+    float lodPixelError = 1.0f;
+    int viewportWidth = 1280;
+    int viewportHeight = 720;
+
+    RenderStats stats;
+
+    // Frustum culling: bounds em mundo de cada comando opaco, no mesmo índice da fila
+    bool frustumCulling = true;
+    Frustum frustum;
+    FrustumCuller culler;
+    std::vector<AABB> commandBounds; // Mesmos bounds, compactados junto com a fila (para o LightBinner)
+
+    void enqueueOpaque(Mesh* mesh, const glm::mat4& transform) {
+        float dist = glm::length(sceneData.cameraPos - glm::vec3(transform[3]));
+        opaqueQueue.emplace_back(mesh, mesh->GetMaterial().get(), transform, dist, selectLOD(*mesh, transform, dist));
+        commandBounds.push_back(mesh->GetBounds().Transformed(transform));
+        culler.Add(commandBounds.back());
+    }
+
+    // Ordenação por chave: radix sort sobre (chave, índice), a fila em si não se move
+    SortMode sortMode = SortMode::StateKey;
+    std::vector<SortItem> sortItems;
+    std::vector<SortItem> sortScratch;
+
+    // Estado já aplicado no loop de desenho, para pular binds redundantes
+    const Material* boundMaterial = nullptr;
+    int boundPacked = -1;
+
+    // Instancing: comandos consecutivos (na ordem já ordenada) com a mesma mesh,
+    // material e LOD viram um glDrawElementsInstanced. As matrizes de todos os
+    // comandos do frame ficam contíguas no instanceStream.
+    struct DrawBatch {
+        uint32_t first;         // Índice em sortItems do primeiro comando
+        uint32_t count;         // Número de instâncias
+        size_t materialOffset;  // MaterialData no uniformStream (NoMaterialData se não troca)
+    };
+
+    static constexpr size_t NoMaterialData = ~size_t(0);
+
+    bool instancing = true;
+    std::vector<DrawBatch> batches;
+    size_t instanceOffset = 0; // Matriz do primeiro comando ordenado no instanceStream
+
+    // Multi-draw indirect: batches consecutivos de meshes do GeometryArena com o
+    // mesmo VAO (pool) e material viram um glMultiDrawElementsIndirect. Cada
+    // batch tem um comando no indirectStream, no mesmo índice de batches;
+    // baseInstance = batch.first faz os atributos de instância começarem na
+    // matriz certa, então o VAO só precisa apontar para instanceOffset.
+    struct DrawElementsIndirectCommand {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t baseInstance;
+    };
+
+    StreamBuffer indirectStream;
+    bool multiDrawIndirect = true;
+    bool multiDrawSupported = false; // GL 4.3 ou ARB_multi_draw_indirect + ARB_base_instance
+    size_t indirectOffset = 0;
+
+    bool useMultiDraw() const { return multiDrawIndirect && multiDrawSupported; }
+
+    // Tabela de materiais: o material de cada instância é um índice (atributo 9,
+    // array de int32 no instanceStream logo depois das matrizes). Sem troca de
+    // texturas nem de bloco entre draws, o material deixa de separar batches.
+    MaterialTable materialTable;
+    Shader* tableShader = nullptr; // pbr compilado com MATERIAL_TABLE
+    bool materialTableEnabled = false;
+    size_t materialIndexOffset = 0;
+
+    // No deferred a tabela precisa da variante GBUFFER + MATERIAL_TABLE
+    bool useMaterialTable() const {
+        return materialTableEnabled && tableShader && (!useDeferred() || gbufferTableShader);
+    }
+
+    // Deferred: o passe opaco grava o G-buffer (pbr.frag com GBUFFER) e a luz é
+    // calculada depois em tela cheia (deferred_lighting.frag), com as mesmas
+    // funções de pbr_common.glsl, luzes em clusters e IBL. O custo de luz passa a
+    // ser por pixel visível em vez de por fragmento desenhado (overdraw).
+    GBuffer gbuffer;
+    Shader* gbufferShader = nullptr;
+    Shader* gbufferTableShader = nullptr;
+    Shader* lightingShader = nullptr;
+    bool deferred = false;
+
+    static constexpr unsigned int GBufferFirstUnit = 0; // O passe de luz não usa texturas de material
+
+    bool useDeferred() const { return deferred && gbufferShader && lightingShader; }
+
+    // Unidades do IBL: depois das seis texturas que um Material::Apply pode ligar (0-5)
+    static constexpr unsigned int IrradianceUnit = 10;
+    static constexpr unsigned int PrefilterUnit = 11;
+    static constexpr unsigned int BrdfUnit = 12;
+
+    // Fim (exclusivo) do grupo de batches que começa em begin e pode ir num único multi-draw
+    size_t multiDrawGroupEnd(size_t begin) const {
+        const RenderCommand& first = opaqueQueue[sortItems[batches[begin].first].index];
+        size_t end = begin + 1;
+        if (!first.mesh->IsInArena()) return end;
+        while (end < batches.size()) {
+            const RenderCommand& cmd = opaqueQueue[sortItems[batches[end].first].index];
+            if (!cmd.mesh->IsInArena() || cmd.mesh->GetVAO() != first.mesh->GetVAO()) break;
+            if (!useMaterialTable() && cmd.material != first.material) break;
+            end++;
+        }
+        return end;
+    }
+
+    void buildBatches() {
+        batches.clear();
+        for (size_t i = 0; i < sortItems.size(); i++) {
+            const RenderCommand& cmd = opaqueQueue[sortItems[i].index];
+            if (instancing && !batches.empty()) {
+                const RenderCommand& first = opaqueQueue[sortItems[batches.back().first].index];
+                bool sameMaterial = useMaterialTable() || first.material == cmd.material;
+                if (first.mesh == cmd.mesh && sameMaterial && first.lod == cmd.lod) {
+                    batches.back().count++;
+                    continue;
+                }
+            }
+            batches.push_back(DrawBatch{ static_cast<uint32_t>(i), 1, NoMaterialData });
+        }
+    }
+
+    static size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief Escreve todos os dados do frame nos StreamBuffers: FrameData,
+     * um MaterialData por troca de material e as matrizes na ordem dos draws.
+     * @return false se não houve espaço (o frame não é desenhado)
+     */
+    bool writeFrameStreams() {
+        const RenderCommand* previous = nullptr;
+        size_t materialSwitches = 0;
+        for (const auto& batch : batches) {
+            if (useMaterialTable()) break; // Materiais vão pela tabela
+            const RenderCommand& cmd = opaqueQueue[sortItems[batch.first].index];
+            if (cmd.material && (!previous || previous->material != cmd.material)) materialSwitches++;
+            previous = &cmd;
+        }
+
+        // Espaço extra para um FrameData do skybox com outra câmera
+        size_t uniformAlign = uniformStream.GetAlignment();
+        uniformStream.Reserve(alignUp(sizeof(FrameUniforms), uniformAlign) * 2 +
+                              alignUp(sizeof(MaterialUniforms), uniformAlign) * materialSwitches);
+        instanceStream.Reserve(sortItems.size() * (sizeof(glm::mat4) + sizeof(int32_t) + sizeof(glm::uvec2)) +
+                               sizeof(glm::mat4) * 2);
+        if (useMultiDraw()) indirectStream.Reserve(batches.size() * sizeof(DrawElementsIndirectCommand));
+
+        uploadFrameData();
+
+        previous = nullptr;
+        for (auto& batch : batches) {
+            if (useMaterialTable()) break;
+            const RenderCommand& cmd = opaqueQueue[sortItems[batch.first].index];
+            if (cmd.material && (!previous || previous->material != cmd.material)) {
+                MaterialUniforms data = cmd.material->GetUniformData();
+                long long offset = uniformStream.Write(&data, sizeof(data));
+                if (offset < 0) return false;
+                batch.materialOffset = static_cast<size_t>(offset);
+            }
+            previous = &cmd;
+        }
+
+        if (!sortItems.empty()) {
+            StreamBuffer::Allocation allocation = instanceStream.Allocate(sortItems.size() * sizeof(glm::mat4));
+            if (!allocation.data) return false;
+            glm::mat4* transforms = static_cast<glm::mat4*>(allocation.data);
+            for (size_t i = 0; i < sortItems.size(); i++) {
+                transforms[i] = opaqueQueue[sortItems[i].index].transform;
+            }
+            instanceOffset = allocation.offset;
+        }
+
+        if (useMaterialTable() && !sortItems.empty()) {
+            StreamBuffer::Allocation allocation = instanceStream.Allocate(sortItems.size() * sizeof(int32_t));
+            if (!allocation.data) return false;
+            int32_t* materialIndices = static_cast<int32_t*>(allocation.data);
+            const Material* material = nullptr;
+            int32_t index = 0;
+            for (size_t i = 0; i < sortItems.size(); i++) {
+                const RenderCommand& cmd = opaqueQueue[sortItems[i].index];
+                if (cmd.material != material) {
+                    material = cmd.material;
+                    index = material ? static_cast<int32_t>(materialTable.Resolve(*material)) : 0;
+                }
+                materialIndices[i] = index;
+            }
+            materialIndexOffset = allocation.offset;
+            materialTable.Upload();
+        }
+
+        if (!sortItems.empty()) {
+            StreamBuffer::Allocation allocation = instanceStream.Allocate(sortItems.size() * sizeof(glm::uvec2));
+            if (!allocation.data) return false;
+            glm::uvec2* drawLights = static_cast<glm::uvec2*>(allocation.data);
+            for (size_t i = 0; i < sortItems.size(); i++) {
+                drawLights[i] = frameDrawLights ? lightBinner.GetDrawRange(sortItems[i].index) : glm::uvec2(0u, NoDrawLights);
+            }
+            drawLightsOffset = allocation.offset;
+        }
+
+        if (useMultiDraw() && !batches.empty()) {
+            StreamBuffer::Allocation allocation = indirectStream.Allocate(batches.size() * sizeof(DrawElementsIndirectCommand));
+            if (!allocation.data) return false;
+            DrawElementsIndirectCommand* commands = static_cast<DrawElementsIndirectCommand*>(allocation.data);
+            for (size_t i = 0; i < batches.size(); i++) {
+                const RenderCommand& cmd = opaqueQueue[sortItems[batches[i].first].index];
+                const MeshLOD& lod = cmd.mesh->GetLOD(cmd.lod);
+                commands[i] = DrawElementsIndirectCommand{
+                    lod.indexCount, batches[i].count,
+                    cmd.mesh->GetFirstIndex() + lod.indexOffset,
+                    cmd.mesh->GetBaseVertex(), batches[i].first
+                };
+            }
+            indirectOffset = allocation.offset;
+        }
+
+        uniformStream.Flush();
+        instanceStream.Flush();
+        indirectStream.Flush();
+        return true;
+    }
+
+    void sortOpaqueQueue() {
+        auto start = std::chrono::steady_clock::now();
+
+        float maxDistance = 0.0f;
+        for (const auto& cmd : opaqueQueue) maxDistance = glm::max(maxDistance, cmd.distanceToCamera);
+
+        uint32_t shaderID = opaqueShader ? opaqueShader->GetProgramID() : 0;
+        sortItems.resize(opaqueQueue.size());
+        for (size_t i = 0; i < opaqueQueue.size(); i++) {
+            const RenderCommand& cmd = opaqueQueue[i];
+            uint32_t depth = SortKey::QuantizeDepth(cmd.distanceToCamera, maxDistance);
+            uint64_t key = SortKey::MakeDepthOnly(depth);
+            if (sortMode == SortMode::StateKey) {
+                // Com a tabela o material não troca estado: só o VAO e a mesh importam
+                uint32_t materialID = (cmd.material && !useMaterialTable()) ? cmd.material->GetID() : 0;
+                key = SortKey::Make(shaderID, materialID, cmd.mesh->GetVAO(), cmd.mesh->GetSortID(), depth);
+            }
+            sortItems[i] = SortItem{ key, static_cast<uint32_t>(i) };
+        }
+        RadixSort(sortItems, sortScratch);
+
+        stats.sortMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Luzes para os clusters: só as que tocam algum draw visível (ou todas, sem binning)
+    const PointLightData* binPointLights() {
+        frameLightCount = pointLights.size();
+        frameDrawLights = false;
+        if (!lightBinning || pointLights.empty()) return pointLights.data();
+
+        lightBinner.Bin(frustum, sceneData.viewMatrix, sceneData.projectionMatrix, viewportWidth, viewportHeight,
+                        pointLights.data(), pointLights.size(), commandBounds.data(), commandBounds.size());
+        const std::vector<uint32_t>& used = lightBinner.GetUsedLights();
+        binnedLights.resize(used.size());
+        for (size_t i = 0; i < used.size(); i++) binnedLights[i] = pointLights[used[i]];
+        frameLightCount = binnedLights.size();
+
+        const LightBinner::Stats& binStats = lightBinner.GetStats();
+        stats.lightsInFrustum = binStats.visibleLights;
+        stats.lightsUsed = binStats.usedLights;
+        stats.drawLightIndices = binStats.drawIndices;
+        stats.lightBinMs = binStats.TotalMs();
+        frameDrawLights = !useDeferred(); // O passe de luz do deferred não sabe de que draw veio o pixel
+        return binnedLights.data();
+    }
+
+    // Remove da fila opaca os comandos fora do frustum, preservando a ordem
+    void cullOpaqueQueue() {
+        auto start = std::chrono::steady_clock::now();
+
+        size_t total = opaqueQueue.size();
+        size_t visibleCount = total;
+        if (frustumCulling) {
+            visibleCount = culler.Cull(frustum);
+            if (visibleCount < total) {
+                size_t write = 0;
+                for (size_t i = 0; i < total; i++) {
+                    if (!culler.IsVisible(i)) continue;
+                    if (write != i) {
+                        opaqueQueue[write] = opaqueQueue[i];
+                        commandBounds[write] = commandBounds[i];
+                    }
+                    write++;
+                }
+                opaqueQueue.erase(opaqueQueue.begin() + write, opaqueQueue.end());
+                commandBounds.resize(write);
+            }
+        }
+
+        stats.visible = static_cast<uint32_t>(visibleCount);
+        stats.culled = static_cast<uint32_t>(total - visibleCount);
+        stats.cullMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * @brief Escolhe o LOD pelo tamanho projetado do erro de simplificação.
+     * O erro de cada nível está em unidades do objeto; a escala do transform e
+     * a distância até a câmera convertem para pixels na altura do viewport.
+     */
+    uint32_t selectLOD(const Mesh& mesh, const glm::mat4& transform, float dist) const {
+        if (!lodEnabled || mesh.GetLODCount() <= 1) return 0;
+
+        float scale = glm::max(glm::length(glm::vec3(transform[0])),
+                      glm::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+        // proj[1][1] = cot(fov/2): pixels por unidade de mundo a distância 1
+        float pixelsPerUnit = sceneData.projectionMatrix[1][1] * 0.5f * viewportHeight / glm::max(dist, 1e-4f);
+
+        uint32_t level = 0;
+        for (uint32_t i = 1; i < mesh.GetLODCount(); i++) {
+            if (mesh.GetLOD(i).error * scale * pixelsPerUnit > lodPixelError) break;
+            level = i;
+        }
+        return level;
+    }
+
     void initRenderData() {
         // Configuração do Quad de Tela Cheia
         float quadVertices[] = { 
@@ -74,7 +454,7 @@ private:
 
         glGenVertexArrays(1, &screenQuadVAO);
         glGenBuffers(1, &screenQuadVBO);
-        glBindVertexArray(screenQuadVAO);
+        GLState::GetInstance().BindVertexArray(screenQuadVAO);
         glBindBuffer(GL_ARRAY_BUFFER, screenQuadVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
         
@@ -83,7 +463,7 @@ private:
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
         
-        glBindVertexArray(0);
+        GLState::GetInstance().BindVertexArray(0);
 
         // Inicializar Skybox Manager
         if (!skyboxManager.Initialize()) {
@@ -95,7 +475,10 @@ public:
     Renderer() : activeShader(nullptr) {}
 
     ~Renderer() {
-        if (screenQuadVAO) glDeleteVertexArrays(1, &screenQuadVAO);
+        if (screenQuadVAO) {
+            GLState::GetInstance().ForgetVertexArray(screenQuadVAO);
+            glDeleteVertexArrays(1, &screenQuadVAO);
+        }
         if (screenQuadVBO) glDeleteBuffers(1, &screenQuadVBO);
     }
 
@@ -103,8 +486,22 @@ public:
         activeShader = defaultShader;
         skyboxShader = sbShader;
 
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_CULL_FACE);
+        GLState::GetInstance().SetEnabled(GL_DEPTH_TEST, true);
+        GLState::GetInstance().SetEnabled(GL_CULL_FACE, true);
+
+        // Offsets de glBindBufferRange precisam respeitar o alinhamento do driver
+        GLint uniformAlignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+        uniformStream.Create(GL_UNIFORM_BUFFER, 64 * 1024, static_cast<size_t>(std::max(uniformAlignment, 16)));
+        instanceStream.Create(GL_ARRAY_BUFFER, 4096 * sizeof(glm::mat4), sizeof(glm::mat4));
+
+        multiDrawSupported = GLEW_VERSION_4_3 || (GLEW_ARB_multi_draw_indirect && GLEW_ARB_base_instance);
+        if (multiDrawSupported) {
+            indirectStream.Create(GL_DRAW_INDIRECT_BUFFER, 4096 * sizeof(DrawElementsIndirectCommand), sizeof(uint32_t));
+        } else {
+            std::cout << "Renderer: multi-draw indirect indisponível, usando um draw por batch" << std::endl;
+        }
+        materialTable.Init();
 
         initRenderData();
     }
@@ -116,6 +513,62 @@ public:
         useIBL = true;
     }
 
+    // Viewport em pixels: a altura projeta o erro dos LODs; os dois definem a grade de clusters de luz
+    void SetViewport(int width, int height) {
+        viewportWidth = glm::max(width, 1);
+        viewportHeight = glm::max(height, 1);
+    }
+
+    void SetLODEnabled(bool enabled) { lodEnabled = enabled; }
+    bool IsLODEnabled() const { return lodEnabled; }
+    void SetLODPixelError(float pixels) { lodPixelError = pixels; }
+
+    const RenderStats& GetStats() const { return stats; }
+
+    // Frustum da câmera do BeginScene atual (usado também pela BVH da Scene)
+    const Frustum& GetFrustum() const { return frustum; }
+
+    void SetSortMode(SortMode mode) { sortMode = mode; }
+    SortMode GetSortMode() const { return sortMode; }
+
+    // Desligado, cada comando vira um draw com uma instância (para comparação)
+    void SetInstancing(bool enabled) { instancing = enabled; }
+    bool IsInstancingEnabled() const { return instancing; }
+
+    /**
+     * @brief Programa usado quando a tabela de materiais está ligada: o mesmo
+     * pbr.vert/pbr.frag compilado com AddDefine("MATERIAL_TABLE").
+     */
+    void SetMaterialTableShader(Shader* shader) { tableShader = shader; }
+    void SetMaterialTable(bool enabled) { materialTableEnabled = enabled; }
+    bool IsMaterialTableEnabled() const { return useMaterialTable(); }
+    const MaterialTable& GetMaterialTable() const { return materialTable; }
+
+    // Só tem efeito com suporte do driver e meshes criadas com o GeometryArena ligado
+    void SetMultiDrawIndirect(bool enabled) { multiDrawIndirect = enabled; }
+    bool IsMultiDrawIndirectEnabled() const { return useMultiDraw(); }
+    bool IsMultiDrawIndirectSupported() const { return multiDrawSupported; }
+
+    /**
+     * @brief Programas do caminho deferred: pbr.vert/pbr.frag com GBUFFER (e
+     * GBUFFER + MATERIAL_TABLE, opcional) e screen.vert/deferred_lighting.frag.
+     */
+    void SetDeferredShaders(Shader* gbufferPass, Shader* gbufferTablePass, Shader* lighting) {
+        gbufferShader = gbufferPass;
+        gbufferTableShader = gbufferTablePass;
+        lightingShader = lighting;
+    }
+    void SetDeferred(bool enabled) { deferred = enabled; }
+    bool IsDeferredEnabled() const { return useDeferred(); }
+
+    // Sem binning, todas as luzes submetidas vão para os clusters
+    void SetLightBinning(bool enabled) { lightBinning = enabled; }
+    bool IsLightBinningEnabled() const { return lightBinning; }
+    const LightBinner& GetLightBinner() const { return lightBinner; }
+
+    void SetFrustumCulling(bool enabled) { frustumCulling = enabled; }
+    bool IsFrustumCullingEnabled() const { return frustumCulling; }
+
     void BeginScene(const glm::mat4& view, const glm::mat4& proj, const glm::vec3& camPos) {
         sceneData.viewMatrix = view;
         sceneData.projectionMatrix = proj;
@@ -124,8 +577,18 @@ public:
         sceneData.lightColor = glm::vec3(1.0f);
 
         opaqueQueue.clear();
+        commandBounds.clear();
         transparentQueue.clear();
         pointLights.clear();
+        stats = RenderStats();
+
+        frustum = Frustum::FromMatrix(proj * view);
+        culler.Clear();
+
+        // Pode esperar a GPU, se ela ainda lê a região de três frames atrás
+        uniformStream.BeginFrame();
+        instanceStream.BeginFrame();
+        if (multiDrawSupported) indirectStream.BeginFrame();
     }
 
     void SubmitDirectionalLight(const DirectionalLight& light) {
@@ -133,84 +596,105 @@ public:
     }
 
     void SubmitPointLight(const PointLightData& light) {
-        if (pointLights.size() < 4) {
-            pointLights.push_back(light);
-        }
+        pointLights.push_back(light);
     }
 
     void Submit(const std::shared_ptr<Model>& model, const glm::mat4& transform) {
         for(size_t i = 0; i < model->GetMeshCount(); i++) {
             const Mesh& meshRef = model->GetMesh(i);
-            Mesh* meshPtr = const_cast<Mesh*>(&meshRef); 
-            Material* matPtr = meshPtr->GetMaterial().get();
-
-            float dist = glm::length(sceneData.cameraPos - glm::vec3(transform[3]));
-            opaqueQueue.emplace_back(meshPtr, matPtr, transform, dist);
+            enqueueOpaque(const_cast<Mesh*>(&meshRef), transform);
         }
     }
 
     void SubmitMesh(const Mesh& mesh, const glm::mat4& transform) {
-        Mesh* meshPtr = const_cast<Mesh*>(&mesh); 
-        Material* matPtr = meshPtr->GetMaterial().get();
-
-        float dist = glm::length(sceneData.cameraPos - glm::vec3(transform[3]));
-        opaqueQueue.emplace_back(meshPtr, matPtr, transform, dist);
+        enqueueOpaque(const_cast<Mesh*>(&mesh), transform);
     }
 
     void EndScene() {
+        PROFILE_SCOPE("Renderer::EndScene");
+
+        // Deferred: o passe opaco vai para o G-buffer; a luz depois volta para o framebuffer atual
+        GLState& gl = GLState::GetInstance();
+        GLuint target = gl.GetFramebuffer();
+        if (useDeferred() && !prepareGBuffer()) deferred = false;
+
+        if (useDeferred()) opaqueShader = useMaterialTable() ? gbufferTableShader : gbufferShader;
+        else opaqueShader = useMaterialTable() ? tableShader : activeShader;
+
+        {
+            PROFILE_SCOPE("Cull");
+            cullOpaqueQueue();
+        }
+
         // Ordenação
-        std::sort(opaqueQueue.begin(), opaqueQueue.end(), 
-            [](const RenderCommand& a, const RenderCommand& b) {
-                return a.distanceToCamera < b.distanceToCamera;
-            });
-
-        // Configuração Global do Shader
-        activeShader->Use();
-        activeShader->SetMat4("view", glm::value_ptr(sceneData.viewMatrix));
-        activeShader->SetMat4("projection", glm::value_ptr(sceneData.projectionMatrix));
-        activeShader->SetVec3("viewPos", sceneData.cameraPos.x, sceneData.cameraPos.y, sceneData.cameraPos.z);
-        activeShader->SetVec3("lightPos", sceneData.lightPos.x, sceneData.lightPos.y, sceneData.lightPos.z);
-        activeShader->SetVec3("lightColor", sceneData.lightColor.x, sceneData.lightColor.y, sceneData.lightColor.z);
-
-        // Envio de Luzes
-        activeShader->SetVec3("dirLight.direction", sunLight.direction.x, sunLight.direction.y, sunLight.direction.z);
-        activeShader->SetVec3("dirLight.color", sunLight.color.x, sunLight.color.y, sunLight.color.z);
-        activeShader->SetFloat("dirLight.intensity", sunLight.intensity);
-
-        activeShader->SetInt("numPointLights", (int)pointLights.size());
-        
-        for (size_t i = 0; i < pointLights.size(); i++) {
-            std::string base = "pointLights[" + std::to_string(i) + "]";
-            activeShader->SetVec3(base + ".position", pointLights[i].position.x, pointLights[i].position.y, pointLights[i].position.z);
-            activeShader->SetVec3(base + ".color", pointLights[i].color.x, pointLights[i].color.y, pointLights[i].color.z);
-            activeShader->SetFloat(base + ".intensity", pointLights[i].intensity);
-            activeShader->SetFloat(base + ".radius", pointLights[i].radius);
+        {
+            PROFILE_SCOPE("Sort");
+            sortOpaqueQueue();
         }
 
-        if (useIBL) {
-            activeShader->SetBool("useIBL", true);
-            
-            // Slots reservados para IBL (ex: 5, 6, 7)
-            // Assumindo que materiais usam 0, 1, 2, 3, 4
-            glActiveTexture(GL_TEXTURE5);
-            glBindTexture(GL_TEXTURE_CUBE_MAP, iblIrradiance);
-            activeShader->SetInt("irradianceMap", 10);
-
-            glActiveTexture(GL_TEXTURE6);
-            glBindTexture(GL_TEXTURE_CUBE_MAP, iblPrefilter);
-            activeShader->SetInt("prefilterMap", 11);
-
-            glActiveTexture(GL_TEXTURE7);
-            glBindTexture(GL_TEXTURE_2D, iblBrdf);
-            activeShader->SetInt("brdfLUT", 12);
-        } else {
-            activeShader->SetBool("useIBL", false);
+        // Estado fixo do passe opaco (o tracker descarta o que já estiver assim)
+        gl.SetEnabled(GL_DEPTH_TEST, true);
+        gl.SetEnabled(GL_CULL_FACE, true);
+
+        // Luzes pontuais por cluster (antes do FrameData, que leva a grade)
+        {
+            PROFILE_SCOPE("LightClusters");
+            const PointLightData* frameLights = binPointLights();
+            lightClusters.Build(sceneData.viewMatrix, sceneData.projectionMatrix, viewportWidth, viewportHeight,
+                                frameLights, frameLightCount);
+            const std::vector<uint32_t>& drawLights = lightBinner.GetDrawLightIndices();
+            if (frameDrawLights) frameDrawLights = lightClusters.Upload(drawLights.data(), drawLights.size());
+            else lightClusters.Upload();
         }
+        const LightClusters::Stats& clusterStats = lightClusters.GetStats();
+        stats.pointLights = static_cast<uint32_t>(pointLights.size());
+        stats.lightIndices = clusterStats.indices;
+        stats.maxLightsPerCluster = clusterStats.maxPerCluster;
+        stats.lightClusterMs = clusterStats.buildMs;
+
+        // Batches + um único upload de câmera, luzes, materiais e matrizes
+        bool framePrepared;
+        {
+            PROFILE_SCOPE("Batches");
+            buildBatches();
+            framePrepared = writeFrameStreams();
+        }
+        if (!framePrepared) std::cerr << "Renderer: StreamBuffer sem espaço, frame descartado" << std::endl;
+
+        if (gl.GetProgram() != opaqueShader->GetProgramID()) stats.shaderBinds++;
+        opaqueShader->Use();
 
-        // Render Loop
-        for (const auto& cmd : opaqueQueue) {
-            RenderMesh(cmd);
+        if (useDeferred()) gbuffer.Bind();
+        else bindLightingInputs(*opaqueShader);
+
+        if (useMaterialTable()) {
+            materialTable.Bind();
+            for (int i = 0; i < MaterialTable::MaxTextureArrays; i++) {
+                opaqueShader->SetInt(Uniforms::MaterialTextures[i], static_cast<int>(MaterialTable::FirstTextureUnit) + i);
+            }
         }
+
+        // Render Loop (o GL_ARRAY_BUFFER fica no instanceStream durante o loop)
+        boundMaterial = nullptr;
+        boundPacked = -1;
+        if (framePrepared) {
+            PROFILE_SCOPE("Draw");
+            glBindBuffer(GL_ARRAY_BUFFER, instanceStream.GetID());
+            if (useMultiDraw()) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectStream.GetID());
+            for (size_t b = 0; b < batches.size();) {
+                size_t end = useMultiDraw() ? multiDrawGroupEnd(b) : b + 1;
+                if (end - b > 1) RenderMultiDraw(b, end);
+                else RenderBatch(opaqueQueue[sortItems[batches[b].first].index], batches[b]);
+                b = end;
+            }
+        }
+
+        if (useDeferred()) {
+            PROFILE_SCOPE("DeferredLighting");
+            renderLightingPass(target);
+        }
+
+        collectStreamStats();
     }
 
     /**
@@ -223,60 +707,71 @@ public:
         if (!skyboxShader || !skyboxManager.IsInitialized()) {
             return;
         }
+        PROFILE_SCOPE("Renderer::DrawSkybox");
 
         // Salvar e modificar estados OpenGL
-        glDepthFunc(GL_LEQUAL);
-        GLboolean cullFaceWasEnabled = glIsEnabled(GL_CULL_FACE);
-        glDisable(GL_CULL_FACE);
+        GLState& gl = GLState::GetInstance();
+        gl.SetDepthFunc(GL_LEQUAL);
+        bool cullFaceWasEnabled = gl.IsEnabled(GL_CULL_FACE);
+        gl.SetEnabled(GL_CULL_FACE, false);
         
+        // Câmera vem do FrameData; só reenvia se for diferente da do EndScene
+        if (view != frameData.view || proj != frameData.projection) {
+            frameData.view = view;
+            frameData.projection = proj;
+            frameData.viewProjection = proj * view;
+            long long offset = uniformStream.Write(&frameData, sizeof(frameData));
+            if (offset >= 0) {
+                frameDataOffset = static_cast<size_t>(offset);
+                uniformStream.Flush();
+                GLState::GetInstance().BindUniformBufferRange(UniformBlocks::FrameBinding, uniformStream.GetID(),
+                                                              static_cast<GLintptr>(frameDataOffset), sizeof(FrameUniforms));
+            }
+        }
+
         // Configurar shader
         skyboxShader->Use();
-        skyboxShader->SetMat4("view", glm::value_ptr(view));
-        skyboxShader->SetMat4("projection", glm::value_ptr(proj));
-        skyboxShader->SetInt("skybox", 0);
+        skyboxShader->SetInt(Uniforms::Skybox, 0);
 
         // Bind cubemap
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapID);
+        gl.BindTexture(0, GL_TEXTURE_CUBE_MAP, cubemapID);
         
         // Renderizar usando SkyboxManager
         skyboxManager.Render();
 
         // Restaurar estados
-        glDepthFunc(GL_LESS);
-        if (cullFaceWasEnabled) glEnable(GL_CULL_FACE);
+        gl.SetDepthFunc(GL_LESS);
+        if (cullFaceWasEnabled) gl.SetEnabled(GL_CULL_FACE, true);
     }
 
     void SetSkyboxShader(Shader* s) { 
         skyboxShader = s; 
     }
 
+    // Passe de tela cheia: deixa o depth test desligado; quem precisa dele
+    // (FrameBuffer::Bind, EndScene) liga de novo pelo GLState
     void DrawScreenQuad(Shader& screenShader, unsigned int textureID) {
-        glDisable(GL_DEPTH_TEST);
+        GLState& gl = GLState::GetInstance();
+        gl.SetEnabled(GL_DEPTH_TEST, false);
         
         screenShader.Use();
-        screenShader.SetInt("screenTexture", 0);
+        screenShader.SetInt(Uniforms::ScreenTexture, 0);
         
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        gl.BindTexture(0, GL_TEXTURE_2D, textureID);
         
-        glBindVertexArray(screenQuadVAO);
+        gl.BindVertexArray(screenQuadVAO);
         glDrawArrays(GL_TRIANGLES, 0, 6);
-        glBindVertexArray(0);
-        
-        glEnable(GL_DEPTH_TEST);
     }
     
     void DrawScreenQuad() {
-        glDisable(GL_DEPTH_TEST);
-        glBindVertexArray(screenQuadVAO);
+        GLState& gl = GLState::GetInstance();
+        gl.SetEnabled(GL_DEPTH_TEST, false);
+        gl.BindVertexArray(screenQuadVAO);
         glDrawArrays(GL_TRIANGLES, 0, 6);
-        glBindVertexArray(0);
-        glEnable(GL_DEPTH_TEST);
     }
 
     void DebugCubemap(unsigned int cubemapID, const char* name) {
-        glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapID);
+        GLState::GetInstance().BindTexture(GL_TEXTURE_CUBE_MAP, cubemapID);
         
         GLint width, height, format;
         glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_WIDTH, &width);
@@ -301,27 +796,181 @@ public:
         glGetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, &maxLevel);
         std::cout << "  - Max Mip Level: " << maxLevel << std::endl;
         
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        GLState::GetInstance().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
     }
     
 private:
-    void RenderMesh(const RenderCommand& cmd) {
-        if (cmd.material) {
-            cmd.material->Apply(activeShader->GetProgramID());
-            
-            activeShader->SetBool("hasTextureDiffuse", cmd.material->HasTextureType(TextureType::DIFFUSE));
-            activeShader->SetBool("hasTextureNormal", cmd.material->HasTextureType(TextureType::NORMAL));
-            activeShader->SetBool("hasTextureMetallic", cmd.material->HasTextureType(TextureType::METALLIC));
-            activeShader->SetBool("hasTextureRoughness", cmd.material->HasTextureType(TextureType::ROUGHNESS));
-            activeShader->SetBool("hasTextureAO", cmd.material->HasTextureType(TextureType::AO));
-            activeShader->SetBool("hasTextureEmission", cmd.material->HasTextureType(TextureType::EMISSION));
+    // Monta o bloco FrameData e escreve no uniformStream
+    void uploadFrameData() {
+        frameData.view = sceneData.viewMatrix;
+        frameData.projection = sceneData.projectionMatrix;
+        frameData.viewProjection = sceneData.projectionMatrix * sceneData.viewMatrix;
+        frameData.viewPos = sceneData.cameraPos;
+        frameData.lightPos = glm::vec4(sceneData.lightPos, 1.0f);
+        frameData.lightColor = glm::vec4(sceneData.lightColor, 1.0f);
+
+        frameData.dirLight.direction = sunLight.direction;
+        frameData.dirLight.color = sunLight.color;
+        frameData.dirLight.intensity = sunLight.intensity;
+
+        // As luzes pontuais vão para os texture buffers do LightClusters; aqui só a grade
+        frameData.clusterDims = lightClusters.GetDimensions();
+        frameData.clusterDepth = lightClusters.GetDepthParams();
+        frameData.numPointLights = static_cast<int32_t>(frameLightCount);
+        frameData.useIBL = useIBL ? 1 : 0;
+
+        long long offset = uniformStream.Write(&frameData, sizeof(frameData));
+        if (offset < 0) return;
+        frameDataOffset = static_cast<size_t>(offset);
+        GLState::GetInstance().BindUniformBufferRange(UniformBlocks::FrameBinding, uniformStream.GetID(),
+                                                      static_cast<GLintptr>(frameDataOffset), sizeof(FrameUniforms));
+    }
+
+    // Cria o G-buffer na primeira vez e acompanha o tamanho do viewport
+    bool prepareGBuffer() {
+        if (gbuffer.IsInitialized()) {
+            gbuffer.Resize(viewportWidth, viewportHeight);
+            return true;
+        }
+        if (gbuffer.Init(viewportWidth, viewportHeight)) return true;
+        std::cerr << "Renderer: G-buffer indisponível, voltando para o forward" << std::endl;
+        return false;
+    }
+
+    // Luzes em clusters e IBL para o programa que calcula a luz (pbr.frag no forward, passe de luz no deferred)
+    void bindLightingInputs(const Shader& shader) {
+        lightClusters.Bind();
+        shader.SetInt(Uniforms::ClusterLights, static_cast<int>(LightClusters::LightsUnit));
+        shader.SetInt(Uniforms::ClusterRanges, static_cast<int>(LightClusters::RangesUnit));
+        shader.SetInt(Uniforms::ClusterIndices, static_cast<int>(LightClusters::IndicesUnit));
+        shader.SetInt(Uniforms::DrawLightIndices, static_cast<int>(LightClusters::DrawIndicesUnit));
+
+        if (useIBL) {
+            GLState& gl = GLState::GetInstance();
+            gl.BindTexture(IrradianceUnit, GL_TEXTURE_CUBE_MAP, iblIrradiance);
+            shader.SetInt(Uniforms::IrradianceMap, static_cast<int>(IrradianceUnit));
+
+            gl.BindTexture(PrefilterUnit, GL_TEXTURE_CUBE_MAP, iblPrefilter);
+            shader.SetInt(Uniforms::PrefilterMap, static_cast<int>(PrefilterUnit));
+
+            gl.BindTexture(BrdfUnit, GL_TEXTURE_2D, iblBrdf);
+            shader.SetInt(Uniforms::BrdfLUT, static_cast<int>(BrdfUnit));
         }
+    }
 
-        activeShader->SetMat4("model", glm::value_ptr(cmd.transform));
+    /**
+     * @brief Passe de luz do deferred: um quad de tela cheia lê o G-buffer e
+     * escreve a cor final no framebuffer que estava ligado no EndScene. A
+     * profundidade é copiada antes para o skybox continuar atrás da cena.
+     */
+    void renderLightingPass(GLuint target) {
+        GLState& gl = GLState::GetInstance();
+        gl.BindFramebuffer(target);
+        gl.SetViewport(0, 0, viewportWidth, viewportHeight);
+        gbuffer.BlitDepth(target);
+
+        if (gl.GetProgram() != lightingShader->GetProgramID()) stats.shaderBinds++;
+        lightingShader->Use();
+
+        gbuffer.BindTextures(GBufferFirstUnit);
+        lightingShader->SetInt(Uniforms::GAlbedoMetallic, static_cast<int>(GBufferFirstUnit + GBuffer::AlbedoMetallic));
+        lightingShader->SetInt(Uniforms::GNormalRoughness, static_cast<int>(GBufferFirstUnit + GBuffer::NormalRoughness));
+        lightingShader->SetInt(Uniforms::GEmissionAO, static_cast<int>(GBufferFirstUnit + GBuffer::EmissionAO));
+        lightingShader->SetInt(Uniforms::GDepth, static_cast<int>(GBufferFirstUnit + GBuffer::TargetCount));
+
+        glm::mat4 inverseViewProjection = glm::inverse(frameData.viewProjection);
+        lightingShader->SetMat4(Uniforms::InverseViewProjection, glm::value_ptr(inverseViewProjection));
+        bindLightingInputs(*lightingShader);
+
+        DrawScreenQuad();
+        stats.drawCalls++;
+
+        // DrawScreenQuad desliga o depth test; o skybox testa contra a profundidade copiada
+        gl.SetEnabled(GL_DEPTH_TEST, true);
+    }
+
+    void collectStreamStats() {
+        StreamBuffer::Stats streams = uniformStream.ResetStats();
+        streams.Add(instanceStream.ResetStats());
+        streams.Add(indirectStream.ResetStats());
+        streams.Add(lightClusters.ResetStreamStats());
+        stats.streamBytes = streams.bytes;
+        stats.streamWaits = streams.waits;
+        stats.streamWaitMs = streams.waitMs;
+    }
+
+    // Material e formato de vértice do comando, pulando o que já está aplicado
+    void bindCommandState(const RenderCommand& cmd, const DrawBatch& batch) {
+        // Material igual ao do draw anterior: texturas e uniforms já estão no programa
+        if (cmd.material && cmd.material != boundMaterial && !useMaterialTable()) {
+            cmd.material->Apply(opaqueShader->GetProgramID());
+            if (batch.materialOffset != NoMaterialData) {
+                GLState::GetInstance().BindUniformBufferRange(UniformBlocks::MaterialBinding, uniformStream.GetID(),
+                                                              static_cast<GLintptr>(batch.materialOffset), sizeof(MaterialUniforms));
+            }
 
-        glBindVertexArray(cmd.mesh->GetVAO());
-        glDrawElements(GL_TRIANGLES, cmd.mesh->GetIndexCount(), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+            boundMaterial = cmd.material;
+            stats.materialBinds++;
+        }
+
+        int packed = cmd.mesh->IsPacked() ? 1 : 0;
+        if (packed != boundPacked) {
+            opaqueShader->SetBool(Uniforms::PackedVertex, packed != 0);
+            boundPacked = packed;
+        }
+
+        GLState& gl = GLState::GetInstance();
+        if (cmd.mesh->GetVAO() != gl.GetVertexArray()) stats.vaoBinds++;
+        gl.BindVertexArray(cmd.mesh->GetVAO());
+    }
+
+    void countDraw(const RenderCommand& cmd, uint32_t instanceCount) {
+        const MeshLOD& lod = cmd.mesh->GetLOD(cmd.lod);
+        stats.instances += instanceCount;
+        stats.triangles += static_cast<uint64_t>(lod.indexCount / 3) * instanceCount;
+        stats.trianglesLOD0 += static_cast<uint64_t>(cmd.mesh->GetIndexCount() / 3) * instanceCount;
+        stats.lodDraws[std::min<uint32_t>(cmd.lod, 3)] += instanceCount;
+    }
+
+    void RenderBatch(const RenderCommand& cmd, const DrawBatch& batch) {
+        bindCommandState(cmd, batch);
+
+        // Matrizes do batch: os atributos 5-8 do VAO apontam para a faixa dele no instanceStream
+        SetupInstanceAttributes(instanceOffset + static_cast<size_t>(batch.first) * sizeof(glm::mat4));
+        if (useMaterialTable()) SetupInstanceMaterialAttribute(materialIndexOffset + static_cast<size_t>(batch.first) * sizeof(int32_t));
+        SetupInstanceDrawLightsAttribute(drawLightsOffset + static_cast<size_t>(batch.first) * sizeof(glm::uvec2));
+
+        // Todos os LODs dividem o mesmo EBO; o nível escolhido é só uma faixa de índices.
+        // No GeometryArena a faixa da mesh começa em firstIndex/baseVertex do pool.
+        const MeshLOD& lod = cmd.mesh->GetLOD(cmd.lod);
+        size_t firstIndex = static_cast<size_t>(cmd.mesh->GetFirstIndex()) + lod.indexOffset;
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, lod.indexCount, cmd.mesh->GetIndexType(),
+                                          (void*)(firstIndex * cmd.mesh->GetIndexSize()),
+                                          static_cast<GLsizei>(batch.count), cmd.mesh->GetBaseVertex());
+
+        stats.drawCalls++;
+        countDraw(cmd, batch.count);
+    }
+
+    // Batches [begin, end) em um draw: mesmo VAO e material, comandos já no indirectStream
+    void RenderMultiDraw(size_t begin, size_t end) {
+        const RenderCommand& first = opaqueQueue[sortItems[batches[begin].first].index];
+        bindCommandState(first, batches[begin]);
+
+        // baseInstance de cada comando desloca a leitura a partir da primeira matriz do frame
+        SetupInstanceAttributes(instanceOffset);
+        if (useMaterialTable()) SetupInstanceMaterialAttribute(materialIndexOffset);
+        SetupInstanceDrawLightsAttribute(drawLightsOffset);
+
+        glMultiDrawElementsIndirect(GL_TRIANGLES, first.mesh->GetIndexType(),
+                                    (void*)(indirectOffset + begin * sizeof(DrawElementsIndirectCommand)),
+                                    static_cast<GLsizei>(end - begin), 0);
+
+        stats.drawCalls++;
+        stats.indirectCommands += static_cast<uint32_t>(end - begin);
+        for (size_t b = begin; b < end; b++) {
+            countDraw(opaqueQueue[sortItems[batches[b].first].index], batches[b].count);
+        }
     }
 };
 
@@ -6,6 +6,49 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
+#include "gl_state.hpp"
+#include "uniform_buffer.hpp"
+#include "../core/hash.hpp"
+
+/**
+ * @brief Nome de uniform já convertido em hash (FNV-1a).
+ * Com constexpr o hash é calculado em tempo de compilação.
+ */
+struct UniformID {
+    uint64_t hash;
+
+    constexpr explicit UniformID(const char* name) : hash(Hash::FNV1a(name)) {}
+    explicit UniformID(const std::string& name) : hash(Hash::FNV1a(name)) {}
+};
+
+// Uniforms soltos usados a cada draw ou a cada frame (câmera, luzes e
+// propriedades de material ficam nos blocos de uniform_buffer.hpp)
+namespace Uniforms {
+    constexpr UniformID Model("model");
+    constexpr UniformID PackedVertex("packedVertex");
+    constexpr UniformID IrradianceMap("irradianceMap");
+    constexpr UniformID PrefilterMap("prefilterMap");
+    constexpr UniformID BrdfLUT("brdfLUT");
+    constexpr UniformID Skybox("skybox");
+    constexpr UniformID ScreenTexture("screenTexture");
+    constexpr UniformID ClusterLights("clusterLights");
+    constexpr UniformID ClusterRanges("clusterRanges");
+    constexpr UniformID ClusterIndices("clusterIndices");
+    constexpr UniformID DrawLightIndices("drawLightIndices");
+    // Passe de luz do deferred (deferred_lighting.frag)
+    constexpr UniformID GAlbedoMetallic("gAlbedoMetallic");
+    constexpr UniformID GNormalRoughness("gNormalRoughness");
+    constexpr UniformID GEmissionAO("gEmissionAO");
+    constexpr UniformID GDepth("gDepth");
+    constexpr UniformID InverseViewProjection("inverseViewProjection");
+    // sampler2DArray dos arrays da MaterialTable (pbr.frag com MATERIAL_TABLE)
+    constexpr UniformID MaterialTextures[] = {
+        UniformID("materialTextures[0]"), UniformID("materialTextures[1]"),
+        UniformID("materialTextures[2]"), UniformID("materialTextures[3]")
+    };
+}
 
 class Shader
 {
@@ -13,6 +56,127 @@ private:
     unsigned int programID;
     bool compiled;
 
+    // hash do nome -> location, preenchido uma vez depois do link
+    std::unordered_map<uint64_t, GLint> locations;
+
+    // Macros inseridas logo depois do #version de cada estágio (variantes do mesmo arquivo)
+    std::vector<std::string> defines;
+
+    std::string applyDefines(const char* source) const {
+        std::string code(source);
+        if (defines.empty()) return code;
+
+        std::string block;
+        for (const auto& define : defines) block += "#define " + define + "\n";
+
+        // #line mantém os números de linha dos erros iguais aos do arquivo
+        size_t versionEnd = 0;
+        if (code.compare(0, 8, "#version") == 0) {
+            versionEnd = code.find('\n');
+            versionEnd = versionEnd == std::string::npos ? code.size() : versionEnd + 1;
+            block += "#line 2\n";
+        }
+        code.insert(versionEnd, block);
+        return code;
+    }
+
+    static bool readFile(const std::string& path, std::string& out) {
+        std::ifstream file(path);
+        if (!file) return false;
+        std::stringstream stream;
+        stream << file.rdbuf();
+        out = stream.str();
+        return true;
+    }
+
+    /**
+     * @brief Troca cada linha #include "arquivo" pelo conteúdo do arquivo
+     * (relativo ao diretório do shader), recursivamente. O GLSL 3.30 não tem
+     * include; assim o pbr.frag e o passe de luz do deferred dividem as funções
+     * de pbr_common.glsl. #line volta a numeração do arquivo depois do trecho.
+     */
+    bool resolveIncludes(std::string& code, const std::string& directory, int depth = 0) const {
+        if (depth > 8) {
+            std::cerr << "Erro: #include aninhado demais em " << directory << std::endl;
+            return false;
+        }
+
+        std::istringstream input(code);
+        std::string result;
+        std::string line;
+        int lineNumber = 0;
+        bool found = false;
+        while (std::getline(input, line)) {
+            lineNumber++;
+            size_t start = line.find_first_not_of(" \t");
+            if (start == std::string::npos || line.compare(start, 8, "#include") != 0) {
+                result += line + "\n";
+                continue;
+            }
+
+            size_t open = line.find('"', start);
+            size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+            if (close == std::string::npos) {
+                std::cerr << "Erro: #include mal formado: " << line << std::endl;
+                return false;
+            }
+
+            std::string path = directory + line.substr(open + 1, close - open - 1);
+            std::string included;
+            if (!readFile(path, included)) {
+                std::cerr << "Erro ao ler include de shader: " << path << std::endl;
+                return false;
+            }
+            size_t slash = path.find_last_of("/\\");
+            if (!resolveIncludes(included, slash == std::string::npos ? "" : path.substr(0, slash + 1), depth + 1)) return false;
+
+            result += "#line 1\n" + included + "\n#line " + std::to_string(lineNumber + 1) + "\n";
+            found = true;
+        }
+        if (found) code = result;
+        return true;
+    }
+
+    /**
+     * @brief Lê todos os uniforms ativos do programa.
+     * Arrays aparecem como "nome[0]": registramos "nome", "nome[0]" e cada
+     * elemento "nome[i]". Campos de arrays de structs (ex: "pointLights[1].color")
+     * já vêm um a um do driver.
+     */
+    void introspect() {
+        locations.clear();
+
+        GLint count = 0;
+        GLint maxLength = 0;
+        glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        if (count <= 0 || maxLength <= 0) return;
+
+        std::vector<char> buffer(maxLength);
+        for (GLint i = 0; i < count; i++) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(programID, static_cast<GLuint>(i), maxLength, &length, &size, &type, buffer.data());
+
+            std::string name(buffer.data(), length);
+            GLint location = glGetUniformLocation(programID, name.c_str());
+            if (location < 0) continue; // Uniforms de blocos (UBO) não têm location
+
+            locations[Hash::FNV1a(name)] = location;
+
+            if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+                std::string base = name.substr(0, name.size() - 3);
+                locations[Hash::FNV1a(base)] = location;
+                for (GLint element = 1; element < size; element++) {
+                    std::string elementName = base + "[" + std::to_string(element) + "]";
+                    GLint elementLocation = glGetUniformLocation(programID, elementName.c_str());
+                    if (elementLocation >= 0) locations[Hash::FNV1a(elementName)] = elementLocation;
+                }
+            }
+        }
+    }
+
     unsigned int compileShader(const char* source, GLenum type) {
         unsigned int shader = glCreateShader(type);
         glShaderSource(shader, 1, &source, NULL);
@@ -47,28 +211,58 @@ private:
         
         glDeleteShader(vertexShader);
         glDeleteShader(fragmentShader);
+
+        introspect();
+        bindUniformBlocks();
         return true;
     }
 
+    // Liga os blocos compartilhados (FrameData, MaterialData) aos binding points fixos
+    void bindUniformBlocks() {
+        GLint count = 0;
+        GLint maxLength = 0;
+        glGetProgramiv(programID, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+        glGetProgramiv(programID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+        if (count <= 0 || maxLength <= 0) return;
+
+        std::vector<char> buffer(maxLength);
+        for (GLint i = 0; i < count; i++) {
+            glGetActiveUniformBlockName(programID, static_cast<GLuint>(i), maxLength, nullptr, buffer.data());
+            int binding = UniformBlocks::BindingFor(buffer.data());
+            if (binding >= 0) {
+                glUniformBlockBinding(programID, static_cast<GLuint>(i), static_cast<GLuint>(binding));
+            } else {
+                std::cerr << "Aviso: uniform block '" << buffer.data() << "' sem binding conhecido" << std::endl;
+            }
+        }
+    }
+
 public:
     Shader() : programID(0), compiled(false) {}
 
     ~Shader() {
         if (compiled) {
+            GLState::GetInstance().ForgetProgram(programID);
             glDeleteProgram(programID);
         }
     }
 
+    // Ex.: AddDefine("MATERIAL_TABLE") ou AddDefine("MAX_LIGHTS 64"); vale para a próxima compilação
+    void AddDefine(const std::string& define) { defines.push_back(define); }
+    const std::vector<std::string>& GetDefines() const { return defines; }
+
     // Compilar a partir de strings
     bool CompileFromSource(const char* vertexSource, const char* fragmentSource) {
-        unsigned int vertexShader = compileShader(vertexSource, GL_VERTEX_SHADER);
-        unsigned int fragmentShader = compileShader(fragmentSource, GL_FRAGMENT_SHADER);
+        std::string vertexCode = applyDefines(vertexSource);
+        std::string fragmentCode = applyDefines(fragmentSource);
+        unsigned int vertexShader = compileShader(vertexCode.c_str(), GL_VERTEX_SHADER);
+        unsigned int fragmentShader = compileShader(fragmentCode.c_str(), GL_FRAGMENT_SHADER);
         
         compiled = linkProgram(vertexShader, fragmentShader);
         return compiled;
     }
 
-    // Compilar a partir de arquivos
+    // Compilar a partir de arquivos (com #include "arquivo" relativo a cada um)
     bool CompileFromFile(const std::string& vertexPath, const std::string& fragmentPath) {
         std::string vertexCode;
         std::string fragmentCode;
@@ -97,12 +291,19 @@ public:
             return false;
         }
 
+        auto directoryOf = [](const std::string& path) {
+            size_t slash = path.find_last_of("/\\");
+            return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+        };
+        if (!resolveIncludes(vertexCode, directoryOf(vertexPath)) ||
+            !resolveIncludes(fragmentCode, directoryOf(fragmentPath))) return false;
+
         return CompileFromSource(vertexCode.c_str(), fragmentCode.c_str());
     }
 
     void Use() const {
         if (compiled) {
-            glUseProgram(programID);
+            GLState::GetInstance().UseProgram(programID);
         }
     }
 
@@ -110,30 +311,40 @@ public:
         return programID;
     }
 
-    // Utilitários para definir uniforms
-    void SetBool(const std::string& name, bool value) const {
-        glUniform1i(glGetUniformLocation(programID, name.c_str()), (int)value);
+    // Location pela tabela do introspect; -1 se o uniform não existe (o GL ignora)
+    GLint GetLocation(UniformID id) const {
+        auto it = locations.find(id.hash);
+        return it != locations.end() ? it->second : -1;
     }
 
-    void SetInt(const std::string& name, int value) const {
-        glUniform1i(glGetUniformLocation(programID, name.c_str()), value);
-    }
+    GLint GetLocation(const char* name) const { return GetLocation(UniformID(name)); }
+    GLint GetLocation(const std::string& name) const { return GetLocation(UniformID(name)); }
 
-    void SetFloat(const std::string& name, float value) const {
-        glUniform1f(glGetUniformLocation(programID, name.c_str()), value);
-    }
+    bool HasUniform(UniformID id) const { return locations.count(id.hash) != 0; }
+    size_t GetUniformCount() const { return locations.size(); }
 
-    void SetVec3(const std::string& name, float x, float y, float z) const {
-        glUniform3f(glGetUniformLocation(programID, name.c_str()), x, y, z);
-    }
+    // Utilitários para definir uniforms (sem glGetUniformLocation: a tabela já tem tudo)
+    void SetBool(UniformID id, bool value) const { glUniform1i(GetLocation(id), (int)value); }
+    void SetInt(UniformID id, int value) const { glUniform1i(GetLocation(id), value); }
+    void SetFloat(UniformID id, float value) const { glUniform1f(GetLocation(id), value); }
+    void SetVec3(UniformID id, float x, float y, float z) const { glUniform3f(GetLocation(id), x, y, z); }
+    void SetVec3(UniformID id, const float* value) const { glUniform3fv(GetLocation(id), 1, value); }
+    void SetMat4(UniformID id, const float* value) const { glUniformMatrix4fv(GetLocation(id), 1, GL_FALSE, value); }
 
-    void SetVec3(const std::string& name, const float* value) const {
-        glUniform3fv(glGetUniformLocation(programID, name.c_str()), 1, value);
-    }
+    // Versões por nome: hash em tempo de execução, mas sem string temporária para literais
+    void SetBool(const char* name, bool value) const { SetBool(UniformID(name), value); }
+    void SetInt(const char* name, int value) const { SetInt(UniformID(name), value); }
+    void SetFloat(const char* name, float value) const { SetFloat(UniformID(name), value); }
+    void SetVec3(const char* name, float x, float y, float z) const { SetVec3(UniformID(name), x, y, z); }
+    void SetVec3(const char* name, const float* value) const { SetVec3(UniformID(name), value); }
+    void SetMat4(const char* name, const float* value) const { SetMat4(UniformID(name), value); }
 
-    void SetMat4(const std::string& name, const float* value) const {
-        glUniformMatrix4fv(glGetUniformLocation(programID, name.c_str()), 1, GL_FALSE, value);
-    }
+    void SetBool(const std::string& name, bool value) const { SetBool(UniformID(name), value); }
+    void SetInt(const std::string& name, int value) const { SetInt(UniformID(name), value); }
+    void SetFloat(const std::string& name, float value) const { SetFloat(UniformID(name), value); }
+    void SetVec3(const std::string& name, float x, float y, float z) const { SetVec3(UniformID(name), x, y, z); }
+    void SetVec3(const std::string& name, const float* value) const { SetVec3(UniformID(name), value); }
+    void SetMat4(const std::string& name, const float* value) const { SetMat4(UniformID(name), value); }
 
     // Prevenir cópia
     Shader(const Shader&) = delete;
@@ -141,17 +352,21 @@ public:
 
     // Permitir movimentação
     Shader(Shader&& other) noexcept
-        : programID(other.programID), compiled(other.compiled) {
+        : programID(other.programID), compiled(other.compiled), locations(std::move(other.locations)),
+          defines(std::move(other.defines)) {
         other.compiled = false;
     }
 
     Shader& operator=(Shader&& other) noexcept {
         if (this != &other) {
             if (compiled) {
+                GLState::GetInstance().ForgetProgram(programID);
                 glDeleteProgram(programID);
             }
             programID = other.programID;
             compiled = other.compiled;
+            locations = std::move(other.locations);
+            defines = std::move(other.defines);
             other.compiled = false;
         }
         return *this;
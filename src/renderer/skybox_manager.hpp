@@ -167,9 +167,9 @@ public:
             return;
         }
 
-        glBindVertexArray(skyboxMesh->GetVAO());
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-        glBindVertexArray(0);
+        // Base vertex diferente de 0 quando a mesh está no GeometryArena
+        GLState::GetInstance().BindVertexArray(skyboxMesh->GetVAO());
+        glDrawArrays(GL_TRIANGLES, skyboxMesh->GetBaseVertex(), 36);
     }
 
     // Prevenir cópia
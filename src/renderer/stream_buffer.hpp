@@ -0,0 +1,256 @@
+#ifndef STREAM_BUFFER_HPP
+#define STREAM_BUFFER_HPP
+
+#include <GL/glew.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "gl_state.hpp"
+
+/**
+ * @brief Alocador em anel para dados que mudam todo frame (matrizes de
+ * instância, blocos de uniform, listas de luzes).
+ *
+ * O buffer é dividido em FrameCount regiões; cada frame escreve só na sua, e
+ * antes de reutilizar uma região o CPU espera a fence do frame que a usou
+ * (três frames atrás). Com GL_ARB_buffer_storage o buffer fica mapeado o tempo
+ * todo (persistente + coerente) e Allocate devolve um ponteiro direto para ele.
+ * Sem a extensão, Allocate escreve numa cópia em CPU, BeginFrame faz "orphaning"
+ * do buffer e Flush envia a faixa escrita com glBufferSubData.
+ *
+ * Uso por frame: BeginFrame() -> Allocate()... -> Flush() -> draws.
+ */
+class StreamBuffer {
+public:
+    static constexpr int FrameCount = 3;
+
+    struct Stats {
+        uint32_t waits = 0;      // Vezes em que o CPU esperou a GPU liberar a região
+        double waitMs = 0.0;     // Tempo total dessas esperas
+        uint64_t bytes = 0;      // Bytes escritos
+        uint32_t overflows = 0;  // Alocações que não couberam na região
+        uint32_t resizes = 0;    // Realocações do buffer (Reserve)
+
+        void Add(const Stats& other) {
+            waits += other.waits;
+            waitMs += other.waitMs;
+            bytes += other.bytes;
+            overflows += other.overflows;
+            resizes += other.resizes;
+        }
+    };
+
+    struct Allocation {
+        void* data = nullptr; // Onde escrever (nullptr se não coube)
+        size_t offset = 0;    // Offset no buffer GL, para glBindBufferRange/glVertexAttribPointer
+    };
+
+private:
+    GLenum target = GL_ARRAY_BUFFER;
+    GLuint bufferID = 0;
+    size_t regionSize = 0;
+    size_t alignment = 16;
+    bool persistent = false;
+
+    uint8_t* mapped = nullptr;       // Persistente: as FrameCount regiões
+    std::vector<uint8_t> staging;    // Fallback: cópia da região atual
+
+    GLsync fences[FrameCount] = {};
+    int frame = 0;
+    bool frameOpen = false;
+    size_t head = 0;         // Próximo byte livre na região atual
+    size_t flushedHead = 0;  // Fallback: até onde já foi enviado
+
+    Stats stats;
+
+    static size_t alignUp(size_t value, size_t align) {
+        return (value + align - 1) / align * align;
+    }
+
+    size_t regionBase() const { return persistent ? static_cast<size_t>(frame) * regionSize : 0; }
+
+    // Espera a GPU terminar de ler a região (só no modo persistente)
+    void waitFence(int index) {
+        GLsync& fence = fences[index];
+        if (!fence) return;
+
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            auto start = std::chrono::steady_clock::now();
+            stats.waits++;
+            do {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+            } while (result == GL_TIMEOUT_EXPIRED);
+            stats.waitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    void allocateStorage() {
+        glGenBuffers(1, &bufferID);
+        glBindBuffer(target, bufferID);
+
+        if (persistent) {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            GLsizeiptr total = static_cast<GLsizeiptr>(regionSize * FrameCount);
+            glBufferStorage(target, total, nullptr, flags);
+            mapped = static_cast<uint8_t*>(glMapBufferRange(target, 0, total, flags));
+            if (!mapped) {
+                std::cerr << "StreamBuffer: glMapBufferRange falhou, usando orphaning" << std::endl;
+                releaseStorage();
+                persistent = false;
+                allocateStorage();
+            }
+            return;
+        }
+
+        glBufferData(target, static_cast<GLsizeiptr>(regionSize), nullptr, GL_STREAM_DRAW);
+        staging.resize(regionSize);
+    }
+
+    void releaseStorage() {
+        for (int i = 0; i < FrameCount; i++) {
+            if (fences[i]) {
+                glDeleteSync(fences[i]);
+                fences[i] = nullptr;
+            }
+        }
+        if (bufferID) {
+            if (mapped) {
+                glBindBuffer(target, bufferID);
+                glUnmapBuffer(target);
+                mapped = nullptr;
+            }
+            GLState::GetInstance().ForgetUniformBuffer(bufferID);
+            glDeleteBuffers(1, &bufferID);
+            bufferID = 0;
+        }
+    }
+
+public:
+    StreamBuffer() = default;
+    ~StreamBuffer() { releaseStorage(); }
+
+    /**
+     * @brief Cria o buffer.
+     * @param bufferTarget Alvo usado nos binds (GL_ARRAY_BUFFER, GL_UNIFORM_BUFFER...)
+     * @param bytesPerFrame Capacidade de cada região
+     * @param allocAlignment Alinhamento mínimo dos offsets (ex.: GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT)
+     */
+    bool Create(GLenum bufferTarget, size_t bytesPerFrame, size_t allocAlignment = 16) {
+        if (bufferID) return true;
+
+        target = bufferTarget;
+        alignment = allocAlignment > 0 ? allocAlignment : 16;
+        regionSize = alignUp(bytesPerFrame, alignment);
+        persistent = GLEW_ARB_buffer_storage || GLEW_VERSION_4_4;
+
+        allocateStorage();
+        if (!bufferID) {
+            std::cerr << "StreamBuffer: falha ao criar o buffer" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Começa um frame: fecha o anterior com uma fence e passa para a
+     * próxima região, esperando a GPU se ela ainda estiver em uso.
+     */
+    void BeginFrame() {
+        if (!bufferID) return;
+
+        if (persistent) {
+            if (frameOpen) fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            frame = (frame + 1) % FrameCount;
+            waitFence(frame);
+        } else {
+            // Orphaning: o driver entrega memória nova e mantém a antiga até a GPU terminar
+            glBindBuffer(target, bufferID);
+            glBufferData(target, static_cast<GLsizeiptr>(regionSize), nullptr, GL_STREAM_DRAW);
+        }
+
+        head = 0;
+        flushedHead = 0;
+        frameOpen = true;
+    }
+
+    /**
+     * @brief Garante pelo menos bytesPerFrame por região. Se precisar crescer,
+     * espera a GPU, recria o buffer e descarta o que já foi alocado no frame:
+     * chame antes das alocações do frame.
+     */
+    void Reserve(size_t bytesPerFrame) {
+        if (!bufferID || bytesPerFrame <= regionSize) return;
+
+        size_t newSize = regionSize * 2;
+        while (newSize < bytesPerFrame) newSize *= 2;
+
+        glFinish();
+        releaseStorage();
+        regionSize = alignUp(newSize, alignment);
+        allocateStorage();
+        stats.resizes++;
+
+        frame = 0;
+        head = 0;
+        flushedHead = 0;
+    }
+
+    // Reserva bytes na região do frame; data é nullptr se não couber
+    Allocation Allocate(size_t bytes) {
+        Allocation allocation;
+        size_t start = alignUp(head, alignment);
+        if (!frameOpen || start + bytes > regionSize) {
+            stats.overflows++;
+            return allocation;
+        }
+
+        head = start + bytes;
+        stats.bytes += bytes;
+        allocation.offset = regionBase() + start;
+        allocation.data = persistent ? mapped + allocation.offset : staging.data() + start;
+        return allocation;
+    }
+
+    // Aloca e copia; retorna o offset no buffer ou -1
+    long long Write(const void* data, size_t bytes) {
+        Allocation allocation = Allocate(bytes);
+        if (!allocation.data) return -1;
+        std::memcpy(allocation.data, data, bytes);
+        return static_cast<long long>(allocation.offset);
+    }
+
+    // Torna visível para a GPU o que foi escrito desde o último Flush (no-op se persistente/coerente)
+    void Flush() {
+        if (persistent || head <= flushedHead) return;
+        glBindBuffer(target, bufferID);
+        glBufferSubData(target, static_cast<GLintptr>(flushedHead),
+                        static_cast<GLsizeiptr>(head - flushedHead), staging.data() + flushedHead);
+        flushedHead = head;
+    }
+
+    GLuint GetID() const { return bufferID; }
+    GLenum GetTarget() const { return target; }
+    size_t GetAlignment() const { return alignment; }
+    size_t GetCapacity() const { return regionSize; }
+    bool IsPersistent() const { return persistent; }
+
+    const Stats& GetStats() const { return stats; }
+
+    Stats ResetStats() {
+        Stats last = stats;
+        stats = Stats();
+        return last;
+    }
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+};
+
+#endif // STREAM_BUFFER_HPP
@@ -6,12 +6,15 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #ifndef STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #endif
 
+#include "gl_state.hpp"
+
 enum class TextureType {
     DIFFUSE,
     SPECULAR,
@@ -48,6 +51,17 @@ struct TextureParams {
     bool flipVertically = true;
 };
 
+// Pixels decodificados na CPU, prontos para upload (podem ser produzidos em outra thread)
+struct ImageData {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    bool hdr = false;             // pixels em float (stbi_loadf)
+    std::shared_ptr<void> pixels; // liberado com stbi_image_free
+
+    bool IsValid() const { return pixels != nullptr; }
+};
+
 class Texture {
 private:
     unsigned int id;
@@ -63,27 +77,71 @@ public:
 
     ~Texture() {
         if (loaded) {
+            GLState::GetInstance().ForgetTexture(id);
             glDeleteTextures(1, &id);
         }
     }
 
-    bool LoadFromFile(const std::string& filepath, TextureType texType, 
-                      const TextureParams& params = TextureParams()) {
-        path = filepath;
-        type = texType;
+    // --- Decodificação (CPU, thread-safe) ---
 
-        stbi_set_flip_vertically_on_load(params.flipVertically);
+    static bool DecodeFile(const std::string& filepath, bool flipVertically, ImageData& out) {
+        stbi_set_flip_vertically_on_load_thread(flipVertically);
 
-        unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
-        
+        unsigned char* data = stbi_load(filepath.c_str(), &out.width, &out.height, &out.channels, 0);
         if (!data) {
             std::cerr << "Failed to load texture: " << filepath << std::endl;
             std::cerr << "Error: " << stbi_failure_reason() << std::endl;
             return false;
         }
 
+        out.hdr = false;
+        out.pixels = std::shared_ptr<void>(data, stbi_image_free);
+        return true;
+    }
+
+    static bool DecodeMemory(const unsigned char* data, int length, bool flipVertically, ImageData& out) {
+        stbi_set_flip_vertically_on_load_thread(flipVertically);
+
+        unsigned char* imageData = stbi_load_from_memory(data, length,
+                                                         &out.width, &out.height, &out.channels, 0);
+        if (!imageData) {
+            std::cerr << "Failed to load texture from memory." << std::endl;
+            return false;
+        }
+
+        out.hdr = false;
+        out.pixels = std::shared_ptr<void>(imageData, stbi_image_free);
+        return true;
+    }
+
+    static bool DecodeHDR(const std::string& filepath, ImageData& out) {
+        stbi_set_flip_vertically_on_load_thread(true);
+
+        // stbi_loadf carrega floats (High Dynamic Range)
+        float* data = stbi_loadf(filepath.c_str(), &out.width, &out.height, &out.channels, 0);
+        if (!data) {
+            std::cerr << "Failed to load HDR: " << filepath << std::endl;
+            return false;
+        }
+
+        out.hdr = true;
+        out.pixels = std::shared_ptr<void>(data, stbi_image_free);
+        return true;
+    }
+
+    // --- Upload (GL, thread do contexto) ---
+
+    bool Upload(const ImageData& image, TextureType texType,
+                const TextureParams& params = TextureParams()) {
+        if (!image.IsValid() || image.hdr) return false;
+
+        type = texType;
+        width = image.width;
+        height = image.height;
+        channels = image.channels;
+
         glGenTextures(1, &id);
-        glBindTexture(GL_TEXTURE_2D, id);
+        GLState::GetInstance().BindTexture(GL_TEXTURE_2D, id);
 
         // Define format
         GLenum format = GL_RGB;
@@ -107,7 +165,7 @@ public:
         }
 
         glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, 
-                     format, GL_UNSIGNED_BYTE, data);
+                     format, GL_UNSIGNED_BYTE, image.pixels.get());
 
         if (params.generateMipmap) {
             glGenerateMipmap(GL_TEXTURE_2D);
@@ -121,53 +179,55 @@ public:
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)params.minFilter);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint)params.magFilter);
 
-        stbi_image_free(data);
         loaded = true;
-
-        std::cout << "Texture loaded: " << filepath 
-                  << " (" << width << "x" << height << ", " 
-                  << channels << " channels)" << std::endl;
-
         return true;
     }
 
-    bool LoadFromMemory(unsigned char* data, int length, TextureType texType,
-                        const TextureParams& params = TextureParams()) {
-        type = texType;
-        stbi_set_flip_vertically_on_load(params.flipVertically);
+    bool UploadHDR(const ImageData& image) {
+        if (!image.IsValid() || !image.hdr) return false;
 
-        unsigned char* imageData = stbi_load_from_memory(data, length, 
-                                                          &width, &height, &channels, 0);
-        
-        if (!imageData) {
-            std::cerr << "Failed to load texture from memory." << std::endl;
-            return false;
-        }
+        type = TextureType::UNKNOWN; // HDR geralmente é usado para Environment
+        width = image.width;
+        height = image.height;
+        channels = image.channels;
 
         glGenTextures(1, &id);
-        glBindTexture(GL_TEXTURE_2D, id);
+        GLState::GetInstance().BindTexture(GL_TEXTURE_2D, id);
+        
+        // Note o GL_RGB16F: Precisamos de ponto flutuante para valores > 1.0 (brilho do sol)
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, image.pixels.get());
 
-        GLenum format = channels == 4 ? GL_RGBA : GL_RGB;
-        GLenum internalFormat = channels == 4 ? GL_SRGB_ALPHA : GL_SRGB;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-        if (type != TextureType::DIFFUSE && type != TextureType::EMISSION) {
-            internalFormat = format;
-        }
+        loaded = true;
+        return true;
+    }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0,
-                     format, GL_UNSIGNED_BYTE, imageData);
+    // --- Carregamento síncrono (decodifica + upload) ---
 
-        if (params.generateMipmap) {
-            glGenerateMipmap(GL_TEXTURE_2D);
-        }
+    bool LoadFromFile(const std::string& filepath, TextureType texType, 
+                      const TextureParams& params = TextureParams()) {
+        path = filepath;
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint)params.wrapS);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint)params.wrapT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)params.minFilter);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint)params.magFilter);
+        ImageData image;
+        if (!DecodeFile(filepath, params.flipVertically, image)) return false;
+        if (!Upload(image, texType, params)) return false;
 
-        stbi_image_free(imageData);
-        loaded = true;
+        std::cout << "Texture loaded: " << filepath 
+                  << " (" << width << "x" << height << ", " 
+                  << channels << " channels)" << std::endl;
+
+        return true;
+    }
+
+    bool LoadFromMemory(unsigned char* data, int length, TextureType texType,
+                        const TextureParams& params = TextureParams()) {
+        ImageData image;
+        if (!DecodeMemory(data, length, params.flipVertically, image)) return false;
+        if (!Upload(image, texType, params)) return false;
 
         std::cout << "Texture laden with memory: " 
                   << width << "x" << height << std::endl;
@@ -177,43 +237,21 @@ public:
 
     bool LoadHDR(const std::string& filepath) {
         path = filepath;
-        type = TextureType::UNKNOWN; // HDR geralmente é usado para Environment
 
-        stbi_set_flip_vertically_on_load(true);
-        
-        // stbi_loadf carrega floats (High Dynamic Range)
-        float* data = stbi_loadf(filepath.c_str(), &width, &height, &channels, 0);
-        
-        if (!data) {
-            std::cerr << "Failed to load HDR: " << filepath << std::endl;
-            return false;
-        }
-
-        glGenTextures(1, &id);
-        glBindTexture(GL_TEXTURE_2D, id);
-        
-        // Note o GL_RGB16F: Precisamos de ponto flutuante para valores > 1.0 (brilho do sol)
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, data);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-        loaded = true;
+        ImageData image;
+        if (!DecodeHDR(filepath, image)) return false;
+        if (!UploadHDR(image)) return false;
         
         std::cout << "HDR texture loaded: " << filepath << std::endl;
         return true;
     }
 
     void Bind(unsigned int slot = 0) const {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, id);
+        GLState::GetInstance().BindTexture(slot, GL_TEXTURE_2D, id);
     }
 
     void Unbind() const {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::GetInstance().BindTexture(GL_TEXTURE_2D, 0);
     }
 
     void setId(unsigned int v) { id = v; }
@@ -244,6 +282,7 @@ public:
     Texture& operator=(Texture&& other) noexcept {
         if (this != &other) {
             if (loaded) {
+                GLState::GetInstance().ForgetTexture(id);
                 glDeleteTextures(1, &id);
             }
             id = other.id;
@@ -261,18 +300,21 @@ public:
 };
 
 // Gerenciador de texturas com cache
+// O mapa é protegido por mutex: threads de carregamento consultam o cache
+// antes de decodificar, mas a criação de texturas GL fica na thread do contexto.
 class TextureManager {
 private:
     std::map<std::string, std::shared_ptr<Texture>> cache;
+    mutable std::mutex mutex;
     
     static TextureManager* instance;
     TextureManager() {}
 
 public:
     static TextureManager& GetInstance() {
-        if (!instance) {
-            instance = new TextureManager();
-        }
+        // call_once: pode ser chamado pela primeira vez de uma thread de carregamento
+        static std::once_flag created;
+        std::call_once(created, []() { instance = new TextureManager(); });
         return *instance;
     }
 
@@ -280,32 +322,69 @@ public:
                                          TextureType type,
                                          const TextureParams& params = TextureParams()) {
         // Verificar cache
-        auto it = cache.find(path);
-        if (it != cache.end()) {
+        if (auto cached = Find(path)) {
             std::cout << "Texture found in the cache: " << path << std::endl;
-            return it->second;
+            return cached;
         }
 
         // Carregar nova textura
         auto texture = std::make_shared<Texture>();
         if (texture->LoadFromFile(path, type, params)) {
-            cache[path] = texture;
+            Add(path, texture);
             return texture;
         }
 
         return nullptr;
     }
 
+    // Upload de uma imagem já decodificada (ex: por um worker do AssetLoader)
+    std::shared_ptr<Texture> LoadTexture(const std::string& path,
+                                         const ImageData& image,
+                                         TextureType type,
+                                         const TextureParams& params = TextureParams()) {
+        if (auto cached = Find(path)) {
+            return cached;
+        }
+
+        auto texture = std::make_shared<Texture>();
+        if (texture->Upload(image, type, params)) {
+            texture->setPath(path);
+            Add(path, texture);
+            return texture;
+        }
+
+        return nullptr;
+    }
+
+    std::shared_ptr<Texture> Find(const std::string& path) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = cache.find(path);
+        return it != cache.end() ? it->second : nullptr;
+    }
+
+    bool Contains(const std::string& path) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return cache.find(path) != cache.end();
+    }
+
+    void Add(const std::string& path, std::shared_ptr<Texture> texture) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cache[path] = texture;
+    }
+
     void ClearCache() {
+        std::lock_guard<std::mutex> lock(mutex);
         cache.clear();
         std::cout << "Cleared texture cache" << std::endl;
     }
 
     size_t GetCacheSize() const {
+        std::lock_guard<std::mutex> lock(mutex);
         return cache.size();
     }
 
     void PrintCacheInfo() const {
+        std::lock_guard<std::mutex> lock(mutex);
         std::cout << "\n=== Texture Cache ===" << std::endl;
         std::cout << "Total: " << cache.size() << " textures" << std::endl;
         for (const auto& pair : cache) {
@@ -0,0 +1,123 @@
+#ifndef UNIFORM_BUFFER_HPP
+#define UNIFORM_BUFFER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Binding points fixos dos uniform blocks compartilhados.
+ *
+ * Todo shader que declara um bloco com um destes nomes é ligado ao binding
+ * correspondente logo após o link (Shader::bindUniformBlocks), já que o
+ * GLSL 3.30 não tem layout(binding = N) para blocos.
+ */
+namespace UniformBlocks {
+    constexpr GLuint FrameBinding = 0;    // "FrameData": câmera e luzes, uma vez por frame
+    constexpr GLuint MaterialBinding = 1; // "MaterialData": propriedades do material atual
+    constexpr GLuint MaterialTableBinding = 2; // "MaterialTable": todos os materiais (MaterialTable)
+
+    constexpr const char* FrameName = "FrameData";
+    constexpr const char* MaterialName = "MaterialData";
+    constexpr const char* MaterialTableName = "MaterialTable";
+
+    constexpr int MaxTableMaterials = 128; // MAX_TABLE_MATERIALS: 128 * 128 bytes = 16 KB, o mínimo garantido
+
+    // Binding de um bloco pelo nome; -1 se o bloco não é compartilhado
+    inline int BindingFor(const char* name) {
+        if (std::strcmp(name, FrameName) == 0) return static_cast<int>(FrameBinding);
+        if (std::strcmp(name, MaterialName) == 0) return static_cast<int>(MaterialBinding);
+        if (std::strcmp(name, MaterialTableName) == 0) return static_cast<int>(MaterialTableBinding);
+        return -1;
+    }
+}
+
+// Espelhos std140 dos blocos GLSL: vec3 ocupa 16 bytes, então cada vec3 é
+// seguido de um float (útil ou padding). Os static_assert travam os offsets.
+
+struct GPUDirectionalLight {
+    glm::vec3 direction;
+    float padding0;
+    glm::vec3 color;
+    float intensity;
+};
+
+// layout(std140) uniform FrameData (pbr.vert, pbr.frag, skybox.vert)
+struct FrameUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+    glm::vec3 viewPos;
+    float padding0;
+    glm::vec4 lightPos;   // Luz legada (Phong)
+    glm::vec4 lightColor;
+    GPUDirectionalLight dirLight;
+    glm::ivec4 clusterDims;  // Froxels em x, y, fatias; w = tamanho do tile em pixels (LightClusters)
+    glm::vec4 clusterDepth;  // near, far, escala e bias da fatia logarítmica
+    int32_t numPointLights;
+    int32_t useIBL;      // bool no GLSL (4 bytes em std140)
+    int32_t padding[2];
+};
+
+static_assert(sizeof(glm::vec3) == 12, "glm::vec3 precisa ter 12 bytes para o layout std140");
+static_assert(offsetof(FrameUniforms, viewPos) == 192, "FrameUniforms fora do layout std140");
+static_assert(offsetof(FrameUniforms, dirLight) == 240, "FrameUniforms fora do layout std140");
+static_assert(offsetof(FrameUniforms, clusterDims) == 272, "FrameUniforms fora do layout std140");
+static_assert(offsetof(FrameUniforms, numPointLights) == 304, "FrameUniforms fora do layout std140");
+static_assert(sizeof(FrameUniforms) == 320, "FrameUniforms fora do layout std140");
+
+// Bits de MaterialUniforms::textureMask (hasTexture* no pbr.frag)
+namespace MaterialTextureBits {
+    constexpr int32_t Diffuse = 1 << 0;
+    constexpr int32_t Normal = 1 << 1;
+    constexpr int32_t Metallic = 1 << 2;
+    constexpr int32_t Roughness = 1 << 3;
+    constexpr int32_t AO = 1 << 4;
+    constexpr int32_t Emission = 1 << 5;
+}
+
+// layout(std140) uniform MaterialData { ... } material; (pbr.frag)
+struct MaterialUniforms {
+    glm::vec3 albedo;
+    float metallic;
+    glm::vec3 emission;
+    float emissionStrength;
+    glm::vec3 ambient;
+    float roughness;
+    glm::vec3 diffuse;
+    float ao;
+    glm::vec3 specular;
+    float shininess;
+    int32_t textureMask;
+    int32_t padding[3];
+};
+
+static_assert(offsetof(MaterialUniforms, emission) == 16, "MaterialUniforms fora do layout std140");
+static_assert(offsetof(MaterialUniforms, specular) == 64, "MaterialUniforms fora do layout std140");
+static_assert(offsetof(MaterialUniforms, textureMask) == 80, "MaterialUniforms fora do layout std140");
+static_assert(sizeof(MaterialUniforms) == 96, "MaterialUniforms fora do layout std140");
+
+// Slots de MaterialTableEntry::textureRefs (ordem dos bits de MaterialTextureBits)
+namespace MaterialTextureSlots {
+    constexpr int Diffuse = 0;
+    constexpr int Normal = 1;
+    constexpr int Metallic = 2;
+    constexpr int Roughness = 3;
+    constexpr int AO = 4;
+    constexpr int Emission = 5;
+    constexpr int Count = 8; // 6 usados + 2 de padding (dois ivec4)
+}
+
+// Elemento de layout(std140) uniform MaterialTable { MaterialEntry materials[]; } (pbr.frag com MATERIAL_TABLE).
+// textureRefs: (array << 16) | camada no sampler2DArray, ou -1 sem textura
+struct MaterialTableEntry {
+    MaterialUniforms properties;
+    int32_t textureRefs[MaterialTextureSlots::Count];
+};
+
+static_assert(offsetof(MaterialTableEntry, textureRefs) == 96, "MaterialTableEntry fora do layout std140");
+static_assert(sizeof(MaterialTableEntry) == 128, "MaterialTableEntry fora do layout std140");
+
+#endif // UNIFORM_BUFFER_HPP
@@ -0,0 +1,302 @@
+#ifndef VERTEX_FORMAT_HPP
+#define VERTEX_FORMAT_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+
+struct Vertex {
+    glm::vec3 Position;
+    glm::vec3 Normal;
+    glm::vec2 TexCoords;
+    glm::vec3 Tangent;
+    glm::vec3 Bitangent;
+};
+
+// Layout do VBO de uma Mesh. O Vertex completo continua sendo o formato na CPU.
+enum class VertexFormat {
+    Standard, // Vertex: 5 vetores float, 56 bytes
+    Packed    // PackedVertex: half-float e octaedral, 20 bytes
+};
+
+/**
+ * @brief Vértice compactado (20 bytes).
+ *
+ * - position: half4, xyz = posição, w = sinal da bitangente (+1/-1)
+ * - normal/tangent: snorm16x2 com codificação octaedral
+ * - texCoords: half2
+ *
+ * A bitangente não é armazenada: o shader reconstrói com cross(N, T) * w.
+ * Half-float tem 11 bits de precisão; para modelos em metros isso dá erro
+ * sub-milimétrico perto da origem, mas cresce com a distância do pivot.
+ */
+struct PackedVertex {
+    uint16_t position[4];
+    int16_t normal[2];
+    uint16_t texCoords[2];
+    int16_t tangent[2];
+};
+
+static_assert(sizeof(PackedVertex) == 20, "PackedVertex deve ter 20 bytes");
+
+namespace VertexPacking {
+
+// float32 -> float16 com arredondamento para o mais próximo
+inline uint16_t FloatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (((bits >> 23) & 0xFFu) == 0xFFu) {
+        // Inf/NaN
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00u); // overflow -> inf
+    }
+    if (exponent <= 0) {
+        // Subnormal (ou zero)
+        if (exponent < -10) return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u))) half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) half++; // pode subir o expoente, o que é correto
+    return static_cast<uint16_t>(half);
+}
+
+inline int16_t FloatToSnorm16(float value) {
+    value = glm::clamp(value, -1.0f, 1.0f);
+    return static_cast<int16_t>(std::lround(value * 32767.0f));
+}
+
+// Projeta a direção no octaedro e desdobra o hemisfério inferior no quadrado [-1, 1]^2
+inline glm::vec2 OctEncode(glm::vec3 n) {
+    float l1 = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+    if (l1 <= 0.0f) return glm::vec2(0.0f, 0.0f);
+    n /= l1;
+
+    glm::vec2 e(n.x, n.y);
+    if (n.z < 0.0f) {
+        float ex = (1.0f - std::fabs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+        float ey = (1.0f - std::fabs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+        e = glm::vec2(ex, ey);
+    }
+    return e;
+}
+
+inline PackedVertex Pack(const Vertex& v) {
+    PackedVertex p;
+
+    glm::vec3 n = v.Normal;
+    glm::vec3 t = v.Tangent;
+    float sign = glm::dot(glm::cross(n, t), v.Bitangent) < 0.0f ? -1.0f : 1.0f;
+
+    p.position[0] = FloatToHalf(v.Position.x);
+    p.position[1] = FloatToHalf(v.Position.y);
+    p.position[2] = FloatToHalf(v.Position.z);
+    p.position[3] = FloatToHalf(sign);
+
+    glm::vec2 octN = OctEncode(n);
+    p.normal[0] = FloatToSnorm16(octN.x);
+    p.normal[1] = FloatToSnorm16(octN.y);
+
+    p.texCoords[0] = FloatToHalf(v.TexCoords.x);
+    p.texCoords[1] = FloatToHalf(v.TexCoords.y);
+
+    glm::vec2 octT = OctEncode(t);
+    p.tangent[0] = FloatToSnorm16(octT.x);
+    p.tangent[1] = FloatToSnorm16(octT.y);
+
+    return p;
+}
+
+inline float HalfToFloat(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    uint32_t exponent = (half >> 10) & 0x1Fu;
+    uint32_t mantissa = half & 0x3FFu;
+    uint32_t bits;
+
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Subnormal: normaliza a mantissa
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400u) == 0) {
+                mantissa <<= 1;
+                exponent--;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+        }
+    } else if (exponent == 31) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline glm::vec3 OctDecode(glm::vec2 e) {
+    glm::vec3 n(e.x, e.y, 1.0f - std::fabs(e.x) - std::fabs(e.y));
+    float t = glm::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+
+// Inverso de Pack (com a perda de precisão da quantização)
+inline Vertex Unpack(const PackedVertex& p) {
+    Vertex v;
+    v.Position = glm::vec3(HalfToFloat(p.position[0]), HalfToFloat(p.position[1]), HalfToFloat(p.position[2]));
+    v.Normal = OctDecode(glm::vec2(p.normal[0], p.normal[1]) / 32767.0f);
+    v.TexCoords = glm::vec2(HalfToFloat(p.texCoords[0]), HalfToFloat(p.texCoords[1]));
+    v.Tangent = OctDecode(glm::vec2(p.tangent[0], p.tangent[1]) / 32767.0f);
+    v.Bitangent = glm::cross(v.Normal, v.Tangent) * HalfToFloat(p.position[3]);
+    return v;
+}
+
+inline std::vector<PackedVertex> Pack(const Vertex* vertices, size_t count) {
+    std::vector<PackedVertex> packed(count);
+    for (size_t i = 0; i < count; i++) {
+        packed[i] = Pack(vertices[i]);
+    }
+    return packed;
+}
+
+} // namespace VertexPacking
+
+inline size_t GetVertexStride(VertexFormat format) {
+    return format == VertexFormat::Packed ? sizeof(PackedVertex) : sizeof(Vertex);
+}
+
+// Configura os atributos 0-4 do VAO atualmente ligado para o VBO atualmente ligado
+inline void SetupVertexAttributes(VertexFormat format) {
+    if (format == VertexFormat::Packed) {
+        GLsizei stride = sizeof(PackedVertex);
+
+        // Posição + sinal da bitangente
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 4, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, position));
+
+        // Normal (octaedral)
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride, (void*)offsetof(PackedVertex, normal));
+
+        // Coordenadas de textura
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, texCoords));
+
+        // Tangente (octaedral)
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 2, GL_SHORT, GL_TRUE, stride, (void*)offsetof(PackedVertex, tangent));
+
+        // Bitangente é reconstruída no shader
+        glDisableVertexAttribArray(4);
+        return;
+    }
+
+    GLsizei stride = sizeof(Vertex);
+
+    // Posições dos vértices
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+
+    // Normais dos vértices
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride,
+                          (void*)offsetof(Vertex, Normal));
+
+    // Coordenadas de textura
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride,
+                          (void*)offsetof(Vertex, TexCoords));
+
+    // Tangente
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride,
+                          (void*)offsetof(Vertex, Tangent));
+
+    // Bitangente
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride,
+                          (void*)offsetof(Vertex, Bitangent));
+}
+
+// Matriz model por instância: mat4 ocupa as locations 5, 6, 7 e 8 (uma coluna cada)
+constexpr GLuint InstanceAttributeLocation = 5;
+
+/**
+ * @brief Aponta os atributos de instância do VAO ligado para o GL_ARRAY_BUFFER
+ * ligado, começando em offset bytes (GL 3.3 não tem base instance no draw).
+ */
+inline void SetupInstanceAttributes(size_t offset) {
+    GLsizei stride = sizeof(glm::mat4);
+    for (GLuint column = 0; column < 4; column++) {
+        GLuint location = InstanceAttributeLocation + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(offset + column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, 1);
+    }
+}
+
+// Índice na MaterialTable por instância (int), logo depois da matriz
+constexpr GLuint MaterialIndexAttributeLocation = 9;
+
+// Como SetupInstanceAttributes, para um array de int32 começando em offset
+inline void SetupInstanceMaterialAttribute(size_t offset) {
+    glEnableVertexAttribArray(MaterialIndexAttributeLocation);
+    glVertexAttribIPointer(MaterialIndexAttributeLocation, 1, GL_INT, sizeof(int32_t), (void*)offset);
+    glVertexAttribDivisor(MaterialIndexAttributeLocation, 1);
+}
+
+// Lista de luzes do draw por instância: (offset, quantidade) no drawLightIndices
+// do LightClusters. Quantidade NoDrawLights = sem lista, o fragmento usa o cluster.
+constexpr GLuint DrawLightsAttributeLocation = 10;
+constexpr uint32_t NoDrawLights = 0xFFFFFFFFu;
+
+// Como SetupInstanceMaterialAttribute, para um array de uvec2
+inline void SetupInstanceDrawLightsAttribute(size_t offset) {
+    glEnableVertexAttribArray(DrawLightsAttributeLocation);
+    glVertexAttribIPointer(DrawLightsAttributeLocation, 2, GL_UNSIGNED_INT, 2 * sizeof(uint32_t), (void*)offset);
+    glVertexAttribDivisor(DrawLightsAttributeLocation, 1);
+}
+
+/**
+ * @brief Draw sem instancing (Mesh::Draw): desliga os arrays de instância do
+ * VAO ligado e usa model como valor constante das locations 5-8 (material 0,
+ * sem lista de luzes por draw).
+ * Os arrays podem estar apontando para um trecho antigo do instanceStream; o
+ * Renderer religa tudo com SetupInstanceAttributes antes de cada batch.
+ */
+inline void SetConstantInstanceAttributes(const glm::mat4& model) {
+    for (GLuint column = 0; column < 4; column++) {
+        GLuint location = InstanceAttributeLocation + column;
+        glDisableVertexAttribArray(location);
+        glVertexAttrib4fv(location, &model[column][0]);
+    }
+    glDisableVertexAttribArray(MaterialIndexAttributeLocation);
+    glVertexAttribI4i(MaterialIndexAttributeLocation, 0, 0, 0, 0);
+    glDisableVertexAttribArray(DrawLightsAttributeLocation);
+    glVertexAttribI4ui(DrawLightsAttributeLocation, 0, NoDrawLights, 0, 0);
+}
+
+#endif // VERTEX_FORMAT_HPP
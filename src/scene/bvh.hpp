@@ -0,0 +1,367 @@
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../renderer/bounds.hpp"
+#include "../renderer/frustum.hpp"
+
+/**
+ * @brief Árvore dinâmica de AABBs (BVH incremental, no estilo do b2DynamicTree).
+ *
+ * Cada objeto é uma folha ("proxy") com a caixa alargada por uma margem, de
+ * modo que pequenos movimentos não mexem na árvore: MoveProxy só reinsere a
+ * folha quando a caixa nova sai da alargada. Inserção escolhe o irmão pelo
+ * custo de área (SAH) e a árvore é rebalanceada com rotações AVL na subida.
+ *
+ * T é o dado do usuário guardado na folha (ex.: Entity*).
+ */
+template <typename T>
+class DynamicBVH {
+public:
+    static constexpr int32_t NullNode = -1;
+
+private:
+    struct Node {
+        AABB box;
+        T data{};
+        int32_t parent = NullNode; // Na lista livre, é o próximo nó livre
+        int32_t child1 = NullNode;
+        int32_t child2 = NullNode;
+        int32_t height = -1;       // Folha = 0, nó livre = -1
+
+        bool IsLeaf() const { return child1 == NullNode; }
+    };
+
+    std::vector<Node> nodes;
+    int32_t root = NullNode;
+    int32_t freeList = NullNode;
+    int32_t proxyCount = 0;
+    float margin;
+
+    int32_t allocateNode() {
+        if (freeList == NullNode) {
+            nodes.emplace_back();
+            return static_cast<int32_t>(nodes.size() - 1);
+        }
+        int32_t id = freeList;
+        freeList = nodes[id].parent;
+        nodes[id] = Node();
+        return id;
+    }
+
+    void freeNode(int32_t id) {
+        nodes[id].parent = freeList;
+        nodes[id].height = -1;
+        freeList = id;
+    }
+
+    void refit(int32_t id) {
+        Node& node = nodes[id];
+        node.box = AABB::Merge(nodes[node.child1].box, nodes[node.child2].box);
+        node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+    }
+
+    // Sobe da folha até a raiz rebalanceando e recalculando caixas
+    void refitAncestors(int32_t id) {
+        while (id != NullNode) {
+            id = balance(id);
+            refit(id);
+            id = nodes[id].parent;
+        }
+    }
+
+    void insertLeaf(int32_t leaf) {
+        if (root == NullNode) {
+            root = leaf;
+            nodes[leaf].parent = NullNode;
+            return;
+        }
+
+        // Desce escolhendo o filho que aumenta menos a área total
+        const AABB leafBox = nodes[leaf].box;
+        int32_t index = root;
+        while (!nodes[index].IsLeaf()) {
+            const Node& node = nodes[index];
+            float area = node.box.GetSurfaceArea();
+            float combinedArea = AABB::Merge(node.box, leafBox).GetSurfaceArea();
+
+            // Custo de criar um pai novo aqui e custo herdado por descer mais
+            float cost = 2.0f * combinedArea;
+            float inheritance = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](int32_t child) {
+                const Node& c = nodes[child];
+                float merged = AABB::Merge(leafBox, c.box).GetSurfaceArea();
+                return (c.IsLeaf() ? merged : merged - c.box.GetSurfaceArea()) + inheritance;
+            };
+            float cost1 = descendCost(node.child1);
+            float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) break;
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        int32_t sibling = index;
+        int32_t oldParent = nodes[sibling].parent;
+        int32_t newParent = allocateNode(); // Pode realocar o vetor: nada de referências antes daqui
+
+        nodes[newParent].parent = oldParent;
+        nodes[newParent].box = AABB::Merge(leafBox, nodes[sibling].box);
+        nodes[newParent].height = nodes[sibling].height + 1;
+        nodes[newParent].child1 = sibling;
+        nodes[newParent].child2 = leaf;
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+
+        if (oldParent != NullNode) {
+            if (nodes[oldParent].child1 == sibling) nodes[oldParent].child1 = newParent;
+            else nodes[oldParent].child2 = newParent;
+        } else {
+            root = newParent;
+        }
+
+        refitAncestors(nodes[leaf].parent);
+    }
+
+    void removeLeaf(int32_t leaf) {
+        if (leaf == root) {
+            root = NullNode;
+            return;
+        }
+
+        int32_t parent = nodes[leaf].parent;
+        int32_t grandParent = nodes[parent].parent;
+        int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+        if (grandParent != NullNode) {
+            if (nodes[grandParent].child1 == parent) nodes[grandParent].child1 = sibling;
+            else nodes[grandParent].child2 = sibling;
+            nodes[sibling].parent = grandParent;
+            freeNode(parent);
+            refitAncestors(grandParent);
+        } else {
+            root = sibling;
+            nodes[sibling].parent = NullNode;
+            freeNode(parent);
+        }
+    }
+
+    // Rotação AVL: se um filho é 2+ níveis mais alto, ele sobe para o lugar de a
+    int32_t balance(int32_t a) {
+        if (nodes[a].IsLeaf() || nodes[a].height < 2) return a;
+
+        int32_t b = nodes[a].child1;
+        int32_t c = nodes[a].child2;
+        int32_t diff = nodes[c].height - nodes[b].height;
+
+        if (diff > 1) return rotateUp(a, c, b, false);
+        if (diff < -1) return rotateUp(a, b, c, true);
+        return a;
+    }
+
+    // Sobe "up" (filho de a) e mantém "other" em a. upIsChild1 indica de qual lado "up" estava.
+    int32_t rotateUp(int32_t a, int32_t up, int32_t other, bool upIsChild1) {
+        int32_t f = nodes[up].child1;
+        int32_t g = nodes[up].child2;
+
+        nodes[up].child1 = a;
+        nodes[up].parent = nodes[a].parent;
+        nodes[a].parent = up;
+
+        int32_t upParent = nodes[up].parent;
+        if (upParent != NullNode) {
+            if (nodes[upParent].child1 == a) nodes[upParent].child1 = up;
+            else nodes[upParent].child2 = up;
+        } else {
+            root = up;
+        }
+
+        // O neto mais alto fica com "up"; o mais baixo desce para a
+        int32_t keep = nodes[f].height > nodes[g].height ? f : g;
+        int32_t give = keep == f ? g : f;
+
+        nodes[up].child2 = keep;
+        if (upIsChild1) nodes[a].child1 = give;
+        else nodes[a].child2 = give;
+        nodes[give].parent = a;
+
+        nodes[a].box = AABB::Merge(nodes[other].box, nodes[give].box);
+        nodes[a].height = 1 + std::max(nodes[other].height, nodes[give].height);
+        nodes[up].box = AABB::Merge(nodes[a].box, nodes[keep].box);
+        nodes[up].height = 1 + std::max(nodes[a].height, nodes[keep].height);
+        return up;
+    }
+
+    AABB fatten(const AABB& box) const {
+        return AABB(box.min - glm::vec3(margin), box.max + glm::vec3(margin));
+    }
+
+    template <typename F>
+    void collectSubtree(int32_t id, F& callback) const {
+        std::vector<int32_t> stack;
+        stack.push_back(id);
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+            if (node.IsLeaf()) {
+                callback(node.data);
+            } else {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+
+public:
+    explicit DynamicBVH(float fatMargin = 0.1f) : margin(fatMargin) {}
+
+    // Cria uma folha e retorna seu id (estável até DestroyProxy)
+    int32_t CreateProxy(const AABB& box, const T& data) {
+        int32_t id = allocateNode();
+        nodes[id].box = fatten(box);
+        nodes[id].data = data;
+        nodes[id].height = 0;
+        insertLeaf(id);
+        proxyCount++;
+        return id;
+    }
+
+    void DestroyProxy(int32_t id) {
+        removeLeaf(id);
+        freeNode(id);
+        proxyCount--;
+    }
+
+    /**
+     * @brief Atualiza a caixa de uma folha.
+     * @return true se a folha foi reinserida (a caixa saiu da margem)
+     */
+    bool MoveProxy(int32_t id, const AABB& box) {
+        if (nodes[id].box.Contains(box)) return false;
+        removeLeaf(id);
+        nodes[id].box = fatten(box);
+        insertLeaf(id);
+        return true;
+    }
+
+    const T& GetData(int32_t id) const { return nodes[id].data; }
+    const AABB& GetFatBounds(int32_t id) const { return nodes[id].box; }
+    int32_t GetProxyCount() const { return proxyCount; }
+    int32_t GetHeight() const { return root == NullNode ? 0 : nodes[root].height; }
+
+    void Clear() {
+        nodes.clear();
+        root = NullNode;
+        freeList = NullNode;
+        proxyCount = 0;
+    }
+
+    /**
+     * @brief Chama callback(data) para cada folha que toca o frustum.
+     * Subárvores inteiramente dentro são aceitas sem testar as folhas.
+     */
+    template <typename F>
+    void Query(const Frustum& frustum, F callback) const {
+        if (root == NullNode) return;
+
+        std::vector<int32_t> stack;
+        stack.reserve(64);
+        stack.push_back(root);
+        while (!stack.empty()) {
+            int32_t id = stack.back();
+            stack.pop_back();
+            const Node& node = nodes[id];
+
+            Frustum::Result result = frustum.Classify(node.box);
+            if (result == Frustum::Result::Outside) continue;
+
+            if (node.IsLeaf()) {
+                callback(node.data);
+            } else if (result == Frustum::Result::Inside) {
+                collectSubtree(id, callback);
+            } else {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+
+    // Chama callback(data) para cada folha cuja caixa sobrepõe box
+    template <typename F>
+    void Query(const AABB& box, F callback) const {
+        if (root == NullNode) return;
+
+        std::vector<int32_t> stack;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+            if (!node.box.Overlaps(box)) continue;
+            if (node.IsLeaf()) {
+                callback(node.data);
+            } else {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+
+    /**
+     * @brief Percorre as folhas atingidas pelo raio, mais próximas primeiro.
+     *
+     * callback(data, maxDistance) retorna a nova distância máxima: a distância
+     * do acerto exato para buscar o mais próximo, ou maxDistance para ignorar
+     * a folha. Nós que começam além da distância máxima são descartados.
+     */
+    template <typename F>
+    void Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, F callback) const {
+        if (root == NullNode) return;
+
+        glm::vec3 invDir = glm::vec3(1.0f) / direction;
+
+        struct Entry { int32_t id; float t; };
+        std::vector<Entry> stack;
+        stack.reserve(64);
+
+        float t;
+        if (!nodes[root].box.IntersectsRay(origin, invDir, maxDistance, t)) return;
+        stack.push_back({ root, t });
+
+        while (!stack.empty()) {
+            Entry entry = stack.back();
+            stack.pop_back();
+            if (entry.t > maxDistance) continue;
+
+            const Node& node = nodes[entry.id];
+            if (node.IsLeaf()) {
+                maxDistance = callback(node.data, maxDistance);
+                continue;
+            }
+
+            float t1, t2;
+            bool hit1 = nodes[node.child1].box.IntersectsRay(origin, invDir, maxDistance, t1);
+            bool hit2 = nodes[node.child2].box.IntersectsRay(origin, invDir, maxDistance, t2);
+
+            // Empilha o mais distante primeiro para visitar o mais próximo antes
+            if (hit1 && hit2) {
+                if (t1 < t2) {
+                    stack.push_back({ node.child2, t2 });
+                    stack.push_back({ node.child1, t1 });
+                } else {
+                    stack.push_back({ node.child1, t1 });
+                    stack.push_back({ node.child2, t2 });
+                }
+            } else if (hit1) {
+                stack.push_back({ node.child1, t1 });
+            } else if (hit2) {
+                stack.push_back({ node.child2, t2 });
+            }
+        }
+    }
+};
+
+#endif // BVH_HPP
@@ -3,21 +3,37 @@
 
 #include "scene.hpp"
 #include "../renderer/model.hpp"
+#include "../renderer/asset_loader.hpp"
 
 // Componente para Renderizar Modelos 3D
 class MeshRenderer : public Component {
 private:
     std::shared_ptr<Model> model;
     std::shared_ptr<Material> materialOverride;
+    AssetHandle<Model> pending; // modelo ainda carregando em segundo plano
 
 public:
     MeshRenderer(std::shared_ptr<Model> m) : model(m), materialOverride(nullptr) {}
+    MeshRenderer(AssetHandle<Model> handle) : model(nullptr), materialOverride(nullptr), pending(handle) {}
+
+    std::shared_ptr<Model> GetModel() const { return model; }
+
+    bool GetLocalBounds(AABB& bounds) const override {
+        if (!model || !model->GetBounds().IsValid()) return false;
+        bounds = model->GetBounds();
+        return true;
+    }
 
     void SetMaterial(std::shared_ptr<Material> mat) {
         materialOverride = mat;
     }
 
     void OnRender(Renderer& renderer) override {
+        if (!model && pending.IsReady()) {
+            model = pending.Get();
+            pending = AssetHandle<Model>();
+        }
+
         if (model) {
             // Se tiver override de material, aplicamos (lógica que você pode aprimorar no Renderer)
             // Por enquanto, vamos assumir que o Renderer usa o material do Model 
@@ -44,6 +60,12 @@ public:
         mesh->SetMaterial(mat);
     }
 
+    bool GetLocalBounds(AABB& bounds) const override {
+        if (!mesh || !mesh->GetBounds().IsValid()) return false;
+        bounds = mesh->GetBounds();
+        return true;
+    }
+
     void OnRender(Renderer& renderer) override {
         renderer.SubmitMesh(*mesh, entity->transform.GetMatrix());
     }
@@ -10,6 +10,8 @@
 #include <iostream>
 
 #include "../renderer/renderer.hpp" // Para os componentes de render saberem o que é renderer
+#include "bvh.hpp"
+#include "../core/profiler.hpp"
 
 // Forward declarations
 class Entity;
@@ -32,6 +34,9 @@ public:
     virtual void OnStart() {}
     virtual void OnUpdate(float deltaTime) {}
     virtual void OnRender(Renderer& renderer) {}
+
+    // Caixa em espaço local do que o componente desenha; false se não desenha nada (ainda)
+    virtual bool GetLocalBounds(AABB& bounds) const { return false; }
 };
 
 // ==========================================
@@ -42,6 +47,11 @@ struct Transform {
     glm::vec3 Rotation = glm::vec3(0.0f); // Euler angles
     glm::vec3 Scale = glm::vec3(1.0f);
 
+    bool operator==(const Transform& other) const {
+        return Position == other.Position && Rotation == other.Rotation && Scale == other.Scale;
+    }
+    bool operator!=(const Transform& other) const { return !(*this == other); }
+
     glm::mat4 GetMatrix() const {
         glm::mat4 model = glm::mat4(1.0f);
         model = glm::translate(model, Position);
@@ -62,6 +72,13 @@ private:
     std::string name;
     bool active;
 
+    // Estado da BVH, mantido pela Scene
+    friend class Scene;
+    int32_t bvhProxy = DynamicBVH<Entity*>::NullNode;
+    Transform boundsTransform; // Transform usado no último cálculo de worldBounds
+    AABB localBounds;
+    AABB worldBounds;
+
 public:
     Transform transform; // Todo objeto tem transform por padrão
 
@@ -103,6 +120,38 @@ public:
     }
 
     std::string GetName() const { return name; }
+
+    bool IsActive() const { return active; }
+    void SetActive(bool value) { active = value; }
+
+    // União das caixas locais dos componentes; false se nenhum desenha nada
+    bool GetLocalBounds(AABB& bounds) const {
+        AABB result;
+        for (const auto& c : components) {
+            AABB box;
+            if (c->GetLocalBounds(box)) result.Expand(box);
+        }
+        if (!result.IsValid()) return false;
+        bounds = result;
+        return true;
+    }
+
+    // Caixa em mundo do último Scene::OnUpdate (inválida se a entidade não tem bounds)
+    const AABB& GetWorldBounds() const { return worldBounds; }
+};
+
+struct RaycastHit {
+    Entity* entity = nullptr;
+    float distance = 0.0f;
+    glm::vec3 point = glm::vec3(0.0f);
+};
+
+struct SceneStats {
+    uint32_t entities = 0;
+    uint32_t boundedEntities = 0; // Entidades na BVH
+    uint32_t visibleEntities = 0; // Na BVH e dentro do frustum no último OnRender
+    uint32_t culledEntities = 0;
+    uint32_t reinserted = 0;      // Folhas reinseridas no último OnUpdate
 };
 
 // ==========================================
@@ -112,6 +161,48 @@ class Scene {
 private:
     std::vector<std::shared_ptr<Entity>> entities;
 
+    // Entidades que desenham algo ficam na BVH; as demais (luzes, scripts) são sempre renderizadas
+    DynamicBVH<Entity*> bvh;
+    bool useBVH = true;
+    SceneStats stats;
+
+    void removeProxy(Entity& e) {
+        if (e.bvhProxy == DynamicBVH<Entity*>::NullNode) return;
+        bvh.DestroyProxy(e.bvhProxy);
+        e.bvhProxy = DynamicBVH<Entity*>::NullNode;
+        e.worldBounds = AABB();
+    }
+
+    // Recalcula as caixas em mundo só de quem mudou de transform ou de bounds locais
+    void updateBounds() {
+        stats.reinserted = 0;
+        for (auto& ptr : entities) {
+            Entity& e = *ptr;
+            AABB local;
+            if (!e.active || !e.GetLocalBounds(local)) {
+                removeProxy(e);
+                continue;
+            }
+
+            bool inTree = e.bvhProxy != DynamicBVH<Entity*>::NullNode;
+            if (inTree && e.transform == e.boundsTransform &&
+                local.min == e.localBounds.min && local.max == e.localBounds.max) {
+                continue;
+            }
+
+            e.localBounds = local;
+            e.boundsTransform = e.transform;
+            e.worldBounds = local.Transformed(e.transform.GetMatrix());
+
+            if (!inTree) {
+                e.bvhProxy = bvh.CreateProxy(e.worldBounds, &e);
+                stats.reinserted++;
+            } else if (bvh.MoveProxy(e.bvhProxy, e.worldBounds)) {
+                stats.reinserted++;
+            }
+        }
+    }
+
 public:
     std::shared_ptr<Entity> CreateEntity(const std::string& name = "Entity") {
         auto entity = std::make_shared<Entity>(name);
@@ -119,17 +210,76 @@ public:
         return entity;
     }
 
+    void DestroyEntity(const std::shared_ptr<Entity>& entity) {
+        auto it = std::find(entities.begin(), entities.end(), entity);
+        if (it == entities.end()) return;
+        removeProxy(**it);
+        entities.erase(it);
+    }
+
     void OnStart() {
         for(auto& e : entities) e->Start();
+        updateBounds();
     }
 
     void OnUpdate(float dt) {
+        PROFILE_SCOPE("Scene::OnUpdate");
         for(auto& e : entities) e->Update(dt);
+        updateBounds();
     }
 
     void OnRender(Renderer& renderer) {
-        for(auto& e : entities) e->Render(renderer);
+        stats.entities = static_cast<uint32_t>(entities.size());
+        stats.boundedEntities = static_cast<uint32_t>(bvh.GetProxyCount());
+        stats.visibleEntities = 0;
+
+        if (!useBVH) {
+            for(auto& e : entities) e->Render(renderer);
+            stats.visibleEntities = stats.boundedEntities;
+            stats.culledEntities = 0;
+            return;
+        }
+
+        for (auto& e : entities) {
+            if (e->bvhProxy == DynamicBVH<Entity*>::NullNode) e->Render(renderer);
+        }
+        bvh.Query(renderer.GetFrustum(), [&](Entity* e) {
+            e->Render(renderer);
+            stats.visibleEntities++;
+        });
+        stats.culledEntities = stats.boundedEntities - stats.visibleEntities;
+    }
+
+    /**
+     * @brief Raio contra as caixas em mundo das entidades (picking).
+     * @return true se acertou; hit recebe a entidade mais próxima
+     */
+    bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RaycastHit& hit) const {
+        glm::vec3 dir = glm::normalize(direction);
+        glm::vec3 invDir = glm::vec3(1.0f) / dir;
+        Entity* closest = nullptr;
+        float closestDistance = maxDistance;
+
+        bvh.Raycast(origin, dir, maxDistance, [&](Entity* e, float currentMax) {
+            float t;
+            if (!e->worldBounds.IntersectsRay(origin, invDir, currentMax, t)) return currentMax;
+            closest = e;
+            closestDistance = t;
+            return t;
+        });
+
+        if (!closest) return false;
+        hit.entity = closest;
+        hit.distance = closestDistance;
+        hit.point = origin + dir * closestDistance;
+        return true;
     }
+
+    void SetBVHCulling(bool enabled) { useBVH = enabled; }
+    bool IsBVHCullingEnabled() const { return useBVH; }
+
+    const SceneStats& GetStats() const { return stats; }
+    const DynamicBVH<Entity*>& GetBVH() const { return bvh; }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#version 330 core
+// Passe de luz do deferred: o quad de tela cheia (screen.vert) lê o G-buffer
+// e aplica as mesmas funções do pbr.frag, uma vez por pixel visível
+out vec4 FragColor;
+in vec2 TexCoord;
+
+#include "pbr_common.glsl"
+
+// G-buffer (ver gbuffer.hpp e pbr.frag com GBUFFER)
+uniform sampler2D gAlbedoMetallic;
+uniform sampler2D gNormalRoughness;
+uniform sampler2D gEmissionAO;
+uniform sampler2D gDepth;
+
+uniform mat4 inverseViewProjection;
+
+void main() {
+    float depth = texture(gDepth, TexCoord).r;
+    if (depth >= 1.0) discard; // Fundo: o skybox desenha depois
+
+    // Posição em mundo a partir da profundidade
+    vec4 clip = vec4(TexCoord * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 world = inverseViewProjection * clip;
+    vec3 P = world.xyz / world.w;
+
+    vec4 albedoMetallic = texture(gAlbedoMetallic, TexCoord);
+    vec4 normalRoughness = texture(gNormalRoughness, TexCoord);
+    vec4 emissionAO = texture(gEmissionAO, TexCoord);
+
+    vec3 albedo = albedoMetallic.rgb * albedoMetallic.rgb;
+    float metallic = albedoMetallic.a;
+    vec3 N = normalize(normalRoughness.xyz);
+    float roughness = normalRoughness.w;
+
+    vec3 V = normalize(viewPos - P);
+
+    // Mesma correção do forward: normal virada para a câmera
+    float NdotV = dot(N, V);
+    if (NdotV < 0.0) {
+        N = -N;
+        NdotV = -NdotV;
+    }
+    NdotV = max(NdotV, 0.0001);
+
+    vec3 F0 = mix(vec3(0.04), albedo, metallic);
+
+    vec3 Lo = CalcDirectLighting(P, gl_FragCoord.xy, uvec2(0u, NO_DRAW_LIGHTS), V, N, F0, albedo, metallic, roughness);
+    vec3 ambient = CalcAmbientLighting(V, N, NdotV, F0, albedo, metallic, roughness, emissionAO.a);
+
+    FragColor = vec4(ToneMapAndGamma(ambient + Lo + emissionAO.rgb), 1.0);
+}
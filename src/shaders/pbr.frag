@@ -1,46 +1,95 @@
 #version 330 core
+#ifdef GBUFFER
+// G-buffer do deferred (ver gbuffer.hpp): a luz é calculada depois, em tela cheia
+layout (location = 0) out vec4 gAlbedoMetallic;  // sqrt do albedo linear, metallic
+layout (location = 1) out vec4 gNormalRoughness; // normal em mundo, roughness
+layout (location = 2) out vec4 gEmissionAO;      // emissão (já com strength), ao
+#else
 out vec4 FragColor;
+#endif
 
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
 in mat3 TBN;
+flat in uvec2 DrawLights; // (offset, quantidade) da lista de luzes do draw
 
-// --- LIGHT STRUCTURES ---
-struct DirectionalLight {
-    vec3 direction;
-    vec3 color;
-    float intensity;
-};
-
-struct PointLight {
-    vec3 position;
-    vec3 color;
-    float intensity;
-    float radius;
-};
+// FrameData, luzes em clusters, IBL e funções PBR (também usados pelo deferred_lighting.frag)
+#include "pbr_common.glsl"
 
-#define MAX_POINT_LIGHTS 4 
+#ifdef MATERIAL_TABLE
+// Todos os materiais (binding 2, ver material_table.hpp); o índice vem por instância
+#define MAX_TABLE_MATERIALS 128
+#define MAX_TEXTURE_ARRAYS 4
 
-// --- UNIFORMS ---
-uniform DirectionalLight dirLight;
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
-uniform int numPointLights;
+flat in int MaterialIndex;
 
-uniform vec3 viewPos;
-
-// Material
-struct Material {
+struct MaterialEntry {
     vec3 albedo;
     float metallic;
+    vec3 emission;
+    float emissionStrength;
+    vec3 ambient;
     float roughness;
+    vec3 diffuse;
     float ao;
+    vec3 specular;
+    float shininess;
+    int textureMask;
+    ivec4 textureRefs[2]; // (array << 16) | camada, por slot: diffuse, normal, metallic, roughness, ao, emission
+};
+
+layout(std140) uniform MaterialTable {
+    MaterialEntry materials[MAX_TABLE_MATERIALS];
+};
+
+#define material materials[MaterialIndex]
+#else
+// Material (binding 1): reenviado só quando o material muda
+layout(std140) uniform MaterialData {
+    vec3 albedo;
+    float metallic;
     vec3 emission;
     float emissionStrength;
-};
-uniform Material material;
+    vec3 ambient;   // Phong (legado)
+    float roughness;
+    vec3 diffuse;   // Phong (legado)
+    float ao;
+    vec3 specular;  // Phong (legado)
+    float shininess;
+    int textureMask;
+} material;
+#endif
+
+#define hasTextureDiffuse   ((material.textureMask & 1) != 0)
+#define hasTextureNormal    ((material.textureMask & 2) != 0)
+#define hasTextureMetallic  ((material.textureMask & 4) != 0)
+#define hasTextureRoughness ((material.textureMask & 8) != 0)
+#define hasTextureAO        ((material.textureMask & 16) != 0)
+#define hasTextureEmission  ((material.textureMask & 32) != 0)
 
 // Textures
+#ifdef MATERIAL_TABLE
+uniform sampler2DArray materialTextures[MAX_TEXTURE_ARRAYS];
+
+// GLSL 3.30 só indexa arrays de samplers com constantes; o array é uniforme por draw
+vec4 sampleMaterial(int slot, vec2 uv) {
+    int ref = material.textureRefs[slot / 4][slot % 4];
+    vec3 coord = vec3(uv, float(ref & 0xFFFF));
+    int arrayIndex = ref >> 16;
+    if (arrayIndex == 0) return texture(materialTextures[0], coord);
+    if (arrayIndex == 1) return texture(materialTextures[1], coord);
+    if (arrayIndex == 2) return texture(materialTextures[2], coord);
+    return texture(materialTextures[3], coord);
+}
+
+#define sampleDiffuse(uv)   sampleMaterial(0, uv)
+#define sampleNormal(uv)    sampleMaterial(1, uv)
+#define sampleMetallic(uv)  sampleMaterial(2, uv)
+#define sampleRoughness(uv) sampleMaterial(3, uv)
+#define sampleAO(uv)        sampleMaterial(4, uv)
+#define sampleEmission(uv)  sampleMaterial(5, uv)
+#else
 uniform sampler2D texture_diffuse1;
 uniform sampler2D texture_normal1;
 uniform sampler2D texture_metallic1;
@@ -48,80 +97,13 @@ uniform sampler2D texture_roughness1;
 uniform sampler2D texture_ao1;
 uniform sampler2D texture_emission1;
 
-uniform bool hasTextureDiffuse;
-uniform bool hasTextureNormal;
-uniform bool hasTextureMetallic;
-uniform bool hasTextureRoughness;
-uniform bool hasTextureAO;
-uniform bool hasTextureEmission;
-
-// IBL Maps
-uniform samplerCube irradianceMap;
-uniform samplerCube prefilterMap;
-uniform sampler2D   brdfLUT;
-uniform bool        useIBL;
-
-const float PI = 3.14159265359;
-
-// --- SAFE PBR FUNCTIONS ---
-
-vec3 fresnelSchlick(float cosTheta, vec3 F0) {
-    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
-}
-
-vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness) {
-    return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
-}
-
-float DistributionGGX(vec3 N, vec3 H, float roughness) {
-    float a = max(roughness * roughness, 0.001);
-    float a2 = a * a;
-    float NdotH = max(dot(N, H), 0.0);
-    float NdotH2 = NdotH * NdotH;
-    float num = a2;
-    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
-    denom = PI * denom * denom;
-    return num / max(denom, 0.0001);
-}
-
-float GeometrySchlickGGX(float NdotV, float roughness) {
-    float r = (roughness + 1.0);
-    float k = (r*r) / 8.0;
-    float num = NdotV;
-    float denom = NdotV * (1.0 - k) + k;
-    return num / max(denom, 0.0001);
-}
-
-float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
-    float NdotV = max(dot(N, V), 0.0001);
-    float NdotL = max(dot(N, L), 0.0001);
-    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
-    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
-    return ggx1 * ggx2;
-}
-
-// --- LIGHT CALCULATION ---
-vec3 CalcPBRLight(vec3 L, vec3 V, vec3 N, vec3 F0, vec3 albedo, float metallic, float roughness, vec3 radiance) {
-    vec3 H = normalize(V + L);
-    
-    float NDF = DistributionGGX(N, H, roughness);   
-    float G   = GeometrySmith(N, V, L, roughness);      
-    vec3 F    = fresnelSchlick(max(dot(H, V), 0.0), F0);
-       
-    vec3 numerator    = NDF * G * F; 
-    
-    float NdotV = max(dot(N, V), 0.0001);
-    float NdotL = max(dot(N, L), 0.0001);
-    float denominator = 4.0 * NdotV * NdotL + 0.0001;
-    
-    vec3 specular = numerator / denominator;
-    
-    vec3 kS = F;
-    vec3 kD = vec3(1.0) - kS;
-    kD *= 1.0 - metallic;     
-
-    return (kD * albedo / PI + specular) * radiance * NdotL;
-}
+#define sampleDiffuse(uv)   texture(texture_diffuse1, uv)
+#define sampleNormal(uv)    texture(texture_normal1, uv)
+#define sampleMetallic(uv)  texture(texture_metallic1, uv)
+#define sampleRoughness(uv) texture(texture_roughness1, uv)
+#define sampleAO(uv)        texture(texture_ao1, uv)
+#define sampleEmission(uv)  texture(texture_emission1, uv)
+#endif
 
 void main() {
     // 1. Material Properties
@@ -130,29 +112,45 @@ void main() {
     vec3 albedo = material.albedo;
 
     if (hasTextureDiffuse) {
-        vec4 albedoTex = texture(texture_diffuse1, uv / 0.5);
+        vec4 albedoTex = sampleDiffuse(uv / 0.5);
         albedo = pow(albedoTex.rgb, vec3(2.2)); // Convert to linear space
     }
 
     float metallic = material.metallic;
-    if (hasTextureMetallic) metallic = texture(texture_metallic1, uv).r;
+    if (hasTextureMetallic) metallic = sampleMetallic(uv).r;
     
     float roughness = material.roughness;
-    if (hasTextureRoughness) roughness = texture(texture_roughness1, uv).r;
+    if (hasTextureRoughness) roughness = sampleRoughness(uv).r;
     
     // Clamp roughness to prevent artifacts
     roughness = clamp(roughness, 0.04, 1.0);
 
     float ao = material.ao;
-    if (hasTextureAO) ao = texture(texture_ao1, uv).r;
+    if (hasTextureAO) ao = sampleAO(uv).r;
 
     // 2. Normal / Geometry Data
     vec3 N = normalize(Normal);
     if (hasTextureNormal) {
-        vec3 normalMap = texture(texture_normal1, uv).rgb;
+        vec3 normalMap = sampleNormal(uv).rgb;
         normalMap = normalMap * 2.0 - 1.0;
         N = normalize(TBN * normalMap);
     }
+    // --- EMISSION ---
+    vec3 emission = vec3(0.0);
+    if (hasTextureEmission) {
+        emission = sampleEmission(uv).rgb;
+        emission = pow(emission, vec3(2.2)); // Convert to linear space
+    } else {
+        emission = material.emission;
+    }
+    emission *= material.emissionStrength;
+
+#ifdef GBUFFER
+    // sqrt: gama 2 barato para o albedo não perder os tons escuros nos 8 bits
+    gAlbedoMetallic = vec4(sqrt(albedo), metallic);
+    gNormalRoughness = vec4(N, roughness);
+    gEmissionAO = vec4(emission, ao);
+#else
     vec3 V = normalize(viewPos - FragPos);
     
     // FIX: Ensure V and N are properly oriented
@@ -168,79 +166,12 @@ void main() {
     F0 = mix(F0, albedo, metallic);
 
     // --- DIRECT LIGHTING ---
-    vec3 Lo = vec3(0.0);
-
-    // Directional Light
-    {
-        vec3 L = normalize(-dirLight.direction);
-        vec3 radiance = dirLight.color * dirLight.intensity;
-        Lo += CalcPBRLight(L, V, N, F0, albedo, metallic, roughness, radiance);
-    }
-
-    // Point Lights
-    for(int i = 0; i < numPointLights; ++i) {
-        vec3 L = normalize(pointLights[i].position - FragPos);
-        float distance = length(pointLights[i].position - FragPos);
-        float attenuation = 1.0 / (distance * distance);
-        vec3 radiance = pointLights[i].color * pointLights[i].intensity * attenuation;
-
-        Lo += CalcPBRLight(L, V, N, F0, albedo, metallic, roughness, radiance);
-    }
+    vec3 Lo = CalcDirectLighting(FragPos, gl_FragCoord.xy, DrawLights, V, N, F0, albedo, metallic, roughness);
 
     // --- INDIRECT LIGHTING (IBL) ---
-    vec3 ambient = vec3(0.0);
-    
-    if (useIBL) {
-        // FIX: Use proper NdotV for Fresnel calculation
-        vec3 F = fresnelSchlickRoughness(NdotV, F0, roughness);
-        
-        vec3 kS = F;
-        vec3 kD = 1.0 - kS;
-        kD *= 1.0 - metallic;
-        
-        // Diffuse IBL
-        vec3 irradiance = texture(irradianceMap, N).rgb;
-        vec3 diffuse = kD * irradiance * albedo;
-        
-        // Specular IBL
-        // FIX: Calculate reflection vector properly
-        vec3 R = reflect(-V, N);
-        
-        // FIX: Use proper mip level calculation
-        const float MAX_REFLECTION_LOD = 4.0;
-        float lod = roughness * MAX_REFLECTION_LOD;
-        vec3 prefilteredColor = textureLod(prefilterMap, R, lod).rgb;
-        
-        // FIX: Sample BRDF LUT with correct coordinates (NdotV, roughness)
-        vec2 envBRDF = texture(brdfLUT, vec2(NdotV, roughness)).rg;
-        
-        // FIX: Correct specular IBL calculation
-        vec3 specular = prefilteredColor * (F0 * envBRDF.x + envBRDF.y);
-
-        ambient = (diffuse + specular) * ao;
-    } else {
-        // Fallback ambient
-        ambient = vec3(0.03) * albedo * ao;
-    }
-
-    // --- EMISSION ---
-    vec3 emission = vec3(0.0);
-    if (hasTextureEmission) {
-        emission = texture(texture_emission1, uv).rgb;
-        emission = pow(emission, vec3(2.2)); // Convert to linear space
-    } else {
-        emission = material.emission;
-    }
-    emission *= material.emissionStrength;
+    vec3 ambient = CalcAmbientLighting(V, N, NdotV, F0, albedo, metallic, roughness, ao);
 
     // --- COMPOSITION ---
-    vec3 color = ambient + Lo + emission;
-
-    // Tone Mapping (Reinhard)
-    color = color / (color + vec3(1.0));
-    
-    // Gamma Correction
-    color = pow(color, vec3(1.0/2.2));
-
-    FragColor = vec4(color, 1.0);
+    FragColor = vec4(ToneMapAndGamma(ambient + Lo + emission), 1.0);
+#endif
 }
\ No newline at end of file
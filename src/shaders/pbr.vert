@@ -1,30 +1,80 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+layout (location = 0) in vec4 aPos;       // Packed: w = sinal da bitangente
+layout (location = 1) in vec3 aNormal;    // Packed: xy octaedral
 layout (location = 2) in vec2 aTexCoords;
-layout (location = 3) in vec3 aTangent;
-layout (location = 4) in vec3 aBitangent;
+layout (location = 3) in vec3 aTangent;   // Packed: xy octaedral
+layout (location = 4) in vec3 aBitangent; // Packed: não usado
+layout (location = 5) in mat4 aModel;     // Por instância (locations 5-8, instanceVBO do Renderer)
+layout (location = 10) in uvec2 aDrawLights; // Por instância: lista de luzes do draw (LightBinner)
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 out mat3 TBN;
+flat out uvec2 DrawLights;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+#ifdef MATERIAL_TABLE
+layout (location = 9) in int aMaterialIndex; // Por instância: índice na MaterialTable
+flat out int MaterialIndex;
+#endif
+
+// Bloco compartilhado (binding 0, ver uniform_buffer.hpp): enviado uma vez por frame
+struct DirectionalLight {
+    vec3 direction;
+    vec3 color;
+    float intensity;
+};
+
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+    DirectionalLight dirLight;
+    ivec4 clusterDims;  // froxels x, y, fatias; w = tile em pixels
+    vec4 clusterDepth;  // near, far, escala e bias da fatia
+    int numPointLights;
+    bool useIBL;
+};
+
+uniform bool packedVertex;
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
 
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    mat4 model = aModel;
+    vec3 normal = aNormal;
+    vec3 tangent = aTangent;
+    vec3 bitangent = aBitangent;
+
+    if (packedVertex) {
+        normal = octDecode(aNormal.xy);
+        tangent = octDecode(aTangent.xy);
+        bitangent = cross(normal, tangent) * aPos.w;
+    }
+
+    FragPos = vec3(model * vec4(aPos.xyz, 1.0));
     TexCoords = aTexCoords;
+    DrawLights = aDrawLights;
+#ifdef MATERIAL_TABLE
+    MaterialIndex = aMaterialIndex;
+#endif
     
     mat3 normalMatrix = transpose(inverse(mat3(model)));
-    Normal = normalMatrix * aNormal;
+    Normal = normalMatrix * normal;
     
-    vec3 T = normalize(normalMatrix * aTangent);
-    vec3 B = normalize(normalMatrix * aBitangent);
-    vec3 N = normalize(normalMatrix * aNormal);
+    vec3 T = normalize(normalMatrix * tangent);
+    vec3 B = normalize(normalMatrix * bitangent);
+    vec3 N = normalize(normalMatrix * normal);
     TBN = mat3(T, B, N);
     
-    gl_Position = projection * view * vec4(FragPos, 1.0);
-}
\ No newline at end of file
+    gl_Position = viewProjection * vec4(FragPos, 1.0);
+}
@@ -0,0 +1,198 @@
+// Iluminação PBR compartilhada pelo pbr.frag (forward) e pelo deferred_lighting.frag.
+// Incluído com #include "pbr_common.glsl" (resolvido pelo Shader, não pelo GLSL)
+
+// --- UNIFORM BLOCKS ---
+// Bloco compartilhado (binding 0, ver uniform_buffer.hpp): enviado uma vez por frame
+struct DirectionalLight {
+    vec3 direction;
+    vec3 color;
+    float intensity;
+};
+
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+    DirectionalLight dirLight;
+    ivec4 clusterDims;  // froxels x, y, fatias; w = tile em pixels
+    vec4 clusterDepth;  // near, far, escala e bias da fatia
+    int numPointLights;
+    bool useIBL;
+};
+
+// Luzes pontuais em clusters (LightClusters): 2 texels por luz, (offset, quantidade) por cluster, índices
+uniform samplerBuffer  clusterLights;
+uniform usamplerBuffer clusterRanges;
+uniform usamplerBuffer clusterIndices;
+
+// Listas por draw do LightBinner (mesma numeração de clusterLights); cada draw
+// passa (offset, quantidade), ou quantidade NO_DRAW_LIGHTS quando não há lista
+uniform usamplerBuffer drawLightIndices;
+const uint NO_DRAW_LIGHTS = 0xFFFFFFFFu;
+
+// IBL Maps
+uniform samplerCube irradianceMap;
+uniform samplerCube prefilterMap;
+uniform sampler2D   brdfLUT;
+
+const float PI = 3.14159265359;
+
+// --- SAFE PBR FUNCTIONS ---
+
+vec3 fresnelSchlick(float cosTheta, vec3 F0) {
+    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness) {
+    return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+float DistributionGGX(vec3 N, vec3 H, float roughness) {
+    float a = max(roughness * roughness, 0.001);
+    float a2 = a * a;
+    float NdotH = max(dot(N, H), 0.0);
+    float NdotH2 = NdotH * NdotH;
+    float num = a2;
+    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
+    denom = PI * denom * denom;
+    return num / max(denom, 0.0001);
+}
+
+float GeometrySchlickGGX(float NdotV, float roughness) {
+    float r = (roughness + 1.0);
+    float k = (r*r) / 8.0;
+    float num = NdotV;
+    float denom = NdotV * (1.0 - k) + k;
+    return num / max(denom, 0.0001);
+}
+
+float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
+    float NdotV = max(dot(N, V), 0.0001);
+    float NdotL = max(dot(N, L), 0.0001);
+    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
+    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
+    return ggx1 * ggx2;
+}
+
+// --- LIGHT CALCULATION ---
+vec3 CalcPBRLight(vec3 L, vec3 V, vec3 N, vec3 F0, vec3 albedo, float metallic, float roughness, vec3 radiance) {
+    vec3 H = normalize(V + L);
+
+    float NDF = DistributionGGX(N, H, roughness);
+    float G   = GeometrySmith(N, V, L, roughness);
+    vec3 F    = fresnelSchlick(max(dot(H, V), 0.0), F0);
+
+    vec3 numerator    = NDF * G * F;
+
+    float NdotV = max(dot(N, V), 0.0001);
+    float NdotL = max(dot(N, L), 0.0001);
+    float denominator = 4.0 * NdotV * NdotL + 0.0001;
+
+    vec3 specular = numerator / denominator;
+
+    vec3 kS = F;
+    vec3 kD = vec3(1.0) - kS;
+    kD *= 1.0 - metallic;
+
+    return (kD * albedo / PI + specular) * radiance * NdotL;
+}
+
+// Contribuição da luz pontual de índice light em clusterLights
+vec3 CalcPointLight(int light, vec3 P, vec3 V, vec3 N, vec3 F0, vec3 albedo, float metallic, float roughness) {
+    vec4 positionRadius = texelFetch(clusterLights, light * 2);
+    vec4 colorIntensity = texelFetch(clusterLights, light * 2 + 1);
+
+    vec3 toLight = positionRadius.xyz - P;
+    float distance = length(toLight);
+    vec3 L = toLight / max(distance, 0.0001);
+    // 1/d² com janela suave até zero no raio (a luz não existe fora dos clusters que toca)
+    float window = clamp(1.0 - pow(distance / positionRadius.w, 4.0), 0.0, 1.0);
+    float attenuation = window * window / max(distance * distance, 0.0001);
+    vec3 radiance = colorIntensity.rgb * colorIntensity.a * attenuation;
+
+    return CalcPBRLight(L, V, N, F0, albedo, metallic, roughness, radiance);
+}
+
+// Luz direcional + luzes pontuais do fragmento (P em mundo, fragCoord = gl_FragCoord.xy).
+// As pontuais vêm da menor lista entre a do cluster e a do draw (drawLights).
+vec3 CalcDirectLighting(vec3 P, vec2 fragCoord, uvec2 drawLights, vec3 V, vec3 N, vec3 F0, vec3 albedo, float metallic, float roughness) {
+    vec3 Lo = vec3(0.0);
+
+    // Directional Light
+    {
+        vec3 L = normalize(-dirLight.direction);
+        vec3 radiance = dirLight.color * dirLight.intensity;
+        Lo += CalcPBRLight(L, V, N, F0, albedo, metallic, roughness, radiance);
+    }
+
+    // Point Lights: só as do cluster deste fragmento, ou as do draw se forem menos
+    if (numPointLights > 0) {
+        float viewDepth = -(view * vec4(P, 1.0)).z;
+        int slice = clamp(int(floor(log(max(viewDepth, clusterDepth.x)) * clusterDepth.z + clusterDepth.w)), 0, clusterDims.z - 1);
+        ivec2 tile = min(ivec2(fragCoord) / clusterDims.w, clusterDims.xy - 1);
+        int cluster = (slice * clusterDims.y + tile.y) * clusterDims.x + tile.x;
+        uvec2 range = texelFetch(clusterRanges, cluster).xy;
+
+        if (drawLights.y < range.y) {
+            for (uint n = 0u; n < drawLights.y; ++n) {
+                int light = int(texelFetch(drawLightIndices, int(drawLights.x + n)).r);
+                Lo += CalcPointLight(light, P, V, N, F0, albedo, metallic, roughness);
+            }
+        } else {
+            for (uint n = 0u; n < range.y; ++n) {
+                int light = int(texelFetch(clusterIndices, int(range.x + n)).r);
+                Lo += CalcPointLight(light, P, V, N, F0, albedo, metallic, roughness);
+            }
+        }
+    }
+
+    return Lo;
+}
+
+// --- INDIRECT LIGHTING (IBL) ---
+vec3 CalcAmbientLighting(vec3 V, vec3 N, float NdotV, vec3 F0, vec3 albedo, float metallic, float roughness, float ao) {
+    if (!useIBL) {
+        // Fallback ambient
+        return vec3(0.03) * albedo * ao;
+    }
+
+    // FIX: Use proper NdotV for Fresnel calculation
+    vec3 F = fresnelSchlickRoughness(NdotV, F0, roughness);
+
+    vec3 kS = F;
+    vec3 kD = 1.0 - kS;
+    kD *= 1.0 - metallic;
+
+    // Diffuse IBL
+    vec3 irradiance = texture(irradianceMap, N).rgb;
+    vec3 diffuse = kD * irradiance * albedo;
+
+    // Specular IBL
+    // FIX: Calculate reflection vector properly
+    vec3 R = reflect(-V, N);
+
+    // FIX: Use proper mip level calculation
+    const float MAX_REFLECTION_LOD = 4.0;
+    float lod = roughness * MAX_REFLECTION_LOD;
+    vec3 prefilteredColor = textureLod(prefilterMap, R, lod).rgb;
+
+    // FIX: Sample BRDF LUT with correct coordinates (NdotV, roughness)
+    vec2 envBRDF = texture(brdfLUT, vec2(NdotV, roughness)).rg;
+
+    // FIX: Correct specular IBL calculation
+    vec3 specular = prefilteredColor * (F0 * envBRDF.x + envBRDF.y);
+
+    return (diffuse + specular) * ao;
+}
+
+// --- COMPOSITION ---
+vec3 ToneMapAndGamma(vec3 color) {
+    // Tone Mapping (Reinhard)
+    color = color / (color + vec3(1.0));
+
+    // Gamma Correction
+    return pow(color, vec3(1.0/2.2));
+}
@@ -3,8 +3,26 @@ layout (location = 0) in vec3 aPos;
 
 out vec3 TexCoords;
 
-uniform mat4 projection;
-uniform mat4 view;
+// Bloco compartilhado (binding 0, ver uniform_buffer.hpp): enviado uma vez por frame
+struct DirectionalLight {
+    vec3 direction;
+    vec3 color;
+    float intensity;
+};
+
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+    DirectionalLight dirLight;
+    ivec4 clusterDims;  // froxels x, y, fatias; w = tile em pixels
+    vec4 clusterDepth;  // near, far, escala e bias da fatia
+    int numPointLights;
+    bool useIBL;
+};
 
 void main() {
     TexCoords = aPos;